@@ -0,0 +1,194 @@
+#!/usr/bin/env perl
+#
+# Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+#
+# Drive the mapper against simulated allocations without launching
+# anything, and collect the per-phase timings reported by the rmaps
+# framework (rmaps_base_report_timing) for a range of mapping, ranking
+# and binding policies.
+
+
+use strict;
+use Getopt::Long;
+
+# globals
+my $starter = "prterun";
+my $nodelist = "16,256,1024";
+my $slots = 64;
+my $topofiles;
+my $device;
+my $reps = 3;
+my $myresults = "map_bench.csv";
+my $json = 0;
+my $np;
+my @maps = qw(slot node package core ppr:2:package);
+my @ranks = qw(slot node package:span package:fill);
+my @binds = qw(none core package);
+my $mapopt;
+my $rankopt;
+my $bindopt;
+
+# Set to true if the script should merely print the cmds
+# it would run, but don't run them
+my $SHOWME = 0;
+# Set to true to suppress most informational messages.
+my $QUIET = 0;
+# Set to true if we just want to see the help message
+my $HELP = 0;
+
+GetOptions(
+    "help" => \$HELP,
+    "quiet" => \$QUIET,
+    "showme" => \$SHOWME,
+    "starter=s" => \$starter,
+    "nodes=s" => \$nodelist,
+    "slots=s" => \$slots,
+    "np=s" => \$np,
+    "topo-files=s" => \$topofiles,
+    "device=s" => \$device,
+    "reps=s" => \$reps,
+    "map-by=s" => \$mapopt,
+    "rank-by=s" => \$rankopt,
+    "bind-to=s" => \$bindopt,
+    "results=s" => \$myresults,
+    "json" => \$json,
+) or die "unable to parse options, stopped";
+
+if ($HELP) {
+    print "$0 [options]
+
+--help | -h          This help message
+--quiet | -q         Only output critical messages to stdout
+--showme             Show the actual commands without executing them
+--starter=s          Launcher to use (default: prterun)
+--nodes=a,b,c        Comma-delimited list of simulated node counts to test
+--slots=n            Number of slots on each simulated node
+--np=n               Number of procs to map (default: nodes * slots)
+--topo-files=s       Comma-delimited list of topology XML files for the simulated nodes
+--device=s           Also test dist mapping to the given device (e.g., mlx5_0)
+--reps=n             Number of times to run each combination (for statistics)
+--map-by=a,b         Comma-delimited list of mapping policies to test
+--rank-by=a,b        Comma-delimited list of ranking policies to test
+--bind-to=a,b        Comma-delimited list of binding policies to test
+--results=file       File where results are to be stored
+--json               Store the results as JSON instead of comma-separated values
+";
+    exit(0);
+}
+
+if ($mapopt) {
+    @maps = split(",", $mapopt);
+}
+if ($device) {
+    push @maps, "dist:span:device=" . $device;
+}
+if ($rankopt) {
+    @ranks = split(",", $rankopt);
+}
+if ($bindopt) {
+    @binds = split(",", $bindopt);
+}
+
+# the phases reported by the mapper, in the order they are run
+my @phases = qw(setup map vpids local_ranks bind total maxrss_kb);
+my @records;
+
+my $mca = "--prtemca ras simulator --prtemca ras_simulator_slots " . $slots .
+          " --prtemca rmaps_base_report_timing 1";
+if ($topofiles) {
+    $mca = $mca . " --prtemca ras_simulator_topo_files " . $topofiles;
+}
+
+sub runcmd
+{
+    my ($nodes, $procs, $map, $rank, $bind) = @_;
+    my $cmd = $starter . " " . $mca . " --prtemca ras_simulator_num_nodes " . $nodes .
+              " --do-not-launch --map-by " . $map . " --rank-by " . $rank .
+              " --bind-to " . $bind . " -n " . $procs . " /bin/true 2>&1";
+    my %sum;
+    my $count = 0;
+    my $rec;
+    my $phase;
+
+    if ($SHOWME) {
+        print $cmd . "\n";
+        return;
+    }
+    if (!$QUIET) {
+        print "Running: nodes=$nodes np=$procs map-by=$map rank-by=$rank bind-to=$bind\n";
+    }
+    foreach $phase (@phases) {
+        $sum{$phase} = 0;
+    }
+    for (1..$reps) {
+        my $output = `$cmd`;
+        foreach my $line (split(/\n/, $output)) {
+            if ($line !~ /\[rmaps:timing\]/) {
+                next;
+            }
+            foreach my $pair (split(/\s+/, $line)) {
+                if ($pair =~ /^(\w+)=(\S+)$/ && exists $sum{$1}) {
+                    $sum{$1} += $2;
+                }
+            }
+            $count++;
+        }
+    }
+    $rec = {nodes => $nodes, np => $procs, map => $map,
+            rank => $rank, bind => $bind, runs => $count};
+    foreach $phase (@phases) {
+        $rec->{$phase} = (0 < $count) ? $sum{$phase} / $count : "";
+    }
+    if (0 == $count) {
+        print "No timing reported for map-by=$map rank-by=$rank bind-to=$bind (mapping failed?)\n";
+    }
+    push @records, $rec;
+}
+
+foreach my $nodes (split(",", $nodelist)) {
+    my $procs = $np ? $np : $nodes * $slots;
+    foreach my $map (@maps) {
+        foreach my $rank (@ranks) {
+            foreach my $bind (@binds) {
+                runcmd($nodes, $procs, $map, $rank, $bind);
+            }
+        }
+    }
+}
+
+if ($SHOWME) {
+    exit(0);
+}
+
+open(my $fh, ">", $myresults) or die "could not open $myresults: $!";
+if ($json) {
+    my @entries;
+    foreach my $rec (@records) {
+        my @fields;
+        foreach my $key (qw(nodes np map rank bind runs), @phases) {
+            my $val = $rec->{$key};
+            if ($val eq "") {
+                $val = "null";
+            } elsif ($val !~ /^[0-9.eE+-]+$/) {
+                $val = "\"" . $val . "\"";
+            }
+            push @fields, "\"" . $key . "\": " . $val;
+        }
+        push @entries, "  {" . join(", ", @fields) . "}";
+    }
+    print $fh "[\n" . join(",\n", @entries) . "\n]\n";
+} else {
+    print $fh join(",", qw(nodes np map rank bind runs), @phases) . "\n";
+    foreach my $rec (@records) {
+        my @row;
+        foreach my $key (qw(nodes np map rank bind runs), @phases) {
+            push @row, $rec->{$key};
+        }
+        print $fh join(",", @row) . "\n";
+    }
+}
+close($fh);
+
+if (!$QUIET) {
+    print "Results stored in " . $myresults . "\n";
+}
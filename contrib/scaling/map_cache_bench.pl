@@ -0,0 +1,196 @@
+#!/usr/bin/env perl
+#
+# Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+#
+# Measure the job throughput of a persistent DVM with and without the
+# rmaps map cache (rmaps_base_map_cache_size). A DVM is started for
+# each cache size, the same job is submitted to it repeatedly with
+# prun, and the jobs/sec seen by the submitter is reported together
+# with the average mapping time taken from the per-job timing line
+# printed by the DVM (rmaps_base_report_timing).
+
+
+use strict;
+use Getopt::Long;
+use Time::HiRes qw(gettimeofday tv_interval);
+
+# globals
+my $np = 1;
+my $jobs = 100;
+my $sizes = "0,16";
+my $app = "/bin/true";
+my $hostfile;
+my $mapopt;
+my $bindopt;
+my @mcaopts;
+my $myresults = "map_cache_bench.csv";
+my $timeout = 30;
+
+# Set to true if the script should merely print the cmds
+# it would run, but don't run them
+my $SHOWME = 0;
+# Set to true to suppress most informational messages.
+my $QUIET = 0;
+# Set to true if we just want to see the help message
+my $HELP = 0;
+
+GetOptions(
+    "help" => \$HELP,
+    "quiet" => \$QUIET,
+    "showme" => \$SHOWME,
+    "np=s" => \$np,
+    "jobs=s" => \$jobs,
+    "cache-sizes=s" => \$sizes,
+    "app=s" => \$app,
+    "hostfile=s" => \$hostfile,
+    "map-by=s" => \$mapopt,
+    "bind-to=s" => \$bindopt,
+    "prtemca=s{2}" => \@mcaopts,
+    "timeout=s" => \$timeout,
+    "results=s" => \$myresults,
+) or die "unable to parse options, stopped";
+
+if ($HELP) {
+    print "$0 [options]
+
+--help | -h          This help message
+--quiet | -q         Only output critical messages to stdout
+--showme             Show the actual commands without executing them
+--np=n               Number of procs in each job (default: 1)
+--jobs=n             Number of jobs to submit to each DVM (default: 100)
+--cache-sizes=a,b    Comma-delimited list of rmaps_base_map_cache_size values
+                     to test - 0 disables the cache (default: 0,16)
+--app=s              Executable to run (default: /bin/true)
+--hostfile=s         Hostfile the DVM is to use
+--map-by=s           Mapping policy for the jobs
+--bind-to=s          Binding policy for the jobs
+--prtemca key val    Additional MCA param to give the DVM (may be repeated)
+--timeout=n          Seconds to wait for the DVM to report it is ready
+--results=file       File where results are to be stored
+";
+    exit(0);
+}
+
+my $jobopts = "-n " . $np;
+if ($mapopt) {
+    $jobopts = $jobopts . " --map-by " . $mapopt;
+}
+if ($bindopt) {
+    $jobopts = $jobopts . " --bind-to " . $bindopt;
+}
+my $prun = "prun --system-server-only " . $jobopts . " " . $app;
+
+my $dvmopts = "--system-server --prtemca rmaps_base_report_timing 1";
+if ($hostfile) {
+    $dvmopts = $dvmopts . " --hostfile " . $hostfile;
+}
+for (my $i=0; $i < @mcaopts; $i += 2) {
+    $dvmopts = $dvmopts . " --prtemca " . $mcaopts[$i] . " " . $mcaopts[$i+1];
+}
+
+my @records;
+
+sub wait_ready
+{
+    my ($log) = @_;
+    my $waited = 0;
+
+    while ($waited < $timeout) {
+        if (open(my $fh, "<", $log)) {
+            while (my $line = <$fh>) {
+                if ($line =~ /DVM ready/i) {
+                    close($fh);
+                    return 1;
+                }
+            }
+            close($fh);
+        }
+        sleep(1);
+        $waited++;
+    }
+    return 0;
+}
+
+sub runtest
+{
+    my ($size) = @_;
+    my $log = "map_cache_bench.dvm." . $size . ".log";
+    my $dvm = "prte " . $dvmopts . " --prtemca rmaps_base_map_cache_size " . $size;
+    my $failed = 0;
+    my $t0;
+    my $elapsed;
+    my $count = 0;
+    my $mapsum = 0;
+
+    if ($SHOWME) {
+        print $dvm . "\n";
+        print $prun . "    (x " . $jobs . ")\n";
+        print "prun --system-server-only --terminate\n";
+        return;
+    }
+    if (!$QUIET) {
+        print "Running: cache_size=$size np=$np jobs=$jobs\n";
+    }
+
+    # the DVM prints a timing line for every job it maps, so send its
+    # output to a file rather than a pipe we would have to keep draining
+    unlink($log);
+    system($dvm . " > " . $log . " 2>&1 &");
+    if (!wait_ready($log)) {
+        print "DVM did not report ready within $timeout seconds - see $log\n";
+        system("prun --system-server-only --terminate > /dev/null 2>&1");
+        return;
+    }
+
+    $t0 = [gettimeofday];
+    for (1..$jobs) {
+        if (0 != system($prun . " > /dev/null 2>&1")) {
+            $failed++;
+        }
+    }
+    $elapsed = tv_interval($t0);
+
+    system("prun --system-server-only --terminate > /dev/null 2>&1");
+
+    if (open(my $fh, "<", $log)) {
+        while (my $line = <$fh>) {
+            if ($line =~ /\[rmaps:timing\].*\btotal=(\S+)/) {
+                $mapsum += $1;
+                $count++;
+            }
+        }
+        close($fh);
+    }
+
+    push @records, {cache_size => $size, np => $np, jobs => $jobs,
+                    failed => $failed, elapsed => $elapsed,
+                    jobs_per_sec => (0 < $elapsed) ? $jobs / $elapsed : "",
+                    map_avg => (0 < $count) ? $mapsum / $count : ""};
+    if (!$QUIET) {
+        printf("    %.2f jobs/sec, %d failed\n", (0 < $elapsed) ? $jobs / $elapsed : 0, $failed);
+    }
+}
+
+foreach my $size (split(",", $sizes)) {
+    runtest($size);
+}
+
+if ($SHOWME) {
+    exit(0);
+}
+
+my @fields = qw(cache_size np jobs failed elapsed jobs_per_sec map_avg);
+open(my $fh, ">", $myresults) or die "could not open $myresults: $!";
+print $fh join(",", @fields) . "\n";
+foreach my $rec (@records) {
+    my @row;
+    foreach my $key (@fields) {
+        push @row, $rec->{$key};
+    }
+    print $fh join(",", @row) . "\n";
+}
+close($fh);
+
+if (!$QUIET) {
+    print "Results stored in " . $myresults . "\n";
+}
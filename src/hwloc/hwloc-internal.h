@@ -118,10 +118,27 @@ typedef struct {
 } prte_hwloc_summary_t;
 PRTE_CLASS_DECLARATION(prte_hwloc_summary_t);
 
+/* index of the objects of a given type in a topology */
+typedef struct {
+    prte_list_item_t super;
+    hwloc_obj_type_t type;
+    unsigned cache_level;
+    unsigned int num_objs;
+    /* the objects, in the order of their index */
+    hwloc_obj_t *objs;
+    /* index of the first object containing each cpu, by
+     * its os index - UINT_MAX if no object contains it */
+    unsigned int npus;
+    unsigned int *pu_obj;
+} prte_hwloc_obj_index_t;
+PRTE_CLASS_DECLARATION(prte_hwloc_obj_index_t);
+
 typedef struct {
     prte_object_t super;
     hwloc_cpuset_t available;
     prte_list_t summaries;
+    /* list of prte_hwloc_obj_index_t, built as they are needed */
+    prte_list_t indices;
 
     /** \brief Additional space for custom data */
     void *userdata;
@@ -215,6 +232,7 @@ extern char* prte_hwloc_print_null;
 PRTE_EXPORT char* prte_hwloc_base_print_locality(prte_hwloc_locality_t locality);
 
 PRTE_EXPORT extern char *prte_hwloc_base_topo_file;
+PRTE_EXPORT extern char *prte_hwloc_base_topo_cache_dir;
 
 /* convenience macro for debugging */
 #define PRTE_HWLOC_SHOW_BINDING(n, v, t)                                \
@@ -335,6 +353,16 @@ PRTE_EXPORT hwloc_obj_t prte_hwloc_base_get_obj_by_type(hwloc_topology_t topo,
 PRTE_EXPORT unsigned int prte_hwloc_base_get_obj_idx(hwloc_topology_t topo,
                                                        hwloc_obj_t obj);
 
+/* get the index of the objects of a given type in a topology, building
+ * it on first use - returns NULL if the topology has not been setup */
+PRTE_EXPORT prte_hwloc_obj_index_t* prte_hwloc_base_get_obj_index(hwloc_topology_t topo,
+                                                                  hwloc_obj_type_t target,
+                                                                  unsigned cache_level);
+/* get the index of the first object sharing a cpu with the cpuset,
+ * or UINT_MAX if there is none */
+PRTE_EXPORT unsigned int prte_hwloc_base_get_first_obj_idx(prte_hwloc_obj_index_t *index,
+                                                             hwloc_const_cpuset_t cpuset);
+
 PRTE_EXPORT int prte_hwloc_get_sorted_numa_list(hwloc_topology_t topo,
                                     char* device_name,
                                     prte_list_t *sorted_list);
@@ -426,6 +454,31 @@ PRTE_EXPORT int prte_hwloc_base_topology_export_xmlbuffer(hwloc_topology_t topol
 
 PRTE_EXPORT int prte_hwloc_base_topology_set_flags (hwloc_topology_t topology, unsigned long flags, bool io);
 
+/* object counts that are cheap to extract from a topology and are
+ * passed along with it, so the HNP can compute slots for a node
+ * without importing its topology */
+typedef enum {
+    PRTE_HWLOC_COUNT_PU,
+    PRTE_HWLOC_COUNT_CORE,
+    PRTE_HWLOC_COUNT_PACKAGE,
+    PRTE_HWLOC_COUNT_NUMA,
+    PRTE_HWLOC_COUNT_MAX
+} prte_hwloc_count_t;
+
+PRTE_EXPORT void prte_hwloc_base_get_topo_counts(hwloc_topology_t topo, uint32_t *counts);
+
+/* forward declaration - see src/runtime/prte_globals.h */
+struct prte_topology_t;
+
+/* load the packed topology matching the signature of the given object
+ * from the topology cache directory - returns PRTE_ERR_NOT_FOUND if it
+ * isn't cached, or the entry doesn't match the signature or our hwloc
+ * version. The topology is not imported */
+PRTE_EXPORT int prte_hwloc_base_topo_cache_load(struct prte_topology_t *t);
+
+/* save a topology in the topology cache directory, if one was given */
+PRTE_EXPORT int prte_hwloc_base_topo_cache_store(struct prte_topology_t *t);
+
 PRTE_EXPORT int prte_hwloc_base_open(void);
 PRTE_EXPORT void prte_hwloc_base_close(void);
 PRTE_EXPORT int prte_hwloc_base_register(void);
@@ -37,6 +37,7 @@ prte_hwloc_base_mbfa_t prte_hwloc_base_mbfa = PRTE_HWLOC_BASE_MBFA_WARN;
 prte_binding_policy_t prte_hwloc_default_binding_policy=0;
 char *prte_hwloc_default_cpu_list=NULL;
 char *prte_hwloc_base_topo_file = NULL;
+char *prte_hwloc_base_topo_cache_dir = NULL;
 int prte_hwloc_base_output = -1;
 bool prte_hwloc_default_use_hwthread_cpus = false;
 
@@ -193,6 +194,13 @@ int prte_hwloc_base_register(void)
                                  PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE, PRTE_INFO_LVL_9,
                                  PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_hwloc_base_topo_file);
 
+    prte_hwloc_base_topo_cache_dir = NULL;
+    (void) prte_mca_base_var_register("prte", "hwloc", "base", "topo_cache_dir",
+                                 "Directory where the HNP caches the topologies reported by the daemons so "
+                                 "they need not be requested again on later startups (default: no caching)",
+                                 PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE, PRTE_INFO_LVL_9,
+                                 PRTE_MCA_BASE_VAR_SCOPE_READONLY, &prte_hwloc_base_topo_cache_dir);
+
     /* register parameters */
     return PRTE_SUCCESS;
 }
@@ -391,10 +399,30 @@ static void sum_dest(prte_hwloc_summary_t *ptr)
 PRTE_CLASS_INSTANCE(prte_hwloc_summary_t,
                    prte_list_item_t,
                    sum_const, sum_dest);
+static void obj_index_const(prte_hwloc_obj_index_t *ptr)
+{
+    ptr->num_objs = 0;
+    ptr->objs = NULL;
+    ptr->npus = 0;
+    ptr->pu_obj = NULL;
+}
+static void obj_index_dest(prte_hwloc_obj_index_t *ptr)
+{
+    if (NULL != ptr->objs) {
+        free(ptr->objs);
+    }
+    if (NULL != ptr->pu_obj) {
+        free(ptr->pu_obj);
+    }
+}
+PRTE_CLASS_INSTANCE(prte_hwloc_obj_index_t,
+                   prte_list_item_t,
+                   obj_index_const, obj_index_dest);
 static void topo_data_const(prte_hwloc_topo_data_t *ptr)
 {
     ptr->available = NULL;
     PRTE_CONSTRUCT(&ptr->summaries, prte_list_t);
+    PRTE_CONSTRUCT(&ptr->indices, prte_list_t);
     ptr->userdata = NULL;
 }
 static void topo_data_dest(prte_hwloc_topo_data_t *ptr)
@@ -408,6 +436,7 @@ static void topo_data_dest(prte_hwloc_topo_data_t *ptr)
         PRTE_RELEASE(item);
     }
     PRTE_DESTRUCT(&ptr->summaries);
+    PRTE_LIST_DESTRUCT(&ptr->indices);
     ptr->userdata = NULL;
 }
 PRTE_CLASS_INSTANCE(prte_hwloc_topo_data_t,
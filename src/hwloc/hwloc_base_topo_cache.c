@@ -0,0 +1,237 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#include "src/runtime/prte_globals.h"
+#include "src/include/constants.h"
+#include "src/util/output.h"
+#include "src/util/os_dirpath.h"
+#include "src/util/os_path.h"
+#include "src/util/printf.h"
+#include "src/pmix/pmix-internal.h"
+
+#include "src/hwloc/hwloc-internal.h"
+
+/*
+ * The HNP can keep the topologies reported by the daemons in a
+ * directory so that later DVMs on the same cluster need not request
+ * them again. Each file holds one topology, named by the digest of its
+ * signature and the hwloc API version that exported it, and contains:
+ *
+ *   - the signature, checked on load to guard against digest collisions
+ *   - the hwloc API version, checked on load
+ *   - the topology exactly as the daemons send it (see
+ *     prte_topology_pack), so a cache hit can also defer the import
+ */
+
+static char* cache_path(const char *sig)
+{
+    char *fname, *path;
+
+    if (0 > prte_asprintf(&fname, "topo.%016" PRIx64 ".hwloc%x",
+                          prte_topology_sig_digest(sig),
+                          (unsigned)hwloc_get_api_version())) {
+        return NULL;
+    }
+    path = prte_os_path(false, prte_hwloc_base_topo_cache_dir, fname, NULL);
+    free(fname);
+    return path;
+}
+
+int prte_hwloc_base_topo_cache_load(prte_topology_t *t)
+{
+    char *path, *s = NULL;
+    int fd, rc, cnt;
+    struct stat st;
+    pmix_byte_object_t bo;
+    pmix_data_buffer_t buf;
+    uint32_t version;
+
+    if (NULL == prte_hwloc_base_topo_cache_dir || NULL == t->sig) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+    if (NULL == (path = cache_path(t->sig))) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    fd = open(path, O_RDONLY);
+    if (0 > fd) {
+        PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache no entry %s", path));
+        free(path);
+        return PRTE_ERR_NOT_FOUND;
+    }
+    if (0 != fstat(fd, &st) || 0 >= st.st_size) {
+        close(fd);
+        free(path);
+        return PRTE_ERR_NOT_FOUND;
+    }
+    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+    bo.size = st.st_size;
+    bo.bytes = (char*)malloc(bo.size);
+    if (NULL == bo.bytes) {
+        close(fd);
+        free(path);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    if ((ssize_t)bo.size != read(fd, bo.bytes, bo.size)) {
+        PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache short read of %s", path));
+        close(fd);
+        free(path);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        return PRTE_ERR_NOT_FOUND;
+    }
+    close(fd);
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = PMIx_Data_load(&buf, &bo);
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    if (PMIX_SUCCESS != rc) {
+        rc = PRTE_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+    /* the entry must be for this signature and hwloc version */
+    cnt = 1;
+    if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, &buf, &s, &cnt, PMIX_STRING) ||
+        NULL == s || 0 != strcmp(s, t->sig)) {
+        PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache signature mismatch in %s", path));
+        rc = PRTE_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, &buf, &version, &cnt, PMIX_UINT32) ||
+        version != (uint32_t)hwloc_get_api_version()) {
+        PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache hwloc version mismatch in %s", path));
+        rc = PRTE_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+    /* the topology itself is imported when first needed */
+    if (PRTE_SUCCESS != prte_topology_unpack(&buf, t)) {
+        t->have_counts = false;
+        PMIX_BYTE_OBJECT_DESTRUCT(&t->packed);
+        rc = PRTE_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+    PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                         "hwloc:base:topo_cache loaded %s", path));
+    rc = PRTE_SUCCESS;
+
+  cleanup:
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (NULL != s) {
+        free(s);
+    }
+    free(path);
+    return rc;
+}
+
+int prte_hwloc_base_topo_cache_store(prte_topology_t *t)
+{
+    char *path, *tmp = NULL;
+    int fd, rc;
+    pmix_data_buffer_t buf;
+    uint32_t version;
+
+    if (NULL == prte_hwloc_base_topo_cache_dir || NULL == t->sig) {
+        return PRTE_SUCCESS;
+    }
+    if (NULL == (path = cache_path(t->sig))) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    /* nothing to do if we already have it */
+    if (0 == access(path, R_OK)) {
+        free(path);
+        return PRTE_SUCCESS;
+    }
+    if (PRTE_SUCCESS != (rc = prte_os_dirpath_create(prte_hwloc_base_topo_cache_dir, S_IRWXU))) {
+        PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache cannot create %s",
+                             prte_hwloc_base_topo_cache_dir));
+        free(path);
+        return rc;
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = PMIx_Data_pack(NULL, &buf, &t->sig, 1, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        rc = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    version = (uint32_t)hwloc_get_api_version();
+    rc = PMIx_Data_pack(NULL, &buf, &version, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        rc = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    if (PRTE_SUCCESS != (rc = prte_topology_pack(&buf, t))) {
+        goto cleanup;
+    }
+
+    /* write to a private file and move it into place so that
+     * readers never see a partial entry */
+    if (0 > prte_asprintf(&tmp, "%s.%lu", path, (unsigned long)getpid())) {
+        tmp = NULL;
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (0 > fd) {
+        rc = PRTE_ERR_FILE_OPEN_FAILURE;
+        goto cleanup;
+    }
+    if ((ssize_t)buf.bytes_used != write(fd, buf.base_ptr, buf.bytes_used)) {
+        close(fd);
+        unlink(tmp);
+        rc = PRTE_ERR_FILE_WRITE_FAILURE;
+        goto cleanup;
+    }
+    close(fd);
+    if (0 != rename(tmp, path)) {
+        unlink(tmp);
+        rc = PRTE_ERR_FILE_WRITE_FAILURE;
+        goto cleanup;
+    }
+    PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                         "hwloc:base:topo_cache stored %s", path));
+    rc = PRTE_SUCCESS;
+
+  cleanup:
+    if (PRTE_SUCCESS != rc) {
+        PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache failed to store %s", path));
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (NULL != tmp) {
+        free(tmp);
+    }
+    free(path);
+    return rc;
+}
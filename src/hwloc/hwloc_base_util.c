@@ -560,11 +560,117 @@ unsigned int prte_hwloc_base_get_npus(hwloc_topology_t topo,
     return cnt;
 }
 
+/* return the index of the given object type if one has
+ * already been built, without building it */
+static prte_hwloc_obj_index_t* find_obj_index(hwloc_topology_t topo,
+                                              hwloc_obj_type_t target,
+                                              unsigned cache_level)
+{
+    hwloc_obj_t root;
+    prte_hwloc_topo_data_t *rdata;
+    prte_hwloc_obj_index_t *index;
+
+    root = hwloc_get_root_obj(topo);
+    if (NULL == root || NULL == (rdata = (prte_hwloc_topo_data_t*)root->userdata)) {
+        return NULL;
+    }
+    PRTE_LIST_FOREACH(index, &rdata->indices, prte_hwloc_obj_index_t) {
+        if (target == index->type && cache_level == index->cache_level) {
+            return index;
+        }
+    }
+    return NULL;
+}
+
+prte_hwloc_obj_index_t* prte_hwloc_base_get_obj_index(hwloc_topology_t topo,
+                                                      hwloc_obj_type_t target,
+                                                      unsigned cache_level)
+{
+    hwloc_obj_t root, obj;
+    prte_hwloc_topo_data_t *rdata;
+    prte_hwloc_obj_index_t *index;
+    unsigned int i;
+    int pu;
+
+    /* bozo check */
+    if (NULL == topo) {
+        return NULL;
+    }
+    root = hwloc_get_root_obj(topo);
+    if (NULL == (rdata = (prte_hwloc_topo_data_t*)root->userdata)) {
+        return NULL;
+    }
+
+    /* see if we already have it */
+    if (NULL != (index = find_obj_index(topo, target, cache_level))) {
+        return index;
+    }
+
+    index = PRTE_NEW(prte_hwloc_obj_index_t);
+    index->type = target;
+    index->cache_level = cache_level;
+    index->num_objs = prte_hwloc_base_get_nbobjs_by_type(topo, target, cache_level);
+    pu = hwloc_bitmap_last(root->cpuset);
+    if (0 < index->num_objs && 0 <= pu) {
+        index->objs = (hwloc_obj_t*)malloc(index->num_objs * sizeof(hwloc_obj_t));
+        index->npus = pu + 1;
+        index->pu_obj = (unsigned int*)malloc(index->npus * sizeof(unsigned int));
+        if (NULL == index->objs || NULL == index->pu_obj) {
+            PRTE_RELEASE(index);
+            return NULL;
+        }
+        for (i=0; i < index->npus; i++) {
+            index->pu_obj[i] = UINT_MAX;
+        }
+        for (i=0; i < index->num_objs; i++) {
+            index->objs[i] = prte_hwloc_base_get_obj_by_type(topo, target, cache_level, i);
+        }
+        /* work downwards so each cpu is left with the
+         * lowest index of the objects containing it */
+        for (i=index->num_objs; 0 < i; i--) {
+            obj = index->objs[i-1];
+            if (NULL == obj || NULL == obj->cpuset) {
+                continue;
+            }
+            for (pu = hwloc_bitmap_first(obj->cpuset); 0 <= pu;
+                 pu = hwloc_bitmap_next(obj->cpuset, pu)) {
+                if ((unsigned int)pu < index->npus) {
+                    index->pu_obj[pu] = i - 1;
+                }
+            }
+        }
+    } else {
+        index->num_objs = 0;
+    }
+    prte_list_append(&rdata->indices, &index->super);
+
+    PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                         "hwloc:base:get_obj_index built index of %u objects of type %s:%u",
+                         index->num_objs, hwloc_obj_type_string(target), cache_level));
+    return index;
+}
+
+unsigned int prte_hwloc_base_get_first_obj_idx(prte_hwloc_obj_index_t *index,
+                                                 hwloc_const_cpuset_t cpuset)
+{
+    unsigned int idx = UINT_MAX;
+    int pu;
+
+    for (pu = hwloc_bitmap_first(cpuset); 0 <= pu && (unsigned int)pu < index->npus;
+         pu = hwloc_bitmap_next(cpuset, pu)) {
+        if (index->pu_obj[pu] < idx) {
+            idx = index->pu_obj[pu];
+        }
+    }
+    return idx;
+}
+
 unsigned int prte_hwloc_base_get_obj_idx(hwloc_topology_t topo,
                                          hwloc_obj_t obj)
 {
     unsigned cache_level=0;
     prte_hwloc_obj_data_t *data;
+    prte_hwloc_obj_index_t *index;
     hwloc_obj_t ptr;
     unsigned int nobjs, i;
 
@@ -593,6 +699,27 @@ unsigned int prte_hwloc_base_get_obj_idx(hwloc_topology_t topo,
     }
 #endif
 
+    /* the logical index of an object is normally its position
+     * among the objects of its type, so check that first */
+    index = prte_hwloc_base_get_obj_index(topo, obj->type, cache_level);
+    if (NULL != index) {
+        if (obj->logical_index < index->num_objs &&
+            obj == index->objs[obj->logical_index]) {
+            data->idx = obj->logical_index;
+            return data->idx;
+        }
+        for (i=0; i < index->num_objs; i++) {
+            if (obj == index->objs[i]) {
+                data->idx = i;
+                return i;
+            }
+        }
+        prte_show_help("help-prte-hwloc-base.txt",
+                       "obj-idx-failed", true,
+                       hwloc_obj_type_string(obj->type), cache_level);
+        return UINT_MAX;
+    }
+
     nobjs = prte_hwloc_base_get_nbobjs_by_type(topo, obj->type, cache_level);
 
     PRTE_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
@@ -734,11 +861,19 @@ hwloc_obj_t prte_hwloc_base_get_obj_by_type(hwloc_topology_t topo,
                                             unsigned cache_level,
                                             unsigned int instance)
 {
+    prte_hwloc_obj_index_t *index;
+
     /* bozo check */
     if (NULL == topo) {
         return NULL;
     }
 
+    /* the mappers call this for every object they consider, so
+     * use the index of this type if we have already built one */
+    if (NULL != (index = find_obj_index(topo, target, cache_level)) &&
+        NULL != index->objs) {
+        return (instance < index->num_objs) ? index->objs[instance] : NULL;
+    }
 
 #if HWLOC_API_VERSION >= 0x20000
     return hwloc_get_obj_by_type(topo, target, instance);
@@ -2104,6 +2239,14 @@ int prte_hwloc_base_topology_export_xmlbuffer(hwloc_topology_t topology, char **
 #endif
 }
 
+void prte_hwloc_base_get_topo_counts(hwloc_topology_t topo, uint32_t *counts)
+{
+    counts[PRTE_HWLOC_COUNT_PU] = prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_PU, 0);
+    counts[PRTE_HWLOC_COUNT_CORE] = prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_CORE, 0);
+    counts[PRTE_HWLOC_COUNT_PACKAGE] = prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_PACKAGE, 0);
+    counts[PRTE_HWLOC_COUNT_NUMA] = prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_NODE, 0);
+}
+
 int prte_hwloc_base_topology_set_flags (hwloc_topology_t topology, unsigned long flags, bool io) {
     if (io) {
 #if HWLOC_API_VERSION < 0x00020000
@@ -479,7 +479,7 @@ int prte_ess_base_prted_setup(void)
     t->sig = strdup(prte_topo_signature);
     /* save the topology - note that this may have to be moved later
      * to ensure a common array position with the DVM master */
-    prte_pointer_array_add(prte_node_topologies, t);
+    prte_set_topology_object(t);
     if (15 < prte_output_get_verbosity(prte_ess_base_framework.framework_output)) {
         char *output = NULL;
         pmix_topology_t topo;
@@ -107,6 +107,10 @@ typedef struct {
     bool xoff;
     bool exclusive;
     bool closed;
+    /* output waiting to be delivered to a tool, and
+     * the number of deliveries currently in flight */
+    prte_list_t pending;
+    int inflight;
 } prte_iof_sink_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_iof_sink_t);
 
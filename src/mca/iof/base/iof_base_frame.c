@@ -201,6 +201,8 @@ static void prte_iof_base_sink_construct(prte_iof_sink_t* ptr)
     ptr->xoff = false;
     ptr->exclusive = false;
     ptr->closed = false;
+    PRTE_CONSTRUCT(&ptr->pending, prte_list_t);
+    ptr->inflight = 0;
 }
 static void prte_iof_base_sink_destruct(prte_iof_sink_t* ptr)
 {
@@ -211,6 +213,7 @@ static void prte_iof_base_sink_destruct(prte_iof_sink_t* ptr)
                              PRTE_NAME_PRINT(&ptr->name), ptr->wev->fd));
         PRTE_RELEASE(ptr->wev);
     }
+    PRTE_LIST_DESTRUCT(&ptr->pending);
 }
 PRTE_CLASS_INSTANCE(prte_iof_sink_t,
                    prte_list_item_t,
@@ -47,6 +47,38 @@
 
 #include "src/mca/iof/base/base.h"
 
+/* output formatting is fixed once a job is launched, so
+ * remember the flags of the job we last wrote output for
+ * rather than looking them up for every fragment */
+#define PRTE_IOF_OUTPUT_TIMESTAMP   0x01
+#define PRTE_IOF_OUTPUT_TAG         0x02
+#define PRTE_IOF_OUTPUT_XML         0x04
+
+static const prte_attribute_key_t output_keys[] = {
+    PRTE_JOB_TIMESTAMP_OUTPUT,
+    PRTE_JOB_TAG_OUTPUT,
+    PRTE_JOB_XML_OUTPUT
+};
+static pmix_nspace_t output_nspace = {0};
+static uint32_t output_flags = 0;
+
+static uint32_t get_output_flags(const pmix_nspace_t nspace)
+{
+    prte_job_t *jdata;
+
+    if (PMIX_CHECK_NSPACE(output_nspace, nspace)) {
+        return output_flags;
+    }
+    if (NULL == (jdata = prte_get_job_data_object(nspace))) {
+        /* don't cache this - the job may not have arrived yet */
+        return 0;
+    }
+    output_flags = prte_get_attribute_flags(&jdata->attributes, output_keys,
+                                            sizeof(output_keys) / sizeof(output_keys[0]));
+    PMIX_LOAD_NSPACE(output_nspace, nspace);
+    return output_flags;
+}
+
 int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
                                const unsigned char *data, int numbytes,
                                prte_iof_write_event_t *channel)
@@ -56,7 +88,7 @@ int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
     int i, j, k, starttaglen, endtaglen, num_buffered;
     bool endtagged;
     char qprint[10];
-    prte_job_t *jdata;
+    uint32_t flags;
     bool prte_xml_output;
     bool prte_timestamp_output;
     bool prte_tag_output;
@@ -71,11 +103,11 @@ int prte_iof_base_write_output(const pmix_proc_t *name, prte_iof_tag_t stream,
     /* setup output object */
     output = PRTE_NEW(prte_iof_write_output_t);
 
-    /* get the job object for this process */
-    jdata = prte_get_job_data_object(name->nspace);
-    prte_timestamp_output = prte_get_attribute(&jdata->attributes, PRTE_JOB_TIMESTAMP_OUTPUT, NULL, PMIX_BOOL);
-    prte_tag_output = prte_get_attribute(&jdata->attributes, PRTE_JOB_TAG_OUTPUT, NULL, PMIX_BOOL);
-    prte_xml_output = prte_get_attribute(&jdata->attributes, PRTE_JOB_XML_OUTPUT, NULL, PMIX_BOOL);
+    /* get the output options for the job of this process */
+    flags = get_output_flags(name->nspace);
+    prte_timestamp_output = (flags & PRTE_IOF_OUTPUT_TIMESTAMP);
+    prte_tag_output = (flags & PRTE_IOF_OUTPUT_TAG);
+    prte_xml_output = (flags & PRTE_IOF_OUTPUT_XML);
 
     /* write output data to the corresponding tag */
     if (PRTE_IOF_STDIN & stream) {
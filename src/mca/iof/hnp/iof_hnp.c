@@ -562,56 +562,208 @@ static void stdin_write_handler(int fd, short event, void *cbdata)
     return;
 }
 
-static void lkcbfunc(pmix_status_t status, void *cbdata)
+static void fcon(prte_iof_hnp_frag_t *p)
 {
-    prte_pmix_lock_t *lk = (prte_pmix_lock_t*)cbdata;
+    p->sink = NULL;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->bo);
+    p->status = PMIX_SUCCESS;
+}
+static void fdes(prte_iof_hnp_frag_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->bo);
+}
+PRTE_CLASS_INSTANCE(prte_iof_hnp_frag_t,
+                    prte_list_item_t,
+                    fcon, fdes);
+
+static pmix_iof_channel_t tag_to_channel(prte_iof_tag_t tag)
+{
+    pmix_iof_channel_t pchan = 0;
 
-    PRTE_POST_OBJECT(lk);
-    lk->status = prte_pmix_convert_status(status);
-    PRTE_PMIX_WAKEUP_THREAD(lk);
+    if (PRTE_IOF_STDIN & tag) {
+        pchan |= PMIX_FWD_STDIN_CHANNEL;
+    }
+    if (PRTE_IOF_STDOUT & tag) {
+        pchan |= PMIX_FWD_STDOUT_CHANNEL;
+    }
+    if (PRTE_IOF_STDERR & tag) {
+        pchan |= PMIX_FWD_STDERR_CHANNEL;
+    }
+    if (PRTE_IOF_STDDIAG & tag) {
+        pchan |= PMIX_FWD_STDDIAG_CHANNEL;
+    }
+    return pchan;
 }
 
-static int hnp_output(const pmix_proc_t* peer,
-                      prte_iof_tag_t source_tag,
-                      const char *msg)
+static void restart_reads(prte_iof_sink_t *sink)
 {
-    pmix_iof_channel_t pchan;
-    pmix_byte_object_t bo;
-    prte_pmix_lock_t lock;
-    pmix_status_t rc;
-    int ret;
+    prte_iof_proc_t *proct;
 
-    if (PRTE_PROC_IS_MASTER) {
-        pchan = 0;
-        if (PRTE_IOF_STDIN & source_tag) {
-            pchan |= PMIX_FWD_STDIN_CHANNEL;
+    /* the sink is fed by the output of the procs it names - restart
+     * any read events we held while its deliveries drained */
+    PRTE_LIST_FOREACH(proct, &prte_iof_hnp_component.procs, prte_iof_proc_t) {
+        if (!PMIX_CHECK_PROCID(&proct->name, &sink->name)) {
+            continue;
         }
-        if (PRTE_IOF_STDOUT & source_tag) {
-            pchan |= PMIX_FWD_STDOUT_CHANNEL;
+        if (NULL != proct->revstdout && !proct->revstdout->active) {
+            PRTE_IOF_READ_ACTIVATE(proct->revstdout);
         }
-        if (PRTE_IOF_STDERR & source_tag) {
-            pchan |= PMIX_FWD_STDERR_CHANNEL;
+        if (NULL != proct->revstderr && !proct->revstderr->active) {
+            PRTE_IOF_READ_ACTIVATE(proct->revstderr);
         }
-        if (PRTE_IOF_STDDIAG & source_tag) {
-            pchan |= PMIX_FWD_STDDIAG_CHANNEL;
+    }
+}
+
+static void progress_sink(prte_iof_sink_t *sink);
+
+static void deliver_done(int sd, short args, void *cbdata)
+{
+    prte_iof_hnp_frag_t *frag = (prte_iof_hnp_frag_t*)cbdata;
+    prte_iof_sink_t *sink = frag->sink;
+
+    PRTE_ACQUIRE_OBJECT(frag);
+
+    if (PMIX_SUCCESS != frag->status) {
+        PMIX_ERROR_LOG(frag->status);
+    }
+    PRTE_RELEASE(frag);
+    if (NULL == sink) {
+        return;
+    }
+    --sink->inflight;
+    progress_sink(sink);
+    if (sink->xoff &&
+        (int)prte_list_get_size(&sink->pending) < prte_iof_hnp_component.max_inflight) {
+        /* the tool has caught up - resume reading */
+        sink->xoff = false;
+        restart_reads(sink);
+    }
+    /* release the reference held for this delivery */
+    PRTE_RELEASE(sink);
+}
+
+static void deliver_complete(pmix_status_t status, void *cbdata)
+{
+    prte_iof_hnp_frag_t *frag = (prte_iof_hnp_frag_t*)cbdata;
+
+    /* this comes from the PMIx thread - shift to our own */
+    frag->status = status;
+    PRTE_THREADSHIFT(frag, prte_event_base, deliver_done, PRTE_MSG_PRI);
+}
+
+static int send_frag(prte_iof_hnp_frag_t *frag)
+{
+    pmix_status_t rc;
+
+    rc = PMIx_server_IOF_deliver(&frag->source, tag_to_channel(frag->tag),
+                                 &frag->bo, NULL, 0, deliver_complete, (void*)frag);
+    if (PMIX_SUCCESS != rc) {
+        /* the callback will not be called */
+        if (PMIX_OPERATION_SUCCEEDED == rc) {
+            return PRTE_SUCCESS;
         }
-        /* setup the byte object */
-        PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
-        if (NULL != msg) {
-            bo.bytes = (char*)msg;
-            bo.size = strlen(msg)+1;
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_ERR_OP_IN_PROGRESS;
+}
+
+static void progress_sink(prte_iof_sink_t *sink)
+{
+    prte_iof_hnp_frag_t *frag;
+    int rc;
+
+    while (sink->inflight < prte_iof_hnp_component.max_inflight &&
+           NULL != (frag = (prte_iof_hnp_frag_t*)prte_list_remove_first(&sink->pending))) {
+        /* each delivery in flight holds a reference to the sink */
+        PRTE_RETAIN(sink);
+        frag->sink = sink;
+        ++sink->inflight;
+        rc = send_frag(frag);
+        if (PRTE_ERR_OP_IN_PROGRESS != rc) {
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+            }
+            --sink->inflight;
+            frag->sink = NULL;
+            PRTE_RELEASE(frag);
+            PRTE_RELEASE(sink);
         }
-        PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-        rc = PMIx_server_IOF_deliver(peer, pchan, &bo, NULL, 0, lkcbfunc, (void*)&lock);
-        if (PMIX_SUCCESS != rc) {
-            ret = prte_pmix_convert_status(rc);
-        } else {
-            /* wait for completion */
-            PRTE_PMIX_WAIT_THREAD(&lock);
-            ret = lock.status;
+    }
+}
+
+/* hand output to PMIx for delivery to a tool. The data is copied so
+ * the caller can reuse its buffer right away, and we never wait for
+ * delivery to complete as this is called from handlers in the event
+ * base. Up to max_inflight fragments are kept in flight for each sink -
+ * anything beyond that is queued, and adjacent fragments from the same
+ * source and channel are merged while they wait. Returns true if the
+ * sink is backed up and the caller should stop feeding it for now */
+bool prte_iof_hnp_deliver(prte_iof_sink_t *sink,
+                          const pmix_proc_t *source, prte_iof_tag_t tag,
+                          const char *data, size_t numbytes)
+{
+    prte_iof_hnp_frag_t *frag;
+    char *tmp;
+    int rc;
+
+    /* see if we can add this to the fragment at the end of the queue */
+    if (NULL != sink && NULL != data && 0 < numbytes) {
+        frag = (prte_iof_hnp_frag_t*)prte_list_get_last(&sink->pending);
+        if (frag != (prte_iof_hnp_frag_t*)prte_list_get_end(&sink->pending) &&
+            frag->tag == tag && PMIX_CHECK_PROCID(&frag->source, source) &&
+            frag->bo.size + numbytes <= (size_t)prte_iof_hnp_component.coalesce_max) {
+            tmp = (char*)realloc(frag->bo.bytes, frag->bo.size + numbytes);
+            if (NULL != tmp) {
+                memcpy(tmp + frag->bo.size, data, numbytes);
+                frag->bo.bytes = tmp;
+                frag->bo.size += numbytes;
+                goto progress;
+            }
         }
-        PRTE_PMIX_DESTRUCT_LOCK(&lock);
-        return ret;
+    }
+
+    frag = PRTE_NEW(prte_iof_hnp_frag_t);
+    PMIX_XFER_PROCID(&frag->source, source);
+    frag->tag = tag;
+    if (NULL != data && 0 < numbytes) {
+        frag->bo.bytes = (char*)malloc(numbytes);
+        if (NULL == frag->bo.bytes) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            PRTE_RELEASE(frag);
+            return false;
+        }
+        memcpy(frag->bo.bytes, data, numbytes);
+        frag->bo.size = numbytes;
+    }
+
+    if (NULL == sink) {
+        /* not bound to a sink, so nothing to pace against */
+        rc = send_frag(frag);
+        if (PRTE_ERR_OP_IN_PROGRESS != rc) {
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+            }
+            PRTE_RELEASE(frag);
+        }
+        return false;
+    }
+    prte_list_append(&sink->pending, &frag->super);
+
+  progress:
+    progress_sink(sink);
+    if (prte_iof_hnp_component.max_inflight <= (int)prte_list_get_size(&sink->pending)) {
+        sink->xoff = true;
+    }
+    return sink->xoff;
+}
+
+static int hnp_output(const pmix_proc_t* peer,
+                      prte_iof_tag_t source_tag,
+                      const char *msg)
+{
+    if (PRTE_PROC_IS_MASTER) {
+        prte_iof_hnp_deliver(NULL, peer, source_tag, msg,
+                             (NULL == msg) ? 0 : strlen(msg)+1);
     } else {
         /* output this to our local output */
         if (PRTE_IOF_STDOUT & source_tag) {
@@ -67,12 +67,26 @@ struct prte_iof_hnp_component_t {
     prte_list_t procs;
     prte_iof_read_event_t *stdinev;
     prte_event_t stdinsig;
+    int max_inflight;
+    int coalesce_max;
 };
 typedef struct prte_iof_hnp_component_t prte_iof_hnp_component_t;
 
 PRTE_MODULE_EXPORT extern prte_iof_hnp_component_t prte_iof_hnp_component;
 extern prte_iof_base_module_t prte_iof_hnp_module;
 
+/* a fragment of output being delivered to a tool via PMIx */
+typedef struct {
+    prte_list_item_t super;
+    prte_event_t ev;
+    prte_iof_sink_t *sink;
+    pmix_proc_t source;
+    prte_iof_tag_t tag;
+    pmix_byte_object_t bo;
+    pmix_status_t status;
+} prte_iof_hnp_frag_t;
+PRTE_CLASS_DECLARATION(prte_iof_hnp_frag_t);
+
 void prte_iof_hnp_recv(int status, pmix_proc_t* sender,
                        pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
                        void* cbdata);
@@ -86,6 +100,10 @@ int prte_iof_hnp_send_data_to_endpoint(pmix_proc_t *host,
                                        prte_iof_tag_t tag,
                                        unsigned char *data, int numbytes);
 
+bool prte_iof_hnp_deliver(prte_iof_sink_t *sink,
+                          const pmix_proc_t *source, prte_iof_tag_t tag,
+                          const char *data, size_t numbytes);
+
 END_C_DECLS
 
 #endif
@@ -38,6 +38,7 @@
 /*
  * Local functions
  */
+static int prte_iof_hnp_register(void);
 static int prte_iof_hnp_open(void);
 static int prte_iof_hnp_close(void);
 static int prte_iof_hnp_query(prte_mca_base_module_t **module, int *priority);
@@ -64,6 +65,7 @@ prte_iof_hnp_component_t prte_iof_hnp_component = {
             .mca_open_component = prte_iof_hnp_open,
             .mca_close_component = prte_iof_hnp_close,
             .mca_query_component = prte_iof_hnp_query,
+            .mca_register_component_params = prte_iof_hnp_register,
         },
         .iof_data = {
             /* The component is checkpoint ready */
@@ -72,6 +74,34 @@ prte_iof_hnp_component_t prte_iof_hnp_component = {
     }
 };
 
+static int prte_iof_hnp_register(void)
+{
+    prte_mca_base_component_t *c = &prte_iof_hnp_component.super.iof_version;
+
+    prte_iof_hnp_component.max_inflight = 8;
+    (void) prte_mca_base_component_var_register(c, "max_inflight",
+                                           "Maximum number of output fragments in flight to each tool - output beyond this is queued, and reading from local procs is held while the queue is full",
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                           PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prte_iof_hnp_component.max_inflight);
+    if (prte_iof_hnp_component.max_inflight < 1) {
+        prte_iof_hnp_component.max_inflight = 1;
+    }
+
+    prte_iof_hnp_component.coalesce_max = 65536;
+    (void) prte_mca_base_component_var_register(c, "coalesce_max",
+                                           "Maximum size in bytes of a queued output fragment when merging output waiting for delivery to a tool",
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                           PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prte_iof_hnp_component.coalesce_max);
+
+    return PRTE_SUCCESS;
+}
+
 /**
   * component open/close/init function
   */
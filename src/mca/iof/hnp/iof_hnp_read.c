@@ -95,15 +95,6 @@ void prte_iof_hnp_stdin_cb(int fd, short event, void *cbdata)
     }
 }
 
-static void lkcbfunc(pmix_status_t status, void *cbdata)
-{
-    prte_pmix_lock_t *lk = (prte_pmix_lock_t*)cbdata;
-
-    PRTE_POST_OBJECT(lk);
-    lk->status = prte_pmix_convert_status(status);
-    PRTE_PMIX_WAKEUP_THREAD(lk);
-}
-
 /* this is the read handler for my own child procs. In this case,
  * the data is going nowhere - I just output it myself
  */
@@ -115,7 +106,7 @@ void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
     prte_iof_proc_t *proct = (prte_iof_proc_t*)rev->proc;
     int rc;
     prte_ns_cmp_bitmask_t mask=PRTE_NS_CMP_ALL;
-    bool exclusive;
+    bool exclusive, backlogged;
     prte_iof_sink_t *sink;
 
     PRTE_ACQUIRE_OBJECT(rev);
@@ -242,6 +233,7 @@ void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
      * we were directed to put it into a file, then
      */
     exclusive = false;
+    backlogged = false;
     if (NULL != proct->subscribers) {
         PRTE_LIST_FOREACH(sink, proct->subscribers, prte_iof_sink_t) {
             /* if the target isn't set, then this sink is for another purpose - ignore it */
@@ -264,36 +256,9 @@ void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
                                      PRTE_NAME_PRINT(&sink->daemon)));
                 /* don't pass down zero byte blobs */
                 if (0 < numbytes) {
-                    pmix_byte_object_t bo;
-                    pmix_iof_channel_t pchan;
-                    prte_pmix_lock_t lock;
-                    pmix_status_t prc;
-                    pchan = 0;
-                    if (PRTE_IOF_STDIN & rev->tag) {
-                        pchan |= PMIX_FWD_STDIN_CHANNEL;
-                    }
-                    if (PRTE_IOF_STDOUT & rev->tag) {
-                        pchan |= PMIX_FWD_STDOUT_CHANNEL;
-                    }
-                    if (PRTE_IOF_STDERR & rev->tag) {
-                        pchan |= PMIX_FWD_STDERR_CHANNEL;
-                    }
-                    if (PRTE_IOF_STDDIAG & rev->tag) {
-                        pchan |= PMIX_FWD_STDDIAG_CHANNEL;
+                    if (prte_iof_hnp_deliver(sink, &proct->name, rev->tag, (const char*)data, numbytes)) {
+                        backlogged = true;
                     }
-                    /* setup the byte object */
-                    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
-                    bo.bytes = (char*)data;
-                    bo.size = numbytes;
-                    PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-                    prc = PMIx_server_IOF_deliver(&proct->name, pchan, &bo, NULL, 0, lkcbfunc, (void*)&lock);
-                    if (PMIX_SUCCESS != prc) {
-                        PMIX_ERROR_LOG(prc);
-                    } else {
-                        /* wait for completion */
-                        PRTE_PMIX_WAIT_THREAD(&lock);
-                    }
-                    PRTE_PMIX_DESTRUCT_LOCK(&lock);
                 }
                 if (sink->exclusive) {
                     exclusive = true;
@@ -357,6 +322,17 @@ void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
         prte_iof_base_write_output(&proct->name, rev->tag, data, numbytes, rev->sink->wev);
     }
 
+    if (backlogged) {
+        /* a tool isn't keeping up with this proc's output - hold
+         * the read until its deliveries drain */
+        PRTE_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                             "%s tool delivery backed up - holding read of %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_NAME_PRINT(&proct->name)));
+        rev->active = false;
+        return;
+    }
+
     /* re-add the event */
     PRTE_IOF_READ_ACTIVATE(rev);
     return;
@@ -53,15 +53,6 @@
 
 #include "iof_hnp.h"
 
-static void lkcbfunc(pmix_status_t status, void *cbdata)
-{
-    prte_pmix_lock_t *lk = (prte_pmix_lock_t*)cbdata;
-
-    PRTE_POST_OBJECT(lk);
-    lk->status = prte_pmix_convert_status(status);
-    PRTE_PMIX_WAKEUP_THREAD(lk);
-}
-
 void prte_iof_hnp_recv(int status, pmix_proc_t* sender,
                        pmix_data_buffer_t* buffer, prte_rml_tag_t tag,
                        void* cbdata)
@@ -263,36 +254,9 @@ void prte_iof_hnp_recv(int status, pmix_proc_t* sender,
                                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                          PRTE_NAME_PRINT(&origin), (int)numbytes,
                                          PRTE_NAME_PRINT(&sink->daemon)));
-                    pmix_byte_object_t bo;
-                    pmix_iof_channel_t pchan;
-                    prte_pmix_lock_t lock;
-                    pmix_status_t prc;
-                    pchan = 0;
-                    if (PRTE_IOF_STDIN & stream) {
-                        pchan |= PMIX_FWD_STDIN_CHANNEL;
-                    }
-                    if (PRTE_IOF_STDOUT & stream) {
-                        pchan |= PMIX_FWD_STDOUT_CHANNEL;
-                    }
-                    if (PRTE_IOF_STDERR & stream) {
-                        pchan |= PMIX_FWD_STDERR_CHANNEL;
-                    }
-                    if (PRTE_IOF_STDDIAG & stream) {
-                        pchan |= PMIX_FWD_STDDIAG_CHANNEL;
-                    }
-                    /* setup the byte object */
-                    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
-                    bo.bytes = (char*)data;
-                    bo.size = numbytes;
-                    PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-                    prc = PMIx_server_IOF_deliver(&origin, pchan, &bo, NULL, 0, lkcbfunc, (void*)&lock);
-                    if (PMIX_SUCCESS != prc) {
-                        PMIX_ERROR_LOG(prc);
-                    } else {
-                        /* wait for completion */
-                        PRTE_PMIX_WAIT_THREAD(&lock);
-                    }
-                    PRTE_PMIX_DESTRUCT_LOCK(&lock);
+                    /* there is no local read to hold for remote procs, so
+                     * the output just queues until the tool catches up */
+                    (void)prte_iof_hnp_deliver(sink, &origin, stream, (const char*)data, numbytes);
                 }
                 if (sink->exclusive) {
                     exclusive = true;
@@ -273,21 +273,6 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer,
         }
     }
 
-    /* pack the job struct */
-    rc = prte_job_pack(buffer, jdata);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PMIX_BOOL)) {
-        /* compute and pack the ppn */
-        if (PRTE_SUCCESS != (rc = prte_util_generate_ppn(jdata, buffer))) {
-            PRTE_ERROR_LOG(rc);
-            return rc;
-        }
-    }
-
     /* assemble the node and proc map info */
     list = NULL;
     procs = NULL;
@@ -355,6 +340,31 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer,
         free(regex);
     }
 
+    /* pack the job-level info that is identical on every daemon so
+     * they don't each have to construct it when registering the nspace.
+     * This isn't fatal - the daemons generate it themselves if it
+     * isn't provided */
+    if (PRTE_SUCCESS != (rc = prte_pmix_server_pack_job_info(jdata, cd.info, 2))) {
+        PRTE_ERROR_LOG(rc);
+    }
+
+    /* pack the job struct */
+    rc = prte_job_pack(buffer, jdata);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_INFO_FREE(cd.info, cd.ninfo);
+        return rc;
+    }
+
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PMIX_BOOL)) {
+        /* compute and pack the ppn */
+        if (PRTE_SUCCESS != (rc = prte_util_generate_ppn(jdata, buffer))) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_INFO_FREE(cd.info, cd.ninfo);
+            return rc;
+        }
+    }
+
     /* construct the actual request - we just let them pick the
      * default transport for now. Someday, we will add to prun
      * the ability for transport specifications */
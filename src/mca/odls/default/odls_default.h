@@ -31,6 +31,7 @@
 #include "src/mca/mca.h"
 
 #include "src/mca/odls/odls.h"
+#include "src/mca/odls/base/odls_private.h"
 
 BEGIN_C_DECLS
 
@@ -47,6 +48,25 @@ int prte_odls_default_component_query(prte_mca_base_module_t **module, int *prio
 extern prte_odls_base_module_t prte_odls_default_module;
 PRTE_MODULE_EXPORT extern prte_odls_base_component_t prte_odls_default_component;
 
+/* whether or not to launch children via the pre-forked helper */
+extern bool prte_odls_default_use_zygote;
+
+/* send a rendered error message up the pipe to the waiting
+ * parent and exit - only to be called in a forked child */
+void prte_odls_default_send_error_show_help(int fd, int exit_status,
+                                            const char *file, const char *topic, ...)
+    __prte_attribute_noreturn__;
+
+/*
+ * Pre-forked launch helper
+ */
+int prte_odls_default_zygote_start(void);
+void prte_odls_default_zygote_stop(void);
+bool prte_odls_default_zygote_active(void);
+pid_t prte_odls_default_zygote_spawn(prte_odls_spawn_caddy_t *cd,
+                                     const char *cpuset, bool membind,
+                                     int errfd, int relfd);
+
 END_C_DECLS
 
 #endif /* PRTE_ODLS_H */
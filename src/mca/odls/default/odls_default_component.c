@@ -40,11 +40,17 @@
 
 #include "src/mca/mca.h"
 #include "src/mca/base/base.h"
+#include "src/util/output.h"
 
 #include "src/mca/odls/odls.h"
+#include "src/mca/odls/base/base.h"
 #include "src/mca/odls/base/odls_private.h"
 #include "src/mca/odls/default/odls_default.h"
 
+static int odls_default_register(void);
+
+bool prte_odls_default_use_zygote = false;
+
 /*
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
@@ -64,6 +70,7 @@ prte_odls_base_component_t prte_odls_default_component = {
         .mca_open_component = prte_odls_default_component_open,
         .mca_close_component = prte_odls_default_component_close,
         .mca_query_component = prte_odls_default_component_query,
+        .mca_register_component_params = odls_default_register,
     },
     .base_data = {
         /* The component is checkpoint ready */
@@ -73,6 +80,22 @@ prte_odls_base_component_t prte_odls_default_component = {
 
 
 
+static int odls_default_register(void)
+{
+    prte_mca_base_component_t *c = &prte_odls_default_component.version;
+
+    prte_odls_default_use_zygote = false;
+    (void) prte_mca_base_component_var_register(c, "zygote",
+                                                "Launch local procs via a small helper process forked at daemon startup "
+                                                "instead of forking each one from the daemon itself (Linux only)",
+                                                PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                                PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                                PRTE_INFO_LVL_9,
+                                                PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                &prte_odls_default_use_zygote);
+    return PRTE_SUCCESS;
+}
+
 int prte_odls_default_component_open(void)
 {
     return PRTE_SUCCESS;
@@ -91,11 +114,19 @@ int prte_odls_default_component_query(prte_mca_base_module_t **module, int *prio
      */
     *priority = 10; /* let others override us - we are the default */
     *module = (prte_mca_base_module_t *) &prte_odls_default_module;
+
+    /* start the launch helper now, while our footprint is still small */
+    if (prte_odls_default_use_zygote &&
+        PRTE_SUCCESS != prte_odls_default_zygote_start()) {
+        prte_output_verbose(2, prte_odls_base_framework.framework_output,
+                            "odls:default zygote not available - forking directly");
+    }
     return PRTE_SUCCESS;
 }
 
 
 int prte_odls_default_component_close(void)
 {
+    prte_odls_default_zygote_stop();
     return PRTE_SUCCESS;
 }
@@ -129,7 +129,9 @@
 #include "src/mca/ess/ess.h"
 #include "src/mca/iof/base/iof_base_setup.h"
 #include "src/mca/plm/plm.h"
+#include "src/mca/rmaps/rmaps_types.h"
 #include "src/mca/rtc/rtc.h"
+#include "src/mca/rtc/base/base.h"
 #include "src/util/name_fns.h"
 #include "src/threads/threads.h"
 
@@ -150,10 +152,6 @@ static int prte_odls_default_restart_proc(prte_proc_t *child);
  * Explicitly declared functions so that we can get the noreturn
  * attribute registered with the compiler.
  */
-static void send_error_show_help(int fd, int exit_status,
-                                 const char *file, const char *topic, ...)
-    __prte_attribute_noreturn__;
-
 static void do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
     __prte_attribute_noreturn__;
 
@@ -280,8 +278,8 @@ static int write_help_msg(int fd, prte_odls_pipe_err_msg_t *msg, const char *fil
 
 /* Called from the child to send an error message up the pipe to the
    waiting parent. */
-static void send_error_show_help(int fd, int exit_status,
-                                 const char *file, const char *topic, ...)
+void prte_odls_default_send_error_show_help(int fd, int exit_status,
+                                            const char *file, const char *topic, ...)
 {
     va_list ap;
     prte_odls_pipe_err_msg_t msg;
@@ -329,10 +327,10 @@ static void do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
         if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
             if (PRTE_SUCCESS != (i = prte_iof_base_setup_child(&cd->opts, &cd->env))) {
                 PRTE_ERROR_LOG(i);
-                send_error_show_help(write_fd, 1,
-                                     "help-prte-odls-default.txt",
-                                     "iof setup failed",
-                                     prte_process_info.nodename, cd->app->app);
+                prte_odls_default_send_error_show_help(write_fd, 1,
+                                                       "help-prte-odls-default.txt",
+                                                       "iof setup failed",
+                                                       prte_process_info.nodename, cd->app->app);
                 /* Does not return */
             }
         }
@@ -387,13 +385,13 @@ static void do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
     /* take us to the correct wdir */
     if (NULL != cd->wdir) {
         if (0 != chdir(cd->wdir)) {
-            send_error_show_help(write_fd, 1,
-                                 "help-prun.txt",
-                                 "prun:wdir-not-found",
-                                 "prted",
-                                 cd->wdir,
-                                 prte_process_info.nodename,
-                                 (NULL == cd->child) ? 0 : cd->child->app_rank);
+            prte_odls_default_send_error_show_help(write_fd, 1,
+                                                   "help-prun.txt",
+                                                   "prun:wdir-not-found",
+                                                   "prted",
+                                                   cd->wdir,
+                                                   prte_process_info.nodename,
+                                                   (NULL == cd->child) ? 0 : cd->child->app_rank);
             /* Does not return */
         }
     }
@@ -403,13 +401,13 @@ static void do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
         errno = 0;
         i = ptrace(PRTE_TRACEME, 0, 0, 0);
         if  (0 != errno) {
-            send_error_show_help(write_fd, 1,
-                                 "help-prun.txt",
-                                 "prun:stop-on-exec",
-                                 "prted",
-                                 strerror(errno),
-                                 prte_process_info.nodename,
-                                 (NULL == cd->child) ? 0 : cd->child->app_rank);
+            prte_odls_default_send_error_show_help(write_fd, 1,
+                                                   "help-prun.txt",
+                                                   "prun:stop-on-exec",
+                                                   "prted",
+                                                   strerror(errno),
+                                                   prte_process_info.nodename,
+                                                   (NULL == cd->child) ? 0 : cd->child->app_rank);
           }
     }
 #endif
@@ -428,9 +426,9 @@ static void do_child(prte_odls_spawn_caddy_t *cd, int write_fd)
     } else {
         msg = strdup(strerror(errno));
     }
-    send_error_show_help(write_fd, 1,
-                         "help-prte-odls-default.txt", "execve error",
-                         prte_process_info.nodename, dir, cd->app->app, msg);
+    prte_odls_default_send_error_show_help(write_fd, 1,
+                                           "help-prte-odls-default.txt", "execve error",
+                                           prte_process_info.nodename, dir, cd->app->app, msg);
     free(msg);
 }
 
@@ -658,6 +656,121 @@ static int odls_default_fork_local_proc(void *cdptr)
     return do_parent(cd, p[0]);
 }
 
+/* the helper reproduces what the hwloc rtc component does for the
+ * child - binding it to its cpuset, applying the default memory
+ * binding policy, and reporting failures as warnings or errors as
+ * the binding policy directs. Anything beyond that must go through
+ * prte_rtc.set in a directly forked child */
+static bool zygote_can_launch(prte_odls_spawn_caddy_t *cd)
+{
+    prte_rtc_base_selected_module_t *active;
+    hwloc_obj_t root;
+
+    if (NULL == cd->child || NULL == cd->jdata->map ||
+        !prte_odls_default_zygote_active()) {
+        return false;
+    }
+#if PRTE_HAVE_STOP_ON_EXEC
+    if (prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_STOP_ON_EXEC, NULL, PMIX_BOOL)) {
+        return false;
+    }
+#endif
+    if (prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_REPORT_BINDINGS, NULL, PMIX_BOOL)) {
+        return false;
+    }
+    /* a memory binding policy needs the full treatment */
+    if (PRTE_HWLOC_BASE_MAP_NONE != prte_hwloc_base_map) {
+        return false;
+    }
+    /* as does any rtc component other than hwloc */
+    PRTE_LIST_FOREACH(active, &prte_rtc_base.actives, prte_rtc_base_selected_module_t) {
+        if (0 != strcmp(active->component->mca_component_name, "hwloc")) {
+            return false;
+        }
+    }
+    /* a bound daemon without a summary of its topology
+     * gets a warning from rtc */
+    if (NULL != prte_daemon_cores) {
+        root = hwloc_get_root_obj(prte_hwloc_topology);
+        if (NULL == root->userdata) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  Fork/exec the specified process via the pre-forked helper
+ */
+static int odls_default_zygote_fork_local_proc(void *cdptr)
+{
+    prte_odls_spawn_caddy_t *cd = (prte_odls_spawn_caddy_t*)cdptr;
+    prte_proc_t *child = cd->child;
+    hwloc_obj_t root;
+    prte_hwloc_topo_data_t *sum;
+    char *cpuset = NULL;
+    bool membind = false;
+    int p[2], r[2];
+    pid_t pid;
+
+    if (!zygote_can_launch(cd)) {
+        return odls_default_fork_local_proc(cdptr);
+    }
+
+    /* compute the binding here so the helper need not have
+     * any knowledge of the job */
+    if (prte_get_attribute(&child->attributes, PRTE_PROC_CPU_BITMAP, (void**)&cpuset, PMIX_STRING) &&
+        NULL != cpuset && 0 < strlen(cpuset)) {
+        /* rtc only sets the memory policy of procs it binds */
+        membind = true;
+    } else {
+        if (NULL != cpuset) {
+            free(cpuset);
+            cpuset = NULL;
+        }
+        /* if the daemon is bound, then we need to "free" this proc */
+        if (NULL != prte_daemon_cores) {
+            root = hwloc_get_root_obj(prte_hwloc_topology);
+            sum = (prte_hwloc_topo_data_t*)root->userdata;
+            hwloc_bitmap_list_asprintf(&cpuset, sum->available);
+        }
+    }
+
+    if (pipe(p) < 0) {
+        PRTE_ERROR_LOG(PRTE_ERR_SYS_LIMITS_PIPES);
+        child->state = PRTE_PROC_STATE_FAILED_TO_START;
+        child->exit_code = PRTE_ERR_SYS_LIMITS_PIPES;
+        free(cpuset);
+        return PRTE_ERR_SYS_LIMITS_PIPES;
+    }
+    if (pipe(r) < 0) {
+        PRTE_ERROR_LOG(PRTE_ERR_SYS_LIMITS_PIPES);
+        close(p[0]);
+        close(p[1]);
+        child->state = PRTE_PROC_STATE_FAILED_TO_START;
+        child->exit_code = PRTE_ERR_SYS_LIMITS_PIPES;
+        free(cpuset);
+        return PRTE_ERR_SYS_LIMITS_PIPES;
+    }
+
+    pid = prte_odls_default_zygote_spawn(cd, cpuset, membind, p[1], r[0]);
+    free(cpuset);
+    close(p[1]);
+    close(r[0]);
+    if (pid < 0) {
+        /* the helper failed - fall back to forking it ourselves */
+        close(p[0]);
+        close(r[1]);
+        return odls_default_fork_local_proc(cdptr);
+    }
+    child->pid = pid;
+
+    /* let the child proceed now that we can catch its exit */
+    close(r[1]);
+
+    return do_parent(cd, p[0]);
+}
+
 
 /**
  * Launch all processes allocated to the current node.
@@ -677,7 +790,11 @@ int prte_odls_default_launch_local_procs(pmix_data_buffer_t *data)
     }
 
     /* launch the local procs */
-    PRTE_ACTIVATE_LOCAL_LAUNCH(job, odls_default_fork_local_proc);
+    if (prte_odls_default_zygote_active()) {
+        PRTE_ACTIVATE_LOCAL_LAUNCH(job, odls_default_zygote_fork_local_proc);
+    } else {
+        PRTE_ACTIVATE_LOCAL_LAUNCH(job, odls_default_fork_local_proc);
+    }
 
     return PRTE_SUCCESS;
 }
@@ -0,0 +1,669 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Optional pre-forked launch helper ("zygote") for the default ODLS.
+ *
+ * Forking a child directly from a long-running daemon requires the
+ * kernel to copy the page tables of the entire daemon address space,
+ * and the child then takes COW faults on the daemon heap until it
+ * exec's. In a persistent DVM that launches many short jobs, this
+ * cost is paid by every rank.
+ *
+ * When enabled, the daemon forks a small helper process early during
+ * startup - before the daemon heap has grown - and hands it spawn
+ * requests over a unix-domain socket. The request carries the cmd,
+ * argv, env, wdir and cpuset for the child along with the file
+ * descriptors for its IOF pipes and for the usual error-reporting
+ * pipe. The child binds itself and sets its memory policy the way
+ * the hwloc rtc component would, reporting failures up that pipe as
+ * the job's binding policy directs - the daemon only uses the helper
+ * when nothing more than that is required. The helper double-forks
+ * so the new process is reparented to the daemon (which marks itself
+ * as a child subreaper), and hence the daemon's normal waitpid
+ * handling continues to work.
+ *
+ * The grandchild blocks on a "release" pipe until the daemon has
+ * recorded its pid, so a child that exits immediately cannot be
+ * reaped before the daemon knows about it.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include <string.h>
+#include <stdlib.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <errno.h>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+#ifdef HAVE_SYS_PARAM_H
+#include <sys/param.h>
+#endif
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
+#ifdef HAVE_SYS_PRCTL_H
+#include <sys/prctl.h>
+#endif
+#include <signal.h>
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#include "src/hwloc/hwloc-internal.h"
+#include "src/threads/mutex.h"
+#include "src/util/argv.h"
+#include "src/util/error.h"
+#include "src/util/fd.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+#include "src/util/show_help.h"
+#include "src/util/name_fns.h"
+#include "src/runtime/prte_globals.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/iof/base/base.h"
+#include "src/mca/iof/base/iof_base_setup.h"
+#include "src/mca/rmaps/rmaps_types.h"
+#include "src/mca/rtc/base/base.h"
+
+#include "src/mca/odls/base/base.h"
+#include "src/mca/odls/base/odls_private.h"
+#include "src/mca/odls/default/odls_default.h"
+
+#define PRTE_ODLS_ZYGOTE_FORWARD_OUTPUT  0x01
+#define PRTE_ODLS_ZYGOTE_USEPTY          0x02
+#define PRTE_ODLS_ZYGOTE_STDIN           0x04
+#define PRTE_ODLS_ZYGOTE_STDERR          0x08
+#define PRTE_ODLS_ZYGOTE_BIND_REQUIRED   0x10
+#define PRTE_ODLS_ZYGOTE_BIND_GIVEN      0x20
+#define PRTE_ODLS_ZYGOTE_MEMBIND         0x40
+#define PRTE_ODLS_ZYGOTE_MEMBIND_ERROR   0x80
+
+#define PRTE_ODLS_ZYGOTE_MAX_FDS    5
+
+/* fixed-size portion of a spawn request - this travels
+ * with the file descriptors in a single sendmsg */
+typedef struct {
+    int32_t nfds;
+    int32_t flags;
+    int32_t app_rank;
+} prte_odls_zygote_hdr_t;
+
+/* a spawn request as seen by the helper */
+typedef struct {
+    int flags;
+    int32_t app_rank;
+    int errfd;
+    int relfd;
+    int outfd;
+    int errout;
+    int infd;
+    char *cmd;
+    char *wdir;
+    char *app;
+    char *cpuset;
+    char **argv;
+    char **env;
+} prte_odls_zygote_req_t;
+
+static int zygote_sd = -1;
+static pid_t zygote_pid = -1;
+static prte_mutex_t zygote_lock;
+
+static void zygote_main(int sd) __prte_attribute_noreturn__;
+static void zygote_child(prte_odls_zygote_req_t *req) __prte_attribute_noreturn__;
+
+/*
+ * Wire helpers - strings are sent as a 32-bit length (-1 for NULL)
+ * followed by the bytes, and argv arrays as a count followed by
+ * that many strings.
+ */
+static int send_string(int sd, const char *str)
+{
+    int32_t len;
+    int rc;
+
+    len = (NULL == str) ? -1 : (int32_t)strlen(str);
+    if (PRTE_SUCCESS != (rc = prte_fd_write(sd, sizeof(len), &len))) {
+        return rc;
+    }
+    if (0 < len) {
+        rc = prte_fd_write(sd, len, str);
+    }
+    return rc;
+}
+
+static int recv_string(int sd, char **str)
+{
+    int32_t len;
+    int rc;
+
+    *str = NULL;
+    if (PRTE_SUCCESS != (rc = prte_fd_read(sd, sizeof(len), &len))) {
+        return rc;
+    }
+    if (0 > len) {
+        return PRTE_SUCCESS;
+    }
+    *str = (char*)malloc(len + 1);
+    if (NULL == *str) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    if (0 < len && PRTE_SUCCESS != (rc = prte_fd_read(sd, len, *str))) {
+        free(*str);
+        *str = NULL;
+        return rc;
+    }
+    (*str)[len] = '\0';
+    return PRTE_SUCCESS;
+}
+
+static int send_argv(int sd, char **argv)
+{
+    int32_t cnt;
+    int rc, i;
+
+    cnt = prte_argv_count(argv);
+    if (PRTE_SUCCESS != (rc = prte_fd_write(sd, sizeof(cnt), &cnt))) {
+        return rc;
+    }
+    for (i=0; i < cnt; i++) {
+        if (PRTE_SUCCESS != (rc = send_string(sd, argv[i]))) {
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+static int recv_argv(int sd, char ***argv)
+{
+    int32_t cnt, i;
+    int rc;
+
+    *argv = NULL;
+    if (PRTE_SUCCESS != (rc = prte_fd_read(sd, sizeof(cnt), &cnt))) {
+        return rc;
+    }
+    if (0 > cnt) {
+        return PRTE_ERR_BAD_PARAM;
+    }
+    *argv = (char**)calloc(cnt + 1, sizeof(char*));
+    if (NULL == *argv) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (i=0; i < cnt; i++) {
+        if (PRTE_SUCCESS != (rc = recv_string(sd, &(*argv)[i]))) {
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+static int send_request(int sd, prte_odls_zygote_hdr_t *hdr, int *fds)
+{
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    char ctrl[CMSG_SPACE(sizeof(int) * PRTE_ODLS_ZYGOTE_MAX_FDS)];
+    ssize_t rc;
+
+    memset(&msg, 0, sizeof(msg));
+    memset(ctrl, 0, sizeof(ctrl));
+    iov.iov_base = hdr;
+    iov.iov_len = sizeof(*hdr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * hdr->nfds);
+    cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * hdr->nfds);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * hdr->nfds);
+
+    do {
+        rc = sendmsg(sd, &msg, 0);
+    } while (rc < 0 && EINTR == errno);
+    if (rc != (ssize_t)sizeof(*hdr)) {
+        return PRTE_ERR_COMM_FAILURE;
+    }
+    return PRTE_SUCCESS;
+}
+
+static int recv_request(int sd, prte_odls_zygote_hdr_t *hdr, int *fds)
+{
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    char ctrl[CMSG_SPACE(sizeof(int) * PRTE_ODLS_ZYGOTE_MAX_FDS)];
+    ssize_t rc;
+
+    memset(&msg, 0, sizeof(msg));
+    iov.iov_base = hdr;
+    iov.iov_len = sizeof(*hdr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = sizeof(ctrl);
+
+    do {
+        rc = recvmsg(sd, &msg, 0);
+    } while (rc < 0 && EINTR == errno);
+    if (0 == rc) {
+        /* the daemon went away */
+        return PRTE_ERR_TIMEOUT;
+    }
+    if (rc != (ssize_t)sizeof(*hdr) ||
+        PRTE_ODLS_ZYGOTE_MAX_FDS < hdr->nfds || 0 > hdr->nfds) {
+        return PRTE_ERR_COMM_FAILURE;
+    }
+    cmsg = CMSG_FIRSTHDR(&msg);
+    if (NULL == cmsg || SOL_SOCKET != cmsg->cmsg_level ||
+        SCM_RIGHTS != cmsg->cmsg_type ||
+        CMSG_LEN(sizeof(int) * hdr->nfds) != cmsg->cmsg_len) {
+        return PRTE_ERR_COMM_FAILURE;
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * hdr->nfds);
+    return PRTE_SUCCESS;
+}
+
+static void set_handler_default(int sig)
+{
+    struct sigaction act;
+
+    act.sa_handler = SIG_DFL;
+    act.sa_flags = 0;
+    sigemptyset(&act.sa_mask);
+
+    sigaction(sig, &act, (struct sigaction *)0);
+}
+
+int prte_odls_default_zygote_start(void)
+{
+    int sv[2];
+    pid_t pid;
+
+    if (0 <= zygote_sd) {
+        return PRTE_SUCCESS;
+    }
+
+#if defined(HAVE_SYS_PRCTL_H) && defined(PR_SET_CHILD_SUBREAPER)
+    /* we must become the reaper for the grandchildren of the
+     * helper, or else we cannot waitpid on them */
+    if (0 != prctl(PR_SET_CHILD_SUBREAPER, 1, 0, 0, 0)) {
+        prte_output_verbose(2, prte_odls_base_framework.framework_output,
+                            "%s odls:default:zygote cannot become subreaper: %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), strerror(errno));
+        return PRTE_ERR_NOT_SUPPORTED;
+    }
+#else
+    return PRTE_ERR_NOT_SUPPORTED;
+#endif
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        PRTE_ERROR_LOG(PRTE_ERR_SYS_LIMITS_SOCKETS);
+        return PRTE_ERR_SYS_LIMITS_SOCKETS;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+        close(sv[0]);
+        close(sv[1]);
+        PRTE_ERROR_LOG(PRTE_ERR_SYS_LIMITS_CHILDREN);
+        return PRTE_ERR_SYS_LIMITS_CHILDREN;
+    }
+    if (0 == pid) {
+        close(sv[0]);
+        zygote_main(sv[1]);
+        /* does not return */
+    }
+
+    close(sv[1]);
+    prte_fd_set_cloexec(sv[0]);
+    zygote_sd = sv[0];
+    zygote_pid = pid;
+    PRTE_CONSTRUCT(&zygote_lock, prte_mutex_t);
+
+    prte_output_verbose(2, prte_odls_base_framework.framework_output,
+                        "%s odls:default:zygote started as pid %ld",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (long)pid);
+    return PRTE_SUCCESS;
+}
+
+void prte_odls_default_zygote_stop(void)
+{
+    int status;
+
+    if (0 > zygote_sd) {
+        return;
+    }
+    /* closing the socket tells the helper to exit */
+    close(zygote_sd);
+    zygote_sd = -1;
+    while (0 > waitpid(zygote_pid, &status, 0) && EINTR == errno);
+    zygote_pid = -1;
+    PRTE_DESTRUCT(&zygote_lock);
+}
+
+bool prte_odls_default_zygote_active(void)
+{
+    return (0 <= zygote_sd);
+}
+
+pid_t prte_odls_default_zygote_spawn(prte_odls_spawn_caddy_t *cd,
+                                     const char *cpuset, bool membind,
+                                     int errfd, int relfd)
+{
+    prte_odls_zygote_hdr_t hdr;
+    int fds[PRTE_ODLS_ZYGOTE_MAX_FDS];
+    pid_t pid = -1;
+    int rc;
+
+    hdr.flags = 0;
+    hdr.app_rank = cd->child->app_rank;
+    hdr.nfds = 0;
+    fds[hdr.nfds++] = errfd;
+    fds[hdr.nfds++] = relfd;
+    if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
+        hdr.flags |= PRTE_ODLS_ZYGOTE_FORWARD_OUTPUT;
+        if (cd->opts.usepty) {
+            hdr.flags |= PRTE_ODLS_ZYGOTE_USEPTY;
+        }
+        fds[hdr.nfds++] = cd->opts.p_stdout[1];
+        if (!prte_iof_base.redirect_app_stderr_to_stdout) {
+            hdr.flags |= PRTE_ODLS_ZYGOTE_STDERR;
+            fds[hdr.nfds++] = cd->opts.p_stderr[1];
+        }
+        if (cd->opts.connect_stdin) {
+            hdr.flags |= PRTE_ODLS_ZYGOTE_STDIN;
+            fds[hdr.nfds++] = cd->opts.p_stdin[0];
+        }
+    }
+    if (PRTE_BINDING_REQUIRED(cd->jdata->map->binding)) {
+        hdr.flags |= PRTE_ODLS_ZYGOTE_BIND_REQUIRED;
+    }
+    if (PRTE_BINDING_POLICY_IS_SET(cd->jdata->map->binding)) {
+        hdr.flags |= PRTE_ODLS_ZYGOTE_BIND_GIVEN;
+    }
+    if (membind) {
+        hdr.flags |= PRTE_ODLS_ZYGOTE_MEMBIND;
+        if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
+            hdr.flags |= PRTE_ODLS_ZYGOTE_MEMBIND_ERROR;
+        }
+    }
+
+    /* the launch threads share the helper, so only one
+     * request can be in flight at a time */
+    prte_mutex_lock(&zygote_lock);
+    if (0 > zygote_sd) {
+        prte_mutex_unlock(&zygote_lock);
+        return -1;
+    }
+    if (PRTE_SUCCESS != (rc = send_request(zygote_sd, &hdr, fds)) ||
+        PRTE_SUCCESS != (rc = send_string(zygote_sd, cd->cmd)) ||
+        PRTE_SUCCESS != (rc = send_string(zygote_sd, cd->wdir)) ||
+        PRTE_SUCCESS != (rc = send_string(zygote_sd, cd->app->app)) ||
+        PRTE_SUCCESS != (rc = send_string(zygote_sd, cpuset)) ||
+        PRTE_SUCCESS != (rc = send_argv(zygote_sd, cd->argv)) ||
+        PRTE_SUCCESS != (rc = send_argv(zygote_sd, cd->env)) ||
+        PRTE_SUCCESS != (rc = prte_fd_read(zygote_sd, sizeof(pid), &pid))) {
+        /* the helper is no longer usable - shut it down so
+         * we fall back to forking directly */
+        PRTE_ERROR_LOG(rc);
+        close(zygote_sd);
+        zygote_sd = -1;
+        pid = -1;
+    }
+    prte_mutex_unlock(&zygote_lock);
+
+    return pid;
+}
+
+static void zygote_main(int sd)
+{
+    prte_odls_zygote_hdr_t hdr;
+    prte_odls_zygote_req_t req;
+    int fds[PRTE_ODLS_ZYGOTE_MAX_FDS];
+    pid_t pid, cpid;
+    int i, n, status;
+
+    /* we don't want any of the daemon's handlers */
+    set_handler_default(SIGTERM);
+    set_handler_default(SIGINT);
+    set_handler_default(SIGHUP);
+    set_handler_default(SIGPIPE);
+    set_handler_default(SIGCHLD);
+
+    /* only keep stdin/out/err and our socket */
+    prte_close_open_file_descriptors(sd);
+
+    while (1) {
+        memset(&req, 0, sizeof(req));
+        if (PRTE_SUCCESS != recv_request(sd, &hdr, fds)) {
+            break;
+        }
+        req.flags = hdr.flags;
+        req.app_rank = hdr.app_rank;
+        req.outfd = -1;
+        req.errout = -1;
+        req.infd = -1;
+        n = 0;
+        req.errfd = fds[n++];
+        req.relfd = fds[n++];
+        if (PRTE_ODLS_ZYGOTE_FORWARD_OUTPUT & req.flags) {
+            req.outfd = fds[n++];
+            if (PRTE_ODLS_ZYGOTE_STDERR & req.flags) {
+                req.errout = fds[n++];
+            }
+            if (PRTE_ODLS_ZYGOTE_STDIN & req.flags) {
+                req.infd = fds[n++];
+            }
+        }
+        if (PRTE_SUCCESS != recv_string(sd, &req.cmd) ||
+            PRTE_SUCCESS != recv_string(sd, &req.wdir) ||
+            PRTE_SUCCESS != recv_string(sd, &req.app) ||
+            PRTE_SUCCESS != recv_string(sd, &req.cpuset) ||
+            PRTE_SUCCESS != recv_argv(sd, &req.argv) ||
+            PRTE_SUCCESS != recv_argv(sd, &req.env)) {
+            break;
+        }
+
+        /* fork an intermediate that forks the actual child and
+         * then exits, thereby orphaning the child to the daemon */
+        cpid = -1;
+        pid = fork();
+        if (0 == pid) {
+            cpid = fork();
+            if (0 == cpid) {
+                close(sd);
+                zygote_child(&req);
+                /* does not return */
+            }
+            prte_fd_write(sd, sizeof(cpid), &cpid);
+            _exit(0);
+        }
+        if (pid < 0) {
+            prte_fd_write(sd, sizeof(cpid), &cpid);
+        } else {
+            while (0 > waitpid(pid, &status, 0) && EINTR == errno);
+        }
+
+        for (i=0; i < hdr.nfds; i++) {
+            close(fds[i]);
+        }
+        free(req.cmd);
+        free(req.wdir);
+        free(req.app);
+        free(req.cpuset);
+        prte_argv_free(req.argv);
+        prte_argv_free(req.env);
+    }
+
+    _exit(0);
+}
+
+/* report a binding failure the way the hwloc rtc component does -
+ * an error if binding is required, otherwise a warning */
+static void zygote_bind_failed(prte_odls_zygote_req_t *req, bool required,
+                               const char *error, const char *warning, char *msg)
+{
+    if (required) {
+        prte_rtc_base_send_error_show_help(req->errfd, 1, "help-prte-odls-default.txt",
+                                           error, prte_process_info.nodename, req->app,
+                                           msg, __FILE__, __LINE__);
+        /* Does not return */
+    }
+    prte_rtc_base_send_warn_show_help(req->errfd, "help-prte-odls-default.txt",
+                                      warning, prte_process_info.nodename, req->app,
+                                      msg, __FILE__, __LINE__);
+}
+
+static void zygote_bind(prte_odls_zygote_req_t *req)
+{
+    hwloc_cpuset_t cpuset;
+    char *msg = NULL;
+    int rc;
+
+    cpuset = hwloc_bitmap_alloc();
+    if (0 != (rc = hwloc_bitmap_list_sscanf(cpuset, req->cpuset))) {
+        prte_asprintf(&msg, "hwloc_bitmap_sscanf returned \"%s\" for the string \"%s\"",
+                      prte_strerror(rc), req->cpuset);
+        zygote_bind_failed(req, (PRTE_ODLS_ZYGOTE_BIND_REQUIRED & req->flags) &&
+                                (PRTE_ODLS_ZYGOTE_BIND_GIVEN & req->flags),
+                           "binding generic error", "not bound",
+                           (NULL == msg) ? "failed to convert bitmap list to hwloc bitmap" : msg);
+        goto done;
+    }
+    rc = hwloc_set_cpubind(prte_hwloc_topology, cpuset, 0);
+    /* only report errors if the binding policy wasn't a default */
+    if (rc < 0 && (PRTE_ODLS_ZYGOTE_BIND_GIVEN & req->flags)) {
+        if (ENOSYS == errno) {
+            msg = strdup("hwloc indicates cpu binding not supported");
+        } else if (EXDEV == errno) {
+            msg = strdup("hwloc indicates cpu binding cannot be enforced");
+        } else {
+            prte_asprintf(&msg, "hwloc_set_cpubind returned \"%s\" for bitmap \"%s\"",
+                          prte_strerror(rc), req->cpuset);
+        }
+        zygote_bind_failed(req, PRTE_ODLS_ZYGOTE_BIND_REQUIRED & req->flags,
+                           "binding generic error", "not bound", msg);
+        goto done;
+    }
+    if (!(PRTE_ODLS_ZYGOTE_MEMBIND & req->flags)) {
+        goto done;
+    }
+    /* set the memory affinity policy */
+    rc = prte_hwloc_base_set_process_membind_policy();
+    if (PRTE_SUCCESS != rc && (PRTE_ODLS_ZYGOTE_BIND_GIVEN & req->flags)) {
+        if (ENOSYS == errno) {
+            msg = strdup("hwloc indicates memory binding not supported");
+        } else if (EXDEV == errno) {
+            msg = strdup("hwloc indicates memory binding cannot be enforced");
+        } else {
+            msg = strdup("failed to bind memory");
+        }
+        zygote_bind_failed(req, PRTE_ODLS_ZYGOTE_MEMBIND_ERROR & req->flags,
+                           "memory binding error", "memory not bound", msg);
+    }
+
+  done:
+    hwloc_bitmap_free(cpuset);
+    if (NULL != msg) {
+        free(msg);
+    }
+}
+
+static void zygote_child(prte_odls_zygote_req_t *req)
+{
+    prte_iof_base_io_conf_t opts;
+    sigset_t sigs;
+    char dir[MAXPATHLEN], *msg, c;
+    int rc;
+
+#if HAVE_SETPGID
+    setpgid(0, 0);
+#endif
+
+    /* wait for the daemon to record our pid */
+    while (0 > read(req->relfd, &c, 1) && EINTR == errno);
+    close(req->relfd);
+
+    prte_fd_set_cloexec(req->errfd);
+
+    if (PRTE_ODLS_ZYGOTE_FORWARD_OUTPUT & req->flags) {
+        memset(&opts, 0, sizeof(opts));
+        opts.usepty = (PRTE_ODLS_ZYGOTE_USEPTY & req->flags) ? 1 : 0;
+        opts.connect_stdin = (PRTE_ODLS_ZYGOTE_STDIN & req->flags) ? true : false;
+        /* the daemon retained the parent ends */
+        opts.p_stdin[0] = req->infd;
+        opts.p_stdin[1] = -1;
+        opts.p_stdout[0] = -1;
+        opts.p_stdout[1] = req->outfd;
+        opts.p_stderr[0] = -1;
+        opts.p_stderr[1] = req->errout;
+        prte_iof_base.redirect_app_stderr_to_stdout = !(PRTE_ODLS_ZYGOTE_STDERR & req->flags);
+        if (PRTE_SUCCESS != (rc = prte_iof_base_setup_child(&opts, &req->env))) {
+            prte_odls_default_send_error_show_help(req->errfd, 1,
+                                                   "help-prte-odls-default.txt",
+                                                   "iof setup failed",
+                                                   prte_process_info.nodename, req->app);
+            /* Does not return */
+        }
+    }
+
+    /* apply the binding the daemon computed for us */
+    if (NULL != req->cpuset && NULL != prte_hwloc_topology) {
+        zygote_bind(req);
+    }
+
+    prte_close_open_file_descriptors(req->errfd);
+
+    set_handler_default(SIGTERM);
+    set_handler_default(SIGINT);
+    set_handler_default(SIGHUP);
+    set_handler_default(SIGPIPE);
+    set_handler_default(SIGCHLD);
+    set_handler_default(SIGTRAP);
+
+    sigprocmask(0, 0, &sigs);
+    sigprocmask(SIG_UNBLOCK, &sigs, 0);
+
+    if (NULL != req->wdir) {
+        if (0 != chdir(req->wdir)) {
+            prte_odls_default_send_error_show_help(req->errfd, 1,
+                                                   "help-prun.txt",
+                                                   "prun:wdir-not-found",
+                                                   "prted",
+                                                   req->wdir,
+                                                   prte_process_info.nodename,
+                                                   (unsigned long)req->app_rank);
+            /* Does not return */
+        }
+    }
+
+    execve(req->cmd, req->argv, req->env);
+    /* If we get here, an error has occurred. */
+    (void) getcwd(dir, sizeof(dir));
+    msg = strdup(strerror(errno));
+    prte_odls_default_send_error_show_help(req->errfd, 1,
+                                           "help-prte-odls-default.txt", "execve error",
+                                           prte_process_info.nodename, dir, req->app, msg);
+    /* Does not return */
+}
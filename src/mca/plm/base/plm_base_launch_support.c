@@ -82,30 +82,30 @@
 
 void prte_plm_base_set_slots(prte_node_t *node)
 {
+    unsigned int count;
+
+    /* the object counts travel with the topology, so we
+     * don't need to import it just to set the slots */
     if (0 == strncmp(prte_set_slots, "cores", strlen(prte_set_slots))) {
-        if (NULL != node->topology && NULL != node->topology->topo) {
-            node->slots = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo,
-                                                             HWLOC_OBJ_CORE, 0);
+        if (prte_topology_get_count(node->topology, PRTE_HWLOC_COUNT_CORE, &count)) {
+            node->slots = count;
         }
     } else if (0 == strncmp(prte_set_slots, "sockets", strlen(prte_set_slots))) {
-        if (NULL != node->topology && NULL != node->topology->topo) {
-            if (0 == (node->slots = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo,
-                                                                       HWLOC_OBJ_SOCKET, 0))) {
+        if (prte_topology_get_count(node->topology, PRTE_HWLOC_COUNT_PACKAGE, &count)) {
+            if (0 == (node->slots = count)) {
                 /* some systems don't report sockets - in this case,
                  * use numanodes */
-                node->slots = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo,
-                                                                 HWLOC_OBJ_NODE, 0);
+                prte_topology_get_count(node->topology, PRTE_HWLOC_COUNT_NUMA, &count);
+                node->slots = count;
             }
         }
     } else if (0 == strncmp(prte_set_slots, "numas", strlen(prte_set_slots))) {
-        if (NULL != node->topology && NULL != node->topology->topo) {
-            node->slots = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo,
-                                                             HWLOC_OBJ_NODE, 0);
+        if (prte_topology_get_count(node->topology, PRTE_HWLOC_COUNT_NUMA, &count)) {
+            node->slots = count;
         }
     } else if (0 == strncmp(prte_set_slots, "hwthreads", strlen(prte_set_slots))) {
-        if (NULL != node->topology && NULL != node->topology->topo) {
-            node->slots = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo,
-                                                             HWLOC_OBJ_PU, 0L);
+        if (prte_topology_get_count(node->topology, PRTE_HWLOC_COUNT_PU, &count)) {
+            node->slots = count;
         }
     } else {
         /* must be a number */
@@ -1045,20 +1045,14 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t* sender,
                                    pmix_data_buffer_t *buffer,
                                    prte_rml_tag_t tag, void *cbdata)
 {
-    hwloc_topology_t topo;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *sum;
     int rc, idx;
     char *sig, *coprocessors, **sns;
     prte_proc_t *daemon=NULL;
-    prte_topology_t *t, *t2;
+    prte_topology_t *t;
     int i;
     uint32_t h;
     prte_job_t *jdata;
-    uint8_t flag;
-    pmix_data_buffer_t datbuf, *data;
-    pmix_byte_object_t bo, pbo;
-    pmix_topology_t ptopo;
+    pmix_data_buffer_t *data = buffer;
 
     PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
                          "%s plm:base:daemon_topology recvd for daemon %s",
@@ -1074,42 +1068,6 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t* sender,
         prted_failed_launch = true;
         goto CLEANUP;
     }
-    PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
-    /* unpack the flag to see if this payload is compressed */
-    idx=1;
-    rc = PMIx_Data_unpack(NULL, buffer, &flag, &idx, PMIX_BOOL);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        prted_failed_launch = true;
-        goto CLEANUP;
-    }
-    /* unpack the data */
-    idx = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &pbo, &idx, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        prted_failed_launch = true;
-        goto CLEANUP;
-    }
-    /* if compressed, decompress it */
-    if (flag) {
-        /* decompress the data */
-        if (PMIx_Data_decompress((uint8_t**)&bo.bytes, &bo.size,
-                                 (uint8_t*)pbo.bytes, pbo.size)) {
-            /* the data has been uncompressed */
-            rc = PMIx_Data_load(&datbuf, &bo);
-            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
-        } else {
-            PMIX_ERROR_LOG(PMIX_ERROR);
-            prted_failed_launch = true;
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            goto CLEANUP;
-        }
-    } else {
-        rc = PMIx_Data_load(&datbuf, &pbo);
-    }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-    data = &datbuf;
 
     /* unpack the topology signature for this node */
     idx=1;
@@ -1120,17 +1078,8 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t* sender,
         goto CLEANUP;
     }
     /* find it in the array */
-    t = NULL;
-    for (i=0; i < prte_node_topologies->size; i++) {
-        if (NULL == (t2 = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, i))) {
-            continue;
-        }
-        /* just check the signature */
-        if (0 == strcmp(sig, t2->sig)) {
-            t = t2;
-            break;
-        }
-    }
+    t = prte_get_topology_object(sig);
+    free(sig);
     if (NULL == t) {
         /* should never happen */
         PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
@@ -1138,27 +1087,16 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t* sender,
         goto CLEANUP;
     }
 
-    /* unpack the topology */
-    idx=1;
-    rc = PMIx_Data_unpack(NULL, data, &ptopo, &idx, PMIX_TOPO);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    /* unpack the topology - we only retain the compressed form and
+     * its object counts here. The topology itself is imported the
+     * first time a mapper needs it */
+    if (PRTE_SUCCESS != (rc = prte_topology_unpack(data, t))) {
+        PRTE_ERROR_LOG(rc);
         prted_failed_launch = true;
         goto CLEANUP;
     }
-    topo = ptopo.topology;
-    ptopo.topology = NULL;
-    PMIX_TOPOLOGY_DESTRUCT(&ptopo);
-    /* Apply any CPU filters (not preserved by the XML) */
-    prte_hwloc_base_filter_cpus(topo);
-    /* record the final topology */
-    t->topo = topo;
-    /* setup the summary data for this topology as we will need
-     * it when we go to map/bind procs to it */
-    root = hwloc_get_root_obj(topo);
-    root->userdata = (void*)PRTE_NEW(prte_hwloc_topo_data_t);
-    sum = (prte_hwloc_topo_data_t*)root->userdata;
-    sum->available = prte_hwloc_base_setup_summary(topo);
+    /* and keep it for next time */
+    prte_hwloc_base_topo_cache_store(t);
 
     /* unpack any coprocessors */
     idx=1;
@@ -1271,25 +1209,18 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
     pmix_proc_t dname;
     pmix_data_buffer_t *relay;
     char *sig;
-    prte_topology_t *t, *mytopo;
-    hwloc_topology_t topo;
+    prte_topology_t *t, *mytopo, *rtopo = NULL;
     int i;
-    bool found;
     prte_daemon_cmd_flag_t cmd;
     char *myendian;
     char *alias, **atmp;
     uint8_t naliases, ni;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *sum;
     char *nodename = NULL;
     pmix_info_t *info;
     size_t n, ninfo;
-    pmix_byte_object_t pbo, bo;
+    pmix_byte_object_t pbo;
     pmix_data_buffer_t pbuf;
     int32_t flag;
-    bool compressed;
-    pmix_data_buffer_t datbuf, *data;
-    pmix_topology_t ptopo;
 
     /* get the daemon job, if necessary */
     if (NULL == jdatorted) {
@@ -1472,80 +1403,20 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
         }
 
         /* rank=1 always sends its topology back */
-        topo = NULL;
+        rtopo = NULL;
         if (1 == dname.rank) {
-            PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
-            /* unpack the flag to see if this payload is compressed */
-            idx=1;
-            ret = PMIx_Data_unpack(NULL, buffer, &compressed, &idx, PMIX_BOOL);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
+            /* only retain the compressed form - it is imported
+             * if and when a mapper needs it */
+            rtopo = PRTE_NEW(prte_topology_t);
+            ret = prte_topology_unpack(buffer, rtopo);
+            if (PRTE_SUCCESS != ret) {
+                PRTE_ERROR_LOG(ret);
                 prted_failed_launch = true;
                 goto CLEANUP;
             }
-            /* unpack the data */
-            idx=1;
-            ret = PMIx_Data_unpack(NULL, buffer, &pbo, &idx, PMIX_BYTE_OBJECT);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-                prted_failed_launch = true;
-                goto CLEANUP;
-            }
-            /* only need to process it if our signatures differ */
+            /* only need to keep it if our signatures differ */
             if (0 == strcmp(sig, mytopo->sig)) {
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            } else {
-                if (compressed) {
-                    /* decompress the data */
-                    if (PMIx_Data_decompress((uint8_t**)&bo.bytes, &bo.size,
-                                             (uint8_t*)pbo.bytes, pbo.size)) {
-                        /* the data has been uncompressed */
-                        ret = PMIx_Data_load(&datbuf, &bo);
-                        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
-                        if (PMIX_SUCCESS != ret) {
-                            PMIX_ERROR_LOG(ret);
-                            prted_failed_launch = true;
-                            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                            goto CLEANUP;
-                        }
-                    } else {
-                        PMIX_ERROR_LOG(PMIX_ERROR);
-                        prted_failed_launch = true;
-                        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
-                        goto CLEANUP;
-                    }
-                } else {
-                    ret = PMIx_Data_load(&datbuf, &pbo);
-                    if (PMIX_SUCCESS != ret) {
-                        PMIX_ERROR_LOG(ret);
-                        prted_failed_launch = true;
-                        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                        goto CLEANUP;
-                    }
-                }
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                data = &datbuf;
-
-                 /* unpack the available topology information */
-                idx=1;
-                ret = PMIx_Data_unpack(NULL, data, &ptopo, &idx, PMIX_TOPO);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    prted_failed_launch = true;
-                    goto CLEANUP;
-                }
-                topo = ptopo.topology;
-                ptopo.topology = NULL;
-                PMIX_TOPOLOGY_DESTRUCT(&ptopo);
-                /* setup the summary data for this topology as we will need
-                 * it when we go to map/bind procs to it */
-                root = hwloc_get_root_obj(topo);
-                root->userdata = (void*)PRTE_NEW(prte_hwloc_topo_data_t);
-                sum = (prte_hwloc_topo_data_t*)root->userdata;
-                sum->available = prte_hwloc_base_setup_summary(topo);
-                /* cleanup */
-                PMIX_DATA_BUFFER_DESTRUCT(data);
+                PRTE_RELEASE(rtopo);
             }
         }
 
@@ -1609,39 +1480,41 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
         }
 
         /* do we already have this topology from some other node? */
-        found = false;
-        for (i=0; i < prte_node_topologies->size; i++) {
-            if (NULL == (t = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, i))) {
-                continue;
-            }
-            /* just check the signature */
-            if (0 == strcmp(sig, t->sig)) {
-                PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                                     "%s TOPOLOGY ALREADY RECORDED",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-                found = true;
-                daemon->node->topology = t;
-                if (NULL != topo) {
-                    hwloc_topology_destroy(topo);
-                }
-                free(sig);
-                break;
+        if (NULL != (t = prte_get_topology_object(sig))) {
+            PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                                 "%s TOPOLOGY ALREADY RECORDED",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+            daemon->node->topology = t;
+            if (NULL != rtopo) {
+                PRTE_RELEASE(rtopo);
             }
-        }
-
-        if (!found) {
+            free(sig);
+        } else if (NULL != rtopo) {
+            PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                                 "%s NEW TOPOLOGY - ADDING",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+            t = rtopo;
+            rtopo = NULL;
+            t->sig = sig;
+            prte_set_topology_object(t);
+            daemon->node->topology = t;
+            /* keep it for next time */
+            prte_hwloc_base_topo_cache_store(t);
+        } else {
             /* nope - save the signature and request the complete topology from that node */
             PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
                                  "%s NEW TOPOLOGY - ADDING",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
             t = PRTE_NEW(prte_topology_t);
             t->sig = sig;
-            t->index = prte_pointer_array_add(prte_node_topologies, t);
+            prte_set_topology_object(t);
             daemon->node->topology = t;
-            if (NULL != topo) {
-                /* Apply any CPU filters (not preserved by the XML) */
-                prte_hwloc_base_filter_cpus(topo);
-                t->topo = topo;
+            /* we may have seen it on a prior startup */
+            if (PRTE_SUCCESS == prte_hwloc_base_topo_cache_load(t)) {
+                PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                                     "%s TOPOLOGY FOR %s FOUND IN CACHE",
+                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                     PRTE_NAME_PRINT(&dname)));
             } else {
                 PRTE_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
                                      "%s REQUESTING TOPOLOGY FROM %s",
@@ -1684,6 +1557,9 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t* sender,
             free(nodename);
             nodename = NULL;
         }
+        if (NULL != rtopo) {
+            PRTE_RELEASE(rtopo);
+        }
 
         if (prted_failed_launch) {
             PRTE_ACTIVATE_JOB_STATE(jdatorted, PRTE_JOB_STATE_FAILED_TO_START);
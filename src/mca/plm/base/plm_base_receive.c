@@ -55,6 +55,7 @@
 #include "src/mca/ras/base/base.h"
 #include "src/util/name_fns.h"
 #include "src/mca/state/state.h"
+#include "src/mca/state/base/base.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/prte_quit.h"
@@ -132,6 +133,7 @@ void prte_plm_base_recv(int status, pmix_proc_t* sender,
     int32_t count;
     pmix_nspace_t job;
     prte_job_t *jdata, *parent, jb;
+    prte_state_batch_t *batch = NULL;
     pmix_data_buffer_t *answer;
     pmix_rank_t vpid;
     prte_proc_t *proc;
@@ -406,6 +408,11 @@ void prte_plm_base_recv(int status, pmix_proc_t* sender,
             running = false;
             /* get the job object */
             jdata = prte_get_job_data_object(job);
+            if (NULL != jdata) {
+                /* all procs reported in this message are
+                 * processed by the state machine as one event */
+                batch = prte_state_base_batch_create(jdata);
+            }
             count = 1;
             while (PMIX_SUCCESS == (rc = PMIx_Data_unpack(NULL, buffer, &vpid, &count, PMIX_PROC_RANK))) {
                 if (PMIX_RANK_INVALID == vpid) {
@@ -455,9 +462,17 @@ void prte_plm_base_recv(int status, pmix_proc_t* sender,
                      * state against the prior proc state */
                     proc->pid = pid;
                     proc->exit_code = exit_code;
-                    PRTE_ACTIVATE_PROC_STATE(&name, state);
+                    if (PRTE_SUCCESS != (ret = prte_state_base_batch_add(batch, vpid, state))) {
+                        /* don't lose the transition - activate it on its own */
+                        PRTE_ERROR_LOG(ret);
+                        PRTE_ACTIVATE_PROC_STATE(&proc->name, state);
+                    }
                 }
             }
+            if (NULL != batch) {
+                prte_state_base_activate_proc_states(batch);
+                batch = NULL;
+            }
             /* record that we heard back from a daemon during app launch */
             if (running && NULL != jdata) {
                 jdata->num_daemons_reported++;
@@ -511,12 +526,19 @@ void prte_plm_base_recv(int status, pmix_proc_t* sender,
             rc = PRTE_ERR_NOT_FOUND;
             goto CLEANUP;
         }
+        batch = prte_state_base_batch_create(jdata);
         count=1;
         while (PRTE_SUCCESS == PMIx_Data_unpack(NULL, buffer, &vpid, &count, PMIX_PROC_RANK)) {
-            name.rank = vpid;
-            PRTE_ACTIVATE_PROC_STATE(&name, PRTE_PROC_STATE_REGISTERED);
+            if (PRTE_SUCCESS != (ret = prte_state_base_batch_add(batch, vpid, PRTE_PROC_STATE_REGISTERED))) {
+                /* don't lose the transition - activate it on its own */
+                PRTE_ERROR_LOG(ret);
+                name.rank = vpid;
+                PRTE_ACTIVATE_PROC_STATE(&name, PRTE_PROC_STATE_REGISTERED);
+            }
             count=1;
         }
+        prte_state_base_activate_proc_states(batch);
+        batch = NULL;
         break;
 
     default:
@@ -526,6 +548,10 @@ void prte_plm_base_recv(int status, pmix_proc_t* sender,
     }
 
   CLEANUP:
+    /* pass along any updates we collected before an error */
+    if (NULL != batch) {
+        prte_state_base_activate_proc_states(batch);
+    }
     /* see if an error occurred - if so, wakeup the HNP so we can exit */
     if (PRTE_PROC_IS_MASTER && PRTE_SUCCESS != rc) {
         jdata = NULL;
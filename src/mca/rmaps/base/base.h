@@ -73,6 +73,12 @@ typedef struct {
     /* default file for use in sequential and rankfile mapping
      * when the directive comes thru MCA param */
     char *file;
+    /* number of threads to use when computing bindings */
+    int bind_threads;
+    /* whether or not to report the time spent in each mapping phase */
+    bool report_timing;
+    /* max number of job maps to cache for replay (0 => no caching) */
+    int map_cache_size;
 } prte_rmaps_base_t;
 
 /**
@@ -38,6 +38,7 @@
 #include "src/mca/mca.h"
 #include "src/mca/base/base.h"
 #include "src/hwloc/hwloc-internal.h"
+#include "src/threads/threads.h"
 #include "src/threads/tsd.h"
 
 #include "types.h"
@@ -69,12 +70,17 @@ static bool membind_warned=false;
  * to recording usage etc in the userdata object */
 
 
-static void reset_usage(prte_node_t *node, pmix_nspace_t jobid)
+/* Each node keeps a running count of the procs bound to each
+ * object in its topology, updated as procs are bound and removed.
+ * The topology itself may be shared with other nodes, so load this
+ * node's counts into the userdata before binding on it. The procs
+ * of the job being bound are dropped from the counts before we
+ * start, so the counts only reflect the other jobs on the node */
+static void reset_usage(prte_node_t *node)
 {
-    int j;
-    prte_proc_t *proc;
-    prte_hwloc_obj_data_t *data=NULL;
-    hwloc_obj_t bound;
+    uint64_t key;
+    prte_hwloc_obj_data_t *data, *objdata;
+    hwloc_obj_t obj;
 
     prte_output_verbose(10, prte_rmaps_base_framework.framework_output,
                         "%s reset_usage: node %s has %d procs on it",
@@ -85,44 +91,26 @@ static void reset_usage(prte_node_t *node, pmix_nspace_t jobid)
      * records from the userdata in this topo */
     prte_hwloc_base_clear_usage(node->topology->topo);
 
-    /* cycle thru the procs on the node and record
-     * their usage in the topology
-     */
-    for (j=0; j < node->procs->size; j++) {
-        if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
-            continue;
-        }
-        /* ignore procs from this job */
-        if (PMIX_CHECK_NSPACE(proc->name.nspace, jobid)) {
-            prte_output_verbose(10, prte_rmaps_base_framework.framework_output,
-                                "%s reset_usage: ignoring proc %s",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                PRTE_NAME_PRINT(&proc->name));
-            continue;
-        }
-        bound = NULL;
-        /* get the object to which this proc is bound */
-        if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, (void**)&bound, PMIX_POINTER) ||
-            NULL == bound) {
-            /* this proc isn't bound - ignore it */
-            prte_output_verbose(10, prte_rmaps_base_framework.framework_output,
-                                "%s reset_usage: proc %s has no bind location",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                PRTE_NAME_PRINT(&proc->name));
+    if (NULL == node->usage || node->usage_topo != node->topology) {
+        /* nothing is bound on this node */
+        return;
+    }
+    PRTE_HASH_TABLE_FOREACH(key, uint64, data, node->usage) {
+        if (0 == data->num_bound) {
             continue;
         }
+        obj = (hwloc_obj_t)(uintptr_t)key;
         /* get the userdata struct for this object - create it if necessary */
-        data = (prte_hwloc_obj_data_t*)bound->userdata;
-        if (NULL == data) {
-            data = PRTE_NEW(prte_hwloc_obj_data_t);
-            bound->userdata = data;
+        objdata = (prte_hwloc_obj_data_t*)obj->userdata;
+        if (NULL == objdata) {
+            objdata = PRTE_NEW(prte_hwloc_obj_data_t);
+            obj->userdata = objdata;
         }
-        /* count that this proc is bound to this object */
-        data->num_bound++;
+        objdata->num_bound = data->num_bound;
         prte_output_verbose(10, prte_rmaps_base_framework.framework_output,
-                            "%s reset_usage: proc %s is bound - total %d",
+                            "%s reset_usage: %s has %u procs bound to it",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            PRTE_NAME_PRINT(&proc->name), data->num_bound);
+                            hwloc_obj_type_string(obj->type), data->num_bound);
     }
 }
 
@@ -135,31 +123,116 @@ static void unbind_procs(prte_job_t *jdata)
         if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, j))) {
             continue;
         }
+        prte_node_untrack_binding(proc);
         prte_remove_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND);
         prte_remove_attribute(&proc->attributes, PRTE_PROC_CPU_BITMAP);
     }
 }
 
+/* When nodes are bound in parallel (see bind_parallel), each node is
+ * described by one of these. The worker binding the node must not
+ * touch anything shared with the other nodes, so the cpus available
+ * on the node are computed up front by the calling thread, and any
+ * error is recorded here for the calling thread to report */
+typedef struct {
+    prte_node_t *node;
+    int depth;
+    hwloc_cpuset_t available;
+    int rc;
+    bool reverted;
+    bool membind_warn;
+    const char *topic;
+    char *name;
+    char *policy;
+    char *cpus;
+    int num1;
+    int num2;
+} bind_item_t;
+
+static void show_bind_error(const char *topic, char *name, char *policy,
+                            char *cpus, int num1, int num2)
+{
+    if (0 == strcmp(topic, "rmaps:binding-overload")) {
+        prte_show_help("help-prte-rmaps-base.txt", topic, true,
+                       policy, name, num1, num2);
+    } else if (0 == strcmp(topic, "insufficient-cpus-per-proc")) {
+        prte_show_help("help-prte-rmaps-base.txt", topic, true,
+                       policy, name, cpus, num1);
+    } else {
+        prte_show_help("help-prte-rmaps-base.txt", topic, true, name);
+    }
+}
+
+/* show the error now, or save it in the item if we are a worker */
+static void bind_error(bind_item_t *item, const char *topic, char *name,
+                       char *policy, char *cpus, int num1, int num2)
+{
+    if (NULL == item) {
+        show_bind_error(topic, name, policy, cpus, num1, num2);
+        return;
+    }
+    item->topic = topic;
+    item->name = (NULL == name) ? NULL : strdup(name);
+    item->policy = (NULL == policy) ? NULL : strdup(policy);
+    item->cpus = (NULL == cpus) ? NULL : strdup(cpus);
+    item->num1 = num1;
+    item->num2 = num2;
+}
+
+/* get the cpus on the node that are available to the job - this can
+ * add userdata to the node's topology, so it must not be called from
+ * the binding workers */
+static hwloc_cpuset_t node_available(prte_job_t *jdata, prte_node_t *node,
+                                     bool use_hwthread_cpus)
+{
+    hwloc_obj_t root;
+    prte_hwloc_topo_data_t *rdata;
+    hwloc_cpuset_t available, mycpus;
+    char *job_cpuset;
+
+    root = hwloc_get_root_obj(node->topology->topo);
+    if (NULL == root->userdata) {
+        /* incorrect */
+        return NULL;
+    }
+    rdata = (prte_hwloc_topo_data_t*)root->userdata;
+    available = hwloc_bitmap_dup(rdata->available);
+
+    /* see if this job has a "soft" cgroup assignment */
+    job_cpuset = NULL;
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PMIX_STRING) &&
+        NULL != job_cpuset) {
+        mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
+        hwloc_bitmap_and(available, mycpus, available);
+        hwloc_bitmap_free(mycpus);
+        free(job_cpuset);
+    }
+    return available;
+}
+
+/* if item is provided, then we are being run by one of the binding
+ * workers - the job is not modified if we have to fall back to not
+ * binding, and errors are saved in the item instead of being shown */
 static int bind_generic(prte_job_t *jdata,
                         prte_node_t *node,
-                        int target_depth)
+                        int target_depth,
+                        bind_item_t *item)
 {
-    int j;
+    int j, rc;
     prte_job_map_t *map;
     prte_proc_t *proc;
-    hwloc_obj_t trg_obj, tmp_obj, nxt_obj;
-    unsigned int ncpus;
+    hwloc_obj_t trg_obj, tmp_obj, nxt_obj, obj;
+    unsigned int ncpus, nobjs, *counts;
     prte_hwloc_obj_data_t *data;
     int total_cpus, cpus_per_rank;
-    hwloc_cpuset_t totalcpuset, available, mycpus;
+    hwloc_cpuset_t totalcpuset, available;
     hwloc_obj_t locale;
     char *cpu_bitmap, *job_cpuset;
     unsigned min_bound;
     bool dobind, use_hwthread_cpus;
     struct hwloc_topology_support *support;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *rdata;
     uint16_t u16, *u16ptr = &u16;
+    uint64_t key;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                         "mca:rmaps: bind downward for job %s with bindings %s",
@@ -167,7 +240,6 @@ static int bind_generic(prte_job_t *jdata,
                         prte_hwloc_base_print_binding(jdata->map->binding));
     /* initialize */
     map = jdata->map;
-    totalcpuset = hwloc_bitmap_alloc();
 
     dobind = false;
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL) ||
@@ -176,18 +248,6 @@ static int bind_generic(prte_job_t *jdata,
         prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DIFF, NULL, PMIX_BOOL)) {
         dobind = true;
     }
-    /* reset usage */
-    reset_usage(node, jdata->nspace);
-
-    /* get the available processors on this node */
-    root = hwloc_get_root_obj(node->topology->topo);
-    if (NULL == root->userdata) {
-        /* incorrect */
-        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-        return PRTE_ERR_BAD_PARAM;
-    }
-    rdata = (prte_hwloc_topo_data_t*)root->userdata;
-    available = hwloc_bitmap_dup(rdata->available);
 
     /* see if they want multiple cpus/rank */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PMIX_UINT16)) {
@@ -203,15 +263,40 @@ static int bind_generic(prte_job_t *jdata,
         use_hwthread_cpus = false;
     }
 
-    /* see if this job has a "soft" cgroup assignment */
-    job_cpuset = NULL;
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PMIX_STRING) &&
-        NULL != job_cpuset) {
-        mycpus = prte_hwloc_base_generate_cpuset(node->topology->topo, use_hwthread_cpus, job_cpuset);
-        hwloc_bitmap_and(available, mycpus, available);
-        hwloc_bitmap_free(mycpus);
+    /* get the available processors on this node */
+    if (NULL == item) {
+        available = node_available(jdata, node, use_hwthread_cpus);
+    } else {
+        available = hwloc_bitmap_dup(item->available);
+    }
+    if (NULL == available) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return PRTE_ERR_BAD_PARAM;
     }
 
+    /* count the procs bound to each object at the target depth. The
+     * topology may be shared with other nodes, so the counts are kept
+     * here rather than in its userdata. They start from the usage
+     * this node already has - the procs of the job being bound were
+     * dropped from it before we started, so that only reflects the
+     * other jobs on the node */
+    nobjs = hwloc_get_nbobjs_by_depth(node->topology->topo, target_depth);
+    counts = (unsigned int*)calloc((0 < nobjs) ? nobjs : 1, sizeof(unsigned int));
+    if (NULL == counts) {
+        hwloc_bitmap_free(available);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    if (NULL != node->usage && node->usage_topo == node->topology) {
+        PRTE_HASH_TABLE_FOREACH(key, uint64, data, node->usage) {
+            obj = (hwloc_obj_t)(uintptr_t)key;
+            if (target_depth == (int)obj->depth && obj->logical_index < nobjs) {
+                counts[obj->logical_index] = data->num_bound;
+            }
+        }
+    }
+    totalcpuset = hwloc_bitmap_alloc();
+    rc = PRTE_SUCCESS;
+
     /* cycle thru the procs */
     for (j=0; j < node->procs->size; j++) {
         if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
@@ -242,13 +327,9 @@ static int bind_generic(prte_job_t *jdata,
                     /* we are not required to bind, so ignore this */
                     continue;
                 }
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
-                hwloc_bitmap_free(totalcpuset);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
+                bind_error(item, "rmaps:cpubind-not-supported", node->name, NULL, NULL, 0, 0);
+                rc = PRTE_ERR_SILENT;
+                goto cleanup;
             }
             /* check if topology supports membind - have to be careful here
              * as hwloc treats this differently than I (at least) would have
@@ -261,17 +342,18 @@ static int bind_generic(prte_job_t *jdata,
             if (!support->membind->set_thisproc_membind &&
                 !support->membind->set_thisthread_membind &&
                 PRTE_BINDING_POLICY_IS_SET(map->binding)) {
-                if (PRTE_HWLOC_BASE_MBFA_WARN == prte_hwloc_base_mbfa && !membind_warned) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true, node->name);
-                    membind_warned = true;
-                } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
+                if (PRTE_HWLOC_BASE_MBFA_WARN == prte_hwloc_base_mbfa) {
+                    if (NULL != item) {
+                        /* the caller will warn */
+                        item->membind_warn = true;
+                    } else if (!membind_warned) {
+                        prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true, node->name);
+                        membind_warned = true;
                     }
-                    return PRTE_ERR_SILENT;
+                } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
+                    bind_error(item, "rmaps:membind-not-supported-fatal", node->name, NULL, NULL, 0, 0);
+                    rc = PRTE_ERR_SILENT;
+                    goto cleanup;
                 }
             }
         }
@@ -280,13 +362,9 @@ static int bind_generic(prte_job_t *jdata,
         locale = NULL;
         if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PMIX_POINTER) ||
             NULL == locale) {
-            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-locale", true, PRTE_NAME_PRINT(&proc->name));
-            hwloc_bitmap_free(totalcpuset);
-            hwloc_bitmap_free(available);
-            if (NULL != job_cpuset) {
-                free(job_cpuset);
-            }
-            return PRTE_ERR_SILENT;
+            bind_error(item, "rmaps:no-locale", PRTE_NAME_PRINT(&proc->name), NULL, NULL, 0, 0);
+            rc = PRTE_ERR_SILENT;
+            goto cleanup;
         }
 
         /* use the min_bound object that intersects locale->cpuset at target_depth */
@@ -301,28 +379,20 @@ static int bind_generic(prte_job_t *jdata,
             if (!hwloc_bitmap_intersects(available, tmp_obj->cpuset))
                 continue;
 
-            data = (prte_hwloc_obj_data_t*)tmp_obj->userdata;
-            if (NULL == data) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                tmp_obj->userdata = data;
-            }
-            if (data->num_bound < min_bound) {
-                min_bound = data->num_bound;
+            if (counts[tmp_obj->logical_index] < min_bound) {
+                min_bound = counts[tmp_obj->logical_index];
                 trg_obj = tmp_obj;
             }
         }
         if (NULL == trg_obj) {
             /* there aren't any such targets under this object */
-            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
-            hwloc_bitmap_free(totalcpuset);
-            hwloc_bitmap_free(available);
-            if (NULL != job_cpuset) {
-                free(job_cpuset);
-            }
-            return PRTE_ERR_SILENT;
+            bind_error(item, "rmaps:no-available-cpus", node->name, NULL, NULL, 0, 0);
+            rc = PRTE_ERR_SILENT;
+            goto cleanup;
         }
         /* record the location */
         prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_ATTR_LOCAL, trg_obj, PMIX_POINTER);
+        prte_node_track_binding(node, proc, trg_obj);
 
         /* start with a clean slate */
         hwloc_bitmap_zero(totalcpuset);
@@ -331,69 +401,58 @@ static int bind_generic(prte_job_t *jdata,
         do {
             if (NULL == nxt_obj) {
                 /* could not find enough cpus to meet request */
-                prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
-                hwloc_bitmap_free(totalcpuset);
-                hwloc_bitmap_free(available);
-                if (NULL != job_cpuset) {
-                    free(job_cpuset);
-                }
-                return PRTE_ERR_SILENT;
+                bind_error(item, "rmaps:no-available-cpus", node->name, NULL, NULL, 0, 0);
+                rc = PRTE_ERR_SILENT;
+                goto cleanup;
             }
             trg_obj = nxt_obj;
             /* get the number of available cpus under this location */
             ncpus = prte_hwloc_base_get_npus(node->topology->topo, use_hwthread_cpus,
                                               available, trg_obj);
             /* track the number bound */
-            if (NULL == (data = (prte_hwloc_obj_data_t*)trg_obj->userdata)) {
-                data = PRTE_NEW(prte_hwloc_obj_data_t);
-                trg_obj->userdata = data;
-            }
-            data->num_bound++;
+            counts[trg_obj->logical_index]++;
             /* error out if adding a proc would cause overload and that wasn't allowed,
              * and it wasn't a default binding policy (i.e., the user requested it)
              */
-            if (ncpus < data->num_bound &&
+            if (ncpus < counts[trg_obj->logical_index] &&
                 !PRTE_BIND_OVERLOAD_ALLOWED(jdata->map->binding)) {
                 if (PRTE_BINDING_POLICY_IS_SET(jdata->map->binding)) {
                     /* if the user specified a binding policy, then we cannot meet
                      * it since overload isn't allowed, so error out - have the
                      * message indicate that setting overload allowed will remove
                      * this restriction */
-                    prte_show_help("help-prte-rmaps-base.txt", "rmaps:binding-overload", true,
-                                   prte_hwloc_base_print_binding(map->binding), node->name,
-                                   data->num_bound, ncpus);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
-                    }
-                    return PRTE_ERR_SILENT;
+                    bind_error(item, "rmaps:binding-overload", node->name,
+                               prte_hwloc_base_print_binding(map->binding), NULL,
+                               counts[trg_obj->logical_index], ncpus);
+                    rc = PRTE_ERR_SILENT;
+                    goto cleanup;
                 } else if (1 < cpus_per_rank) {
                     /* if the user specified cpus/proc, then we weren't able
                      * to meet that request - this constitutes an error that
                      * must be reported */
-                    prte_show_help("help-prte-rmaps-base.txt", "insufficient-cpus-per-proc", true,
-                                   prte_hwloc_base_print_binding(map->binding), node->name,
-                                   (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
-                                   cpus_per_rank);
-                    hwloc_bitmap_free(available);
+                    job_cpuset = NULL;
+                    prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PMIX_STRING);
+                    bind_error(item, "insufficient-cpus-per-proc", node->name,
+                               prte_hwloc_base_print_binding(map->binding),
+                               (NULL != job_cpuset) ? job_cpuset : (NULL == prte_hwloc_default_cpu_list) ? "FULL" : prte_hwloc_default_cpu_list,
+                               cpus_per_rank, 0);
                     if (NULL != job_cpuset) {
                         free(job_cpuset);
                     }
-                    return PRTE_ERR_SILENT;
+                    rc = PRTE_ERR_SILENT;
+                    goto cleanup;
                 } else {
                     /* if we have the default binding policy, then just don't bind */
                     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                                         "%s NOT ENOUGH CPUS TO COMPLETE BINDING - BINDING NOT REQUIRED, REVERTING TO NOT BINDING",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                    PRTE_SET_BINDING_POLICY(map->binding, PRTE_BIND_TO_NONE);
-                    unbind_procs(jdata);
-                    hwloc_bitmap_free(totalcpuset);
-                    hwloc_bitmap_free(available);
-                    if (NULL != job_cpuset) {
-                        free(job_cpuset);
+                    if (NULL != item) {
+                        item->reverted = true;
+                    } else {
+                        PRTE_SET_BINDING_POLICY(map->binding, PRTE_BIND_TO_NONE);
+                        unbind_procs(jdata);
                     }
-                    return PRTE_SUCCESS;
+                    goto cleanup;
                 }
             }
             /* bind the proc here */
@@ -422,13 +481,12 @@ static int bind_generic(prte_job_t *jdata,
             free(tmp1);
         }
     }
+
+  cleanup:
     hwloc_bitmap_free(totalcpuset);
     hwloc_bitmap_free(available);
-    if (NULL != job_cpuset) {
-        free(job_cpuset);
-    }
-
-    return PRTE_SUCCESS;
+    free(counts);
+    return rc;
 }
 
 static int bind_in_place(prte_job_t *jdata,
@@ -560,7 +618,7 @@ static int bind_in_place(prte_job_t *jdata,
          * to save space, so we need to reset the usage info to reflect
          * our own current state
          */
-        reset_usage(node, jdata->nspace);
+        reset_usage(node);
         /* get the available processors on this node */
         root = hwloc_get_root_obj(node->topology->topo);
         if (NULL == root->userdata) {
@@ -730,6 +788,7 @@ static int bind_in_place(prte_job_t *jdata,
             prte_set_attribute(&proc->attributes, PRTE_PROC_CPU_BITMAP, PRTE_ATTR_GLOBAL, cpu_bitmap, PMIX_STRING);
             /* update the location, in case it changed */
             prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, PRTE_ATTR_LOCAL, locale, PMIX_POINTER);
+            prte_node_track_binding(node, proc, locale);
             prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                                 "%s BOUND PROC %s TO %s[%s:%u] on node %s",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -868,7 +927,7 @@ static int bind_to_cpuset(prte_job_t *jdata)
             hwloc_bitmap_free(mycpuset);
             return PRTE_ERR_NOT_FOUND;
         }
-        reset_usage(node, jdata->nspace);
+        reset_usage(node);
         hwloc_bitmap_zero(mycpuset);
 
         /* filter the node-available cpus against the specified "soft" cgroup */
@@ -928,6 +987,130 @@ static int bind_to_cpuset(prte_job_t *jdata)
     return PRTE_SUCCESS;
 }
 
+/* Each node keeps its own usage counts and bind_generic leaves the
+ * shared topology userdata alone when run by a worker, so the nodes
+ * can be bound independently of each other - the nodes are simply
+ * dealt out to a set of threads. The result is the same as binding
+ * the nodes in map order */
+typedef struct {
+    prte_job_t *jdata;
+    bind_item_t *items;
+    int nitems;
+    int id;
+    int nworkers;
+    bool started;
+} bind_worker_t;
+
+static void* bind_worker(prte_object_t *obj)
+{
+    prte_thread_t *t = (prte_thread_t*)obj;
+    bind_worker_t *w = (bind_worker_t*)t->t_arg;
+    bind_item_t *item;
+    int n;
+
+    for (n=w->id; n < w->nitems; n += w->nworkers) {
+        item = &w->items[n];
+        item->rc = bind_generic(w->jdata, item->node, item->depth, item);
+        if (PRTE_SUCCESS != item->rc || item->reverted) {
+            /* nothing after this node in map order matters */
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void release_items(bind_item_t *items, int nitems)
+{
+    int n;
+
+    if (NULL == items) {
+        return;
+    }
+    for (n=0; n < nitems; n++) {
+        if (NULL != items[n].available) {
+            hwloc_bitmap_free(items[n].available);
+        }
+        free(items[n].name);
+        free(items[n].policy);
+        free(items[n].cpus);
+    }
+    free(items);
+}
+
+static int bind_parallel(prte_job_t *jdata, bind_item_t *items, int nitems)
+{
+    bind_worker_t *workers;
+    prte_thread_t *threads;
+    int n, nworkers, rc;
+
+    if (0 == nitems) {
+        return PRTE_SUCCESS;
+    }
+    nworkers = (prte_rmaps_base.bind_threads < nitems) ? prte_rmaps_base.bind_threads : nitems;
+    workers = (bind_worker_t*)malloc(nworkers * sizeof(bind_worker_t));
+    threads = (prte_thread_t*)malloc(nworkers * sizeof(prte_thread_t));
+    if (NULL == workers || NULL == threads) {
+        free(workers);
+        free(threads);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (n=0; n < nworkers; n++) {
+        workers[n].jdata = jdata;
+        workers[n].items = items;
+        workers[n].nitems = nitems;
+        workers[n].id = n;
+        workers[n].nworkers = nworkers;
+        PRTE_CONSTRUCT(&threads[n], prte_thread_t);
+        threads[n].t_run = bind_worker;
+        threads[n].t_arg = &workers[n];
+    }
+    /* we take the first share ourselves */
+    for (n=1; n < nworkers; n++) {
+        workers[n].started = false;
+        if (PRTE_SUCCESS != (rc = prte_thread_start(&threads[n]))) {
+            PRTE_ERROR_LOG(rc);
+            continue;
+        }
+        workers[n].started = true;
+    }
+    bind_worker(&threads[0].super);
+    for (n=1; n < nworkers; n++) {
+        if (workers[n].started) {
+            prte_thread_join(&threads[n], NULL);
+        } else {
+            /* do its share ourselves */
+            bind_worker(&threads[n].super);
+        }
+        PRTE_DESTRUCT(&threads[n]);
+    }
+    PRTE_DESTRUCT(&threads[0]);
+    free(workers);
+    free(threads);
+
+    /* look at the nodes in map order, stopping where the serial
+     * path would have stopped */
+    for (n=0; n < nitems; n++) {
+        if (items[n].membind_warn && !membind_warned) {
+            prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported", true,
+                           items[n].node->name);
+            membind_warned = true;
+        }
+        /* if a node had to fall back to not binding, then the outcome
+         * depends on the order of the nodes - let the caller redo it */
+        if (items[n].reverted) {
+            return PRTE_ERR_TAKE_NEXT_OPTION;
+        }
+        if (PRTE_SUCCESS != items[n].rc) {
+            if (NULL != items[n].topic) {
+                show_bind_error(items[n].topic, items[n].name, items[n].policy,
+                                items[n].cpus, items[n].num1, items[n].num2);
+            }
+            return items[n].rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
 int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
 {
     hwloc_obj_type_t hwb;
@@ -935,16 +1118,26 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
     prte_binding_policy_t bind;
     prte_mapping_policy_t map;
     prte_node_t *node;
+    prte_proc_t *proc;
     int i, rc;
     struct hwloc_topology_support *support;
     int bind_depth;
-    bool dobind;
+    bool dobind, use_hwthread_cpus = false;
+    bind_item_t *items = NULL;
+    int nitems = 0;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                         "mca:rmaps: compute bindings for job %s with policy %s[%x]",
                         PRTE_JOBID_PRINT(jdata->nspace),
                         prte_hwloc_base_print_binding(jdata->map->binding), jdata->map->binding);
 
+    /* drop any usage recorded by a prior binding of this job's procs */
+    for (i=0; i < jdata->procs->size; i++) {
+        if (NULL != (proc = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, i))) {
+            prte_node_untrack_binding(proc);
+        }
+    }
+
     map = PRTE_GET_MAPPING_POLICY(jdata->map->mapping);
     bind = PRTE_GET_BINDING_POLICY(jdata->map->binding);
 
@@ -1038,6 +1231,12 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
         dobind = true;
     }
 
+    /* if requested, collect the nodes so they can be bound in parallel */
+    if (1 < prte_rmaps_base.bind_threads && 1 < jdata->map->num_nodes) {
+        items = (bind_item_t*)calloc(jdata->map->nodes->size, sizeof(bind_item_t));
+        use_hwthread_cpus = prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PMIX_BOOL);
+    }
+
     for (i=0; i < jdata->map->nodes->size; i++) {
         if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, i))) {
             continue;
@@ -1063,6 +1262,7 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
                     continue;
                 }
                 prte_show_help("help-prte-rmaps-base.txt", "rmaps:cpubind-not-supported", true, node->name);
+                release_items(items, nitems);
                 return PRTE_ERR_SILENT;
             }
             /* check if topology supports membind - have to be careful here
@@ -1081,6 +1281,7 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
                     membind_warned = true;
                 } else if (PRTE_HWLOC_BASE_MBFA_ERROR == prte_hwloc_base_mbfa) {
                     prte_show_help("help-prte-rmaps-base.txt", "rmaps:membind-not-supported-fatal", true, node->name);
+                    release_items(items, nitems);
                     return PRTE_ERR_SILENT;
                 }
             }
@@ -1118,17 +1319,51 @@ int prte_rmaps_base_compute_bindings(prte_job_t *jdata)
             /* didn't find such an object */
             prte_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:no-objects",
                            true, hwloc_obj_type_string(hwb), node->name);
+            release_items(items, nitems);
             return PRTE_ERR_SILENT;
         }
         prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                             "%s bind_depth: %d",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             bind_depth);
-        if (PRTE_SUCCESS != (rc = bind_generic(jdata, node, bind_depth))) {
+        if (NULL != items) {
+            items[nitems].node = node;
+            items[nitems].depth = bind_depth;
+            items[nitems].available = node_available(jdata, node, use_hwthread_cpus);
+            ++nitems;
+            if (NULL == items[nitems-1].available) {
+                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+                release_items(items, nitems);
+                return PRTE_ERR_BAD_PARAM;
+            }
+            continue;
+        }
+        if (PRTE_SUCCESS != (rc = bind_generic(jdata, node, bind_depth, NULL))) {
             PRTE_ERROR_LOG(rc);
             return rc;
         }
     }
 
-    return PRTE_SUCCESS;
+    if (NULL == items) {
+        return PRTE_SUCCESS;
+    }
+    rc = bind_parallel(jdata, items, nitems);
+    if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+        /* start over and bind the nodes in order */
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps: rebinding job %s serially",
+                            PRTE_JOBID_PRINT(jdata->nspace));
+        unbind_procs(jdata);
+        rc = PRTE_SUCCESS;
+        for (i=0; i < nitems; i++) {
+            if (PRTE_SUCCESS != (rc = bind_generic(jdata, items[i].node, items[i].depth, NULL))) {
+                break;
+            }
+        }
+    }
+    release_items(items, nitems);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+    }
+    return rc;
 }
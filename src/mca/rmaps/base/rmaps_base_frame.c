@@ -59,6 +59,9 @@ prte_rmaps_base_t prte_rmaps_base = {{{0}}};
 static char *rmaps_base_mapping_policy = NULL;
 static char *rmaps_base_ranking_policy = NULL;
 static bool rmaps_base_inherit = false;
+static int rmaps_base_bind_threads = 0;
+static bool rmaps_base_report_timing = false;
+static int rmaps_base_map_cache_size = 0;
 
 static int prte_rmaps_base_register(prte_mca_base_register_flag_t flags)
 {
@@ -94,6 +97,31 @@ static int prte_rmaps_base_register(prte_mca_base_register_flag_t flags)
                                        PRTE_INFO_LVL_9,
                                        PRTE_MCA_BASE_VAR_SCOPE_READONLY, &rmaps_base_inherit);
 
+    rmaps_base_bind_threads = 0;
+    (void) prte_mca_base_var_register("prte", "rmaps", "base", "bind_threads",
+                                       "Number of threads to use when computing bindings for the nodes in a job "
+                                       "(0 or 1 => bind serially)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY, &rmaps_base_bind_threads);
+
+    rmaps_base_report_timing = false;
+    (void) prte_mca_base_var_register("prte", "rmaps", "base", "report_timing",
+                                       "Output one line per job giving the time spent in each mapping, ranking "
+                                       "and binding phase along with the policies used and the peak memory footprint",
+                                       PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY, &rmaps_base_report_timing);
+
+    rmaps_base_map_cache_size = 0;
+    (void) prte_mca_base_var_register("prte", "rmaps", "base", "map_cache_size",
+                                       "Number of job maps to remember so that identical jobs submitted against "
+                                       "an unchanged set of nodes reuse the prior placement instead of being "
+                                       "mapped again (0 => do not cache maps)",
+                                       PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                       PRTE_INFO_LVL_9,
+                                       PRTE_MCA_BASE_VAR_SCOPE_READONLY, &rmaps_base_map_cache_size);
+
     return PRTE_SUCCESS;
 }
 
@@ -106,6 +134,7 @@ static int prte_rmaps_base_close(void)
         PRTE_RELEASE(item);
     }
     PRTE_DESTRUCT(&prte_rmaps_base.selected_modules);
+    prte_rmaps_base_map_cache_flush();
 
     return prte_mca_base_framework_components_close(&prte_rmaps_base_framework, NULL);
 }
@@ -123,6 +152,9 @@ static int prte_rmaps_base_open(prte_mca_base_open_flag_t flags)
     prte_rmaps_base.mapping = 0;
     prte_rmaps_base.ranking = 0;
     prte_rmaps_base.inherit = rmaps_base_inherit;
+    prte_rmaps_base.bind_threads = rmaps_base_bind_threads;
+    prte_rmaps_base.report_timing = rmaps_base_report_timing;
+    prte_rmaps_base.map_cache_size = rmaps_base_map_cache_size;
     prte_rmaps_base.hwthread_cpus = false;
     if (NULL == prte_set_slots) {
         prte_set_slots = strdup("core");
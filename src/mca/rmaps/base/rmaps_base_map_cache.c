@@ -0,0 +1,509 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "src/class/prte_hash_table.h"
+#include "src/class/prte_list.h"
+#include "src/hwloc/hwloc-internal.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/attr.h"
+#include "src/util/output.h"
+
+#include "src/mca/rmaps/base/base.h"
+#include "src/mca/rmaps/base/rmaps_private.h"
+
+/*
+ * Cache of job maps. Workflow engines tend to submit the same job
+ * over and over to a persistent DVM, so remember the placement
+ * computed by the mappers (and the ranks assigned to each proc) and
+ * replay it when an identical job arrives.
+ *
+ * An entry is keyed by a hash of everything the mappers look at: the
+ * mapping, ranking and binding policies, the mapping-related job and
+ * app attributes (including the contents of any hostfile), the
+ * number of procs in each app, and the state, slot usage, flags,
+ * topology and binding usage of every node in the pool. Any change
+ * in node state or resident usage therefore results in a different
+ * key, so stale entries are never replayed - they simply age out of
+ * the cache.
+ */
+
+typedef struct {
+    int32_t index;
+    bool oversubscribed;
+} prte_rmaps_map_cache_node_t;
+
+typedef struct {
+    int32_t node;
+    prte_app_idx_t app_idx;
+    pmix_rank_t rank;
+    hwloc_obj_t locale;
+} prte_rmaps_map_cache_proc_t;
+
+typedef struct {
+    prte_list_item_t super;
+    uint64_t key;
+    char *mapper;
+    prte_mapping_policy_t mapping;
+    prte_ranking_policy_t ranking;
+    prte_binding_policy_t binding;
+    bool oversubscribed;
+    int32_t bookmark;
+    pmix_rank_t num_procs;
+    int num_apps;
+    int32_t *app_nprocs;
+    pmix_rank_t *app_first;
+    int num_nodes;
+    prte_rmaps_map_cache_node_t *nodes;
+    int nprocs;
+    prte_rmaps_map_cache_proc_t *procs;
+} prte_rmaps_map_cache_t;
+
+static void mccon(prte_rmaps_map_cache_t *p)
+{
+    p->key = 0;
+    p->mapper = NULL;
+    p->bookmark = -1;
+    p->app_nprocs = NULL;
+    p->app_first = NULL;
+    p->nodes = NULL;
+    p->procs = NULL;
+}
+static void mcdes(prte_rmaps_map_cache_t *p)
+{
+    if (NULL != p->mapper) {
+        free(p->mapper);
+    }
+    if (NULL != p->app_nprocs) {
+        free(p->app_nprocs);
+    }
+    if (NULL != p->app_first) {
+        free(p->app_first);
+    }
+    if (NULL != p->nodes) {
+        free(p->nodes);
+    }
+    if (NULL != p->procs) {
+        free(p->procs);
+    }
+}
+static PRTE_CLASS_INSTANCE(prte_rmaps_map_cache_t,
+                           prte_list_item_t,
+                           mccon, mcdes);
+
+static bool cache_init = false;
+static prte_hash_table_t map_cache;
+/* entries in the order they were added so we know which to evict */
+static prte_list_t map_cache_order;
+
+/* 64-bit FNV-1a */
+#define PRTE_MAP_CACHE_FNV_OFFSET   0xcbf29ce484222325ULL
+#define PRTE_MAP_CACHE_FNV_PRIME    0x100000001b3ULL
+
+static void mix(uint64_t *h, const void *data, size_t len)
+{
+    const unsigned char *p = (const unsigned char*)data;
+    size_t n;
+
+    for (n=0; n < len; n++) {
+        *h ^= p[n];
+        *h *= PRTE_MAP_CACHE_FNV_PRIME;
+    }
+}
+
+static void mix_string(uint64_t *h, const char *str)
+{
+    /* include the terminator so adjacent strings can't run together */
+    if (NULL == str) {
+        mix(h, "", 1);
+    } else {
+        mix(h, str, strlen(str) + 1);
+    }
+}
+
+static void mix_string_attr(uint64_t *h, prte_list_t *attributes, prte_attribute_key_t key)
+{
+    char *str = NULL;
+
+    if (prte_get_attribute(attributes, key, (void**)&str, PMIX_STRING) && NULL != str) {
+        mix_string(h, str);
+        free(str);
+    } else {
+        mix_string(h, NULL);
+    }
+}
+
+/* a hostfile can be edited between submissions of an otherwise
+ * identical job, so the key has to cover what is in it and not
+ * just its name */
+static bool mix_file_attr(uint64_t *h, prte_list_t *attributes, prte_attribute_key_t key)
+{
+    char *path = NULL;
+    char buf[4096];
+    size_t n;
+    FILE *fp;
+    bool ret = true;
+
+    if (!prte_get_attribute(attributes, key, (void**)&path, PMIX_STRING) || NULL == path) {
+        mix_string(h, NULL);
+        return true;
+    }
+    mix_string(h, path);
+    if (NULL == (fp = fopen(path, "r"))) {
+        /* let the mapper report the problem */
+        free(path);
+        return false;
+    }
+    while (0 < (n = fread(buf, 1, sizeof(buf), fp))) {
+        mix(h, buf, n);
+    }
+    if (ferror(fp)) {
+        ret = false;
+    }
+    fclose(fp);
+    free(path);
+    return ret;
+}
+
+static void mix_node(uint64_t *h, prte_node_t *node)
+{
+    prte_node_flags_t flags;
+    uintptr_t topo;
+    uint64_t usage = 0, entry, ukey;
+    prte_hwloc_obj_data_t *data;
+    bool has_daemon;
+
+    mix(h, &node->index, sizeof(node->index));
+    mix(h, &node->state, sizeof(node->state));
+    flags = node->flags & ~PRTE_NODE_FLAG_MAPPED;
+    mix(h, &flags, sizeof(flags));
+    mix(h, &node->slots, sizeof(node->slots));
+    mix(h, &node->slots_max, sizeof(node->slots_max));
+    mix(h, &node->slots_inuse, sizeof(node->slots_inuse));
+    mix(h, &node->num_procs, sizeof(node->num_procs));
+    has_daemon = (NULL != node->daemon);
+    mix(h, &has_daemon, sizeof(has_daemon));
+    topo = (uintptr_t)node->topology;
+    mix(h, &topo, sizeof(topo));
+    /* the usage table can be traversed in any order, so combine
+     * the entries in a way that doesn't depend on it */
+    if (NULL != node->usage) {
+        PRTE_HASH_TABLE_FOREACH(ukey, uint64, data, node->usage) {
+            entry = PRTE_MAP_CACHE_FNV_OFFSET;
+            mix(&entry, &ukey, sizeof(ukey));
+            mix(&entry, &data->num_bound, sizeof(data->num_bound));
+            usage += entry;
+        }
+    }
+    mix(h, &usage, sizeof(usage));
+}
+
+bool prte_rmaps_base_map_cache_key(prte_job_t *jdata, uint64_t *key)
+{
+    uint64_t h = PRTE_MAP_CACHE_FNV_OFFSET;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_job_flags_t flags;
+    uint16_t u16 = 0, *u16ptr = &u16;
+    int32_t bookmark;
+    bool flag;
+    int i;
+
+    if (0 >= prte_rmaps_base.map_cache_size) {
+        return false;
+    }
+    /* maps read from a file can change without us knowing, and
+     * adding hosts changes the pool while we map */
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_FILE, NULL, PMIX_STRING)) {
+        return false;
+    }
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+        if (prte_get_attribute(&app->attributes, PRTE_APP_ADD_HOST, NULL, PMIX_STRING) ||
+            prte_get_attribute(&app->attributes, PRTE_APP_ADD_HOSTFILE, NULL, PMIX_STRING)) {
+            return false;
+        }
+    }
+    /* looking for a target node resets nodes marked do-not-use,
+     * which a replay would not do */
+    for (i=0; i < prte_node_pool->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
+            continue;
+        }
+        if (PRTE_NODE_STATE_DO_NOT_USE == node->state) {
+            return false;
+        }
+    }
+
+    /* the job */
+    mix(&h, &jdata->map->mapping, sizeof(jdata->map->mapping));
+    mix(&h, &jdata->map->ranking, sizeof(jdata->map->ranking));
+    mix(&h, &jdata->map->binding, sizeof(jdata->map->binding));
+    mix_string(&h, jdata->map->req_mapper);
+    mix_string(&h, jdata->map->last_mapper);
+    flags = jdata->flags & (PRTE_JOB_FLAG_DEBUGGER_DAEMON | PRTE_JOB_FLAG_TOOL);
+    mix(&h, &flags, sizeof(flags));
+    bookmark = (NULL == jdata->bookmark) ? -1 : jdata->bookmark->index;
+    mix(&h, &bookmark, sizeof(bookmark));
+    mix_string_attr(&h, &jdata->attributes, PRTE_JOB_CPUSET);
+    mix_string_attr(&h, &jdata->attributes, PRTE_JOB_PPR);
+    mix_string_attr(&h, &jdata->attributes, PRTE_JOB_DIST_DEVICE);
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PMIX_UINT16)) {
+        u16 = 0;
+    }
+    mix(&h, &u16, sizeof(u16));
+    flag = prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PMIX_BOOL);
+    mix(&h, &flag, sizeof(flag));
+    flag = prte_get_attribute(&jdata->attributes, PRTE_JOB_CORE_CPUS, NULL, PMIX_BOOL);
+    mix(&h, &flag, sizeof(flag));
+
+    /* the apps */
+    mix(&h, &jdata->num_apps, sizeof(jdata->num_apps));
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+        mix(&h, &app->idx, sizeof(app->idx));
+        mix(&h, &app->num_procs, sizeof(app->num_procs));
+        mix_string_attr(&h, &app->attributes, PRTE_APP_DASH_HOST);
+        if (!mix_file_attr(&h, &app->attributes, PRTE_APP_HOSTFILE)) {
+            return false;
+        }
+    }
+
+    /* the nodes */
+    for (i=0; i < prte_node_pool->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, i))) {
+            continue;
+        }
+        mix_node(&h, node);
+    }
+
+    *key = h;
+    return true;
+}
+
+int prte_rmaps_base_map_cache_replay(prte_job_t *jdata, uint64_t key)
+{
+    prte_rmaps_map_cache_t *entry = NULL;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_proc_t *proc, *pptr;
+    int i, rc;
+
+    if (!cache_init ||
+        PRTE_SUCCESS != prte_hash_table_get_value_uint64(&map_cache, key, (void**)&entry) ||
+        NULL == entry) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    /* the key covers the node pool, but make sure everything we
+     * need is still there before we touch the job */
+    for (i=0; i < entry->num_nodes; i++) {
+        if (NULL == prte_pointer_array_get_item(prte_node_pool, entry->nodes[i].index)) {
+            return PRTE_ERR_NOT_FOUND;
+        }
+    }
+    if (entry->num_apps != (int)jdata->num_apps) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps: replaying cached map for job %s",
+                        PRTE_JOBID_PRINT(jdata->nspace));
+
+    if (NULL != jdata->map->last_mapper) {
+        free(jdata->map->last_mapper);
+    }
+    jdata->map->last_mapper = (NULL == entry->mapper) ? NULL : strdup(entry->mapper);
+    jdata->map->mapping = entry->mapping;
+    jdata->map->ranking = entry->ranking;
+    jdata->map->binding = entry->binding;
+
+    for (i=0; i < jdata->apps->size && i < entry->num_apps; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+        app->num_procs = entry->app_nprocs[i];
+        app->first_rank = entry->app_first[i];
+    }
+
+    for (i=0; i < entry->num_nodes; i++) {
+        node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, entry->nodes[i].index);
+        PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
+        PRTE_RETAIN(node);
+        prte_pointer_array_add(jdata->map->nodes, node);
+        ++(jdata->map->num_nodes);
+        if (entry->nodes[i].oversubscribed) {
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_OVERSUBSCRIBED);
+        }
+    }
+    if (entry->oversubscribed) {
+        PRTE_FLAG_SET(jdata, PRTE_JOB_FLAG_OVERSUBSCRIBED);
+    }
+
+    /* from here on the job holds a partial map if we fail - the
+     * caller moves it to MAP_FAILED, which releases it just as it
+     * does when a mapper fails part way through */
+    for (i=0; i < entry->nprocs; i++) {
+        node = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, entry->procs[i].node);
+        if (NULL == (proc = prte_rmaps_base_setup_proc(jdata, node, entry->procs[i].app_idx))) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        if (NULL != entry->procs[i].locale) {
+            prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_ATTR_LOCAL,
+                               entry->procs[i].locale, PMIX_POINTER);
+        }
+        proc->name.rank = entry->procs[i].rank;
+        proc->rank = entry->procs[i].rank;
+        /* insert the proc into the jdata array */
+        if (NULL != (pptr = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, proc->name.rank))) {
+            PRTE_RELEASE(pptr);
+        }
+        PRTE_RETAIN(proc);
+        if (PRTE_SUCCESS != (rc = prte_pointer_array_set_item(jdata->procs, proc->name.rank, proc))) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    jdata->num_procs = entry->num_procs;
+    if (0 <= entry->bookmark) {
+        jdata->bookmark = (prte_node_t*)prte_pointer_array_get_item(prte_node_pool, entry->bookmark);
+    } else {
+        jdata->bookmark = NULL;
+    }
+
+    return PRTE_SUCCESS;
+}
+
+void prte_rmaps_base_map_cache_store(prte_job_t *jdata, uint64_t key)
+{
+    prte_rmaps_map_cache_t *entry, *old;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_proc_t *proc;
+    hwloc_obj_t obj;
+    int i, j, n;
+
+    /* maps that fully describe the procs came from a file */
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PMIX_BOOL)) {
+        return;
+    }
+
+    if (!cache_init) {
+        PRTE_CONSTRUCT(&map_cache, prte_hash_table_t);
+        prte_hash_table_init(&map_cache, 64);
+        PRTE_CONSTRUCT(&map_cache_order, prte_list_t);
+        cache_init = true;
+    }
+
+    entry = PRTE_NEW(prte_rmaps_map_cache_t);
+    entry->key = key;
+    if (NULL != jdata->map->last_mapper) {
+        entry->mapper = strdup(jdata->map->last_mapper);
+    }
+    entry->mapping = jdata->map->mapping;
+    entry->ranking = jdata->map->ranking;
+    entry->binding = jdata->map->binding;
+    entry->oversubscribed = PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_OVERSUBSCRIBED);
+    entry->bookmark = (NULL == jdata->bookmark) ? -1 : jdata->bookmark->index;
+    entry->num_procs = jdata->num_procs;
+
+    entry->num_apps = jdata->num_apps;
+    entry->app_nprocs = (int32_t*)calloc(entry->num_apps, sizeof(int32_t));
+    entry->app_first = (pmix_rank_t*)calloc(entry->num_apps, sizeof(pmix_rank_t));
+    entry->nodes = (prte_rmaps_map_cache_node_t*)calloc(jdata->map->num_nodes, sizeof(prte_rmaps_map_cache_node_t));
+    entry->procs = (prte_rmaps_map_cache_proc_t*)calloc(jdata->num_procs, sizeof(prte_rmaps_map_cache_proc_t));
+    if (NULL == entry->app_nprocs || NULL == entry->app_first ||
+        NULL == entry->nodes || NULL == entry->procs) {
+        PRTE_RELEASE(entry);
+        return;
+    }
+    for (i=0; i < jdata->apps->size && i < entry->num_apps; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+        entry->app_nprocs[i] = app->num_procs;
+        entry->app_first[i] = app->first_rank;
+    }
+
+    /* record the procs in the order they were placed on each node */
+    n = 0;
+    for (i=0; i < jdata->map->nodes->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, i))) {
+            continue;
+        }
+        if (entry->num_nodes == (int)jdata->map->num_nodes) {
+            /* should never happen */
+            PRTE_RELEASE(entry);
+            return;
+        }
+        entry->nodes[entry->num_nodes].index = node->index;
+        entry->nodes[entry->num_nodes].oversubscribed = PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_OVERSUBSCRIBED);
+        ++entry->num_nodes;
+        for (j=0; j < node->procs->size; j++) {
+            if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
+                continue;
+            }
+            if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
+                continue;
+            }
+            /* a proc with a preset binding came from a file */
+            if (n == (int)jdata->num_procs ||
+                prte_get_attribute(&proc->attributes, PRTE_PROC_CPU_BITMAP, NULL, PMIX_STRING)) {
+                PRTE_RELEASE(entry);
+                return;
+            }
+            obj = NULL;
+            prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&obj, PMIX_POINTER);
+            entry->procs[n].node = node->index;
+            entry->procs[n].app_idx = proc->app_idx;
+            entry->procs[n].rank = proc->name.rank;
+            entry->procs[n].locale = obj;
+            ++n;
+        }
+    }
+    entry->nprocs = n;
+
+    /* a new entry for the same key replaces the old one */
+    old = NULL;
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint64(&map_cache, key, (void**)&old) &&
+        NULL != old) {
+        prte_hash_table_remove_value_uint64(&map_cache, key);
+        prte_list_remove_item(&map_cache_order, &old->super);
+        PRTE_RELEASE(old);
+    }
+    /* make room */
+    while ((int)prte_list_get_size(&map_cache_order) >= prte_rmaps_base.map_cache_size) {
+        old = (prte_rmaps_map_cache_t*)prte_list_remove_first(&map_cache_order);
+        prte_hash_table_remove_value_uint64(&map_cache, old->key);
+        PRTE_RELEASE(old);
+    }
+    prte_hash_table_set_value_uint64(&map_cache, key, entry);
+    prte_list_append(&map_cache_order, &entry->super);
+}
+
+void prte_rmaps_base_map_cache_flush(void)
+{
+    if (!cache_init) {
+        return;
+    }
+    /* the table doesn't own the entries - the list does */
+    PRTE_DESTRUCT(&map_cache);
+    PRTE_LIST_DESTRUCT(&map_cache_order);
+    cache_init = false;
+}
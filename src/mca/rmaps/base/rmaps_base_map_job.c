@@ -29,6 +29,12 @@
 #include "constants.h"
 
 #include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
 
 #include "src/mca/mca.h"
 #include "src/util/argv.h"
@@ -48,6 +54,62 @@
 #include "src/mca/rmaps/base/rmaps_private.h"
 
 
+/* phases timed when rmaps_base_report_timing is set */
+enum {
+    PRTE_RMAPS_TIME_START,
+    PRTE_RMAPS_TIME_SETUP,
+    PRTE_RMAPS_TIME_MAP,
+    PRTE_RMAPS_TIME_VPIDS,
+    PRTE_RMAPS_TIME_LOCAL_RANKS,
+    PRTE_RMAPS_TIME_BIND,
+    PRTE_RMAPS_TIME_MAX
+};
+
+static void mark_time(struct timeval *tv, int phase)
+{
+    if (prte_rmaps_base.report_timing) {
+        gettimeofday(&tv[phase], NULL);
+    }
+}
+
+static double time_diff(struct timeval *tv, int start, int end)
+{
+    return (double)(tv[end].tv_sec - tv[start].tv_sec) +
+           (double)(tv[end].tv_usec - tv[start].tv_usec) / 1000000.0;
+}
+
+/* output a single line of whitespace-separated key=value pairs so
+ * that scripts (e.g., contrib/scaling/map_bench.pl) can track the
+ * cost of each phase across policies, scales, and releases */
+static void report_timing(prte_job_t *jdata, struct timeval *tv)
+{
+    long maxrss = 0;
+#ifdef HAVE_SYS_RESOURCE_H
+    struct rusage usage;
+
+    if (0 == getrusage(RUSAGE_SELF, &usage)) {
+        maxrss = usage.ru_maxrss;
+    }
+#endif
+
+    prte_output(0, "[rmaps:timing] job=%s mapper=%s nodes=%d procs=%lu "
+                "mapping=%s ranking=%s binding=%s "
+                "setup=%.6f map=%.6f vpids=%.6f local_ranks=%.6f bind=%.6f total=%.6f maxrss_kb=%ld",
+                PRTE_JOBID_PRINT(jdata->nspace),
+                (NULL == jdata->map->last_mapper) ? "NONE" : jdata->map->last_mapper,
+                (int)jdata->map->num_nodes, (unsigned long)jdata->num_procs,
+                prte_rmaps_base_print_mapping(jdata->map->mapping),
+                prte_rmaps_base_print_ranking(jdata->map->ranking),
+                prte_hwloc_base_print_binding(jdata->map->binding),
+                time_diff(tv, PRTE_RMAPS_TIME_START, PRTE_RMAPS_TIME_SETUP),
+                time_diff(tv, PRTE_RMAPS_TIME_SETUP, PRTE_RMAPS_TIME_MAP),
+                time_diff(tv, PRTE_RMAPS_TIME_MAP, PRTE_RMAPS_TIME_VPIDS),
+                time_diff(tv, PRTE_RMAPS_TIME_VPIDS, PRTE_RMAPS_TIME_LOCAL_RANKS),
+                time_diff(tv, PRTE_RMAPS_TIME_LOCAL_RANKS, PRTE_RMAPS_TIME_BIND),
+                time_diff(tv, PRTE_RMAPS_TIME_START, PRTE_RMAPS_TIME_BIND),
+                maxrss);
+}
+
 void prte_rmaps_base_map_job(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t*)cbdata;
@@ -67,9 +129,13 @@ void prte_rmaps_base_map_job(int fd, short args, void *cbdata)
     bool use_hwthreads = false;
     bool sequential = false;
     int32_t slots;
+    struct timeval times[PRTE_RMAPS_TIME_MAX];
+    uint64_t cache_key = 0;
+    bool cacheable;
 
     PRTE_ACQUIRE_OBJECT(caddy);
     jdata = caddy->jdata;
+    mark_time(times, PRTE_RMAPS_TIME_START);
 
     jdata->state = PRTE_JOB_STATE_MAP;
 
@@ -482,6 +548,26 @@ compute:
     /* cycle thru the available mappers until one agrees to map
      * the job
      */
+    mark_time(times, PRTE_RMAPS_TIME_SETUP);
+
+    /* if an identical job was already mapped against the same
+     * node state, then just reuse its placement */
+    cacheable = prte_rmaps_base_map_cache_key(jdata, &cache_key);
+    if (cacheable) {
+        rc = prte_rmaps_base_map_cache_replay(jdata, cache_key);
+        if (PRTE_SUCCESS == rc) {
+            mark_time(times, PRTE_RMAPS_TIME_MAP);
+            mark_time(times, PRTE_RMAPS_TIME_VPIDS);
+            goto mapped;
+        }
+        if (PRTE_ERR_NOT_FOUND != rc) {
+            PRTE_ERROR_LOG(rc);
+            jdata->exit_code = rc;
+            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
+            goto cleanup;
+        }
+    }
+
     did_map = false;
     if (1 == prte_list_get_size(&prte_rmaps_base.selected_modules)) {
         /* forced selection */
@@ -538,12 +624,24 @@ compute:
 
     /* compute the ranks and add the proc objects
      * to the jdata->procs array */
+    mark_time(times, PRTE_RMAPS_TIME_MAP);
     if (PRTE_SUCCESS != (rc = prte_rmaps_base_compute_vpids(jdata))) {
         PRTE_ERROR_LOG(rc);
         jdata->exit_code = rc;
         PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
         goto cleanup;
     }
+    mark_time(times, PRTE_RMAPS_TIME_VPIDS);
+    if (cacheable) {
+        prte_rmaps_base_map_cache_store(jdata, cache_key);
+    }
+
+  mapped:
+    if (prte_rmaps_base.report_timing) {
+        /* phases we skip cost nothing */
+        times[PRTE_RMAPS_TIME_LOCAL_RANKS] = times[PRTE_RMAPS_TIME_VPIDS];
+        times[PRTE_RMAPS_TIME_BIND] = times[PRTE_RMAPS_TIME_VPIDS];
+    }
 
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL) ||
         prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PMIX_BOOL) ||
@@ -556,6 +654,7 @@ compute:
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        mark_time(times, PRTE_RMAPS_TIME_LOCAL_RANKS);
         /* compute and save bindings */
         if (PRTE_SUCCESS != (rc = prte_rmaps_base_compute_bindings(jdata))) {
             PRTE_ERROR_LOG(rc);
@@ -563,6 +662,7 @@ compute:
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        mark_time(times, PRTE_RMAPS_TIME_BIND);
     } else if (prte_get_attribute(&jdata->attributes, PRTE_JOB_FULLY_DESCRIBED, NULL, PMIX_BOOL)) {
         /* compute and save local ranks */
         if (PRTE_SUCCESS != (rc = prte_rmaps_base_compute_local_ranks(jdata))) {
@@ -571,6 +671,7 @@ compute:
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        mark_time(times, PRTE_RMAPS_TIME_LOCAL_RANKS);
 
         /* compute and save bindings */
         if (PRTE_SUCCESS != (rc = prte_rmaps_base_compute_bindings(jdata))) {
@@ -579,6 +680,7 @@ compute:
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        mark_time(times, PRTE_RMAPS_TIME_BIND);
     }
 
     /* set the offset so shared memory components can potentially
@@ -602,6 +704,10 @@ compute:
         prte_rmaps_base_display_map(jdata);
     }
 
+    if (prte_rmaps_base.report_timing) {
+        report_timing(jdata, times);
+    }
+
     /* set the job state to the next position */
     PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_MAP_COMPLETE);
 
@@ -661,14 +767,14 @@ void prte_rmaps_base_display_map(prte_job_t *jdata)
                 if (proc->job != jdata) {
                     continue;
                 }
-                if (prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_BOUND, (void**)&bd, PMIX_POINTER)) {
-                    if (NULL == bd) {
-                        tmp1 = strdup("UNBOUND");
-                    } else {
-                        tmp1 = prte_hwloc_base_cset2str(bd->cpuset, false, node->topology->topo);
-                    }
-                } else {
+                /* the object a proc is bound to is also tracked in
+                 * the proc itself, so use that rather than searching
+                 * its attributes for PRTE_PROC_HWLOC_BOUND */
+                bd = proc->usage_obj;
+                if (NULL == bd || node != proc->usage_node) {
                     tmp1 = strdup("UNBOUND");
+                } else {
+                    tmp1 = prte_hwloc_base_cset2str(bd->cpuset, false, node->topology->topo);
                 }
                 prte_output(prte_clean_output, "\t\t<process rank=%s app_idx=%ld local_rank=%lu node_rank=%lu binding=%s>",
                             PRTE_VPID_PRINT(proc->name.rank),  (long)proc->app_idx,
@@ -30,6 +30,7 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#include <stdlib.h>
 
 #include "src/class/prte_pointer_array.h"
 #include "src/util/if.h"
@@ -195,19 +196,40 @@ static int rank_span(prte_job_t *jdata,
     return PRTE_SUCCESS;
 }
 
+/* procs to be ranked by the object they occupy, along with
+ * their position in the node's proc array */
+typedef struct {
+    prte_proc_t *proc;
+    unsigned int obj;
+    int pos;
+} prte_rmaps_fill_sort_t;
+
+static int fill_sort(const void *a, const void *b)
+{
+    const prte_rmaps_fill_sort_t *pa = (const prte_rmaps_fill_sort_t*)a;
+    const prte_rmaps_fill_sort_t *pb = (const prte_rmaps_fill_sort_t*)b;
+
+    if (pa->obj != pb->obj) {
+        return (pa->obj < pb->obj) ? -1 : 1;
+    }
+    return (pa->pos < pb->pos) ? -1 : ((pa->pos > pb->pos) ? 1 : 0);
+}
+
 static int rank_fill(prte_job_t *jdata,
                      hwloc_obj_type_t target,
                      unsigned cache_level)
 {
     prte_app_context_t *app;
-    hwloc_obj_t obj;
-    int num_objs, i, j, m, n, rc;
-    pmix_rank_t num_ranked=0;
+    int num_objs, j, k, m, n, rc;
     prte_node_t *node;
     prte_proc_t *proc, *pptr;
     pmix_rank_t vpid;
     int cnt;
     hwloc_obj_t locale;
+    prte_hwloc_obj_index_t *index;
+    prte_rmaps_fill_sort_t *procs = NULL;
+    int nprocs, nsize = 0;
+    unsigned int idx;
 
     prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                         "mca:rmaps:rank_fill: for job %s",
@@ -220,6 +242,10 @@ static int rank_fill(prte_job_t *jdata,
      *    Obj 0     Obj 1       Obj 0     Obj 1
      *     0 1       4 5         8 9      12 13
      *     2 3       6 7        10 11     14 15
+     *
+     * A proc belongs to the first object it shares a cpu with,
+     * so rather than scanning all the procs for each object, look
+     * up the object of each proc and sort the procs by it
      */
 
     vpid = 0;
@@ -234,96 +260,111 @@ static int rank_fill(prte_job_t *jdata,
                 continue;
             }
             /* get the number of objects - only consider those we can actually use */
-            num_objs = prte_hwloc_base_get_nbobjs_by_type(node->topology->topo, target,
-                                                          cache_level);
+            index = prte_hwloc_base_get_obj_index(node->topology->topo, target, cache_level);
+            num_objs = (NULL == index) ? 0 : (int)index->num_objs;
             prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
                                 "mca:rmaps:rank_fill: found %d objects on node %s with %d procs",
                                 num_objs, node->name, (int)node->num_procs);
             if (0 == num_objs) {
+                free(procs);
                 return PRTE_ERR_NOT_SUPPORTED;
             }
+            if (nsize < node->procs->size) {
+                free(procs);
+                nsize = node->procs->size;
+                procs = (prte_rmaps_fill_sort_t*)malloc(nsize * sizeof(prte_rmaps_fill_sort_t));
+                if (NULL == procs) {
+                    PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                    return PRTE_ERR_OUT_OF_RESOURCE;
+                }
+            }
 
-            /* for each object */
-            for (i=0; i < num_objs && cnt < app->num_procs; i++) {
-                obj = prte_hwloc_base_get_obj_by_type(node->topology->topo, target,
-                                                      cache_level, i);
+            /* collect the unranked procs of this app on this node */
+            nprocs = 0;
+            for (j=0; j < node->procs->size; j++) {
+                if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
+                    continue;
+                }
+                /* ignore procs from other jobs */
+                if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
+                    continue;
+                }
+                /* tie proc to its job */
+                proc->job = jdata;
+                /* ignore procs that are already assigned */
+                if (PMIX_RANK_INVALID != proc->name.rank) {
+                    continue;
+                }
+                /* ignore procs from other apps */
+                if (proc->app_idx != app->idx) {
+                    continue;
+                }
+                 /* protect against bozo case */
+                locale = NULL;
+                if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PMIX_POINTER) ||
+                    NULL == locale) {
+                    /* all mappers are _required_ to set the locale where the proc
+                     * has been mapped - it is therefore an error for this attribute
+                     * not to be set. Likewise, only a programming error could allow
+                     * the attribute to be set to a NULL value - however, we add that
+                     * conditional here to silence any compiler warnings */
+                    PRTE_ERROR_LOG(PRTE_ERROR);
+                    free(procs);
+                    return PRTE_ERROR;
+                }
+                /* ignore procs not on any object */
+                idx = prte_hwloc_base_get_first_obj_idx(index, locale->cpuset);
+                if (idx >= (unsigned int)num_objs) {
+                    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                                        "mca:rmaps:rank_fill: proc at position %d is not on any object", j);
+                    continue;
+                }
+                procs[nprocs].proc = proc;
+                procs[nprocs].obj = idx;
+                procs[nprocs].pos = j;
+                ++nprocs;
+            }
+            if (1 < nprocs) {
+                qsort(procs, nprocs, sizeof(prte_rmaps_fill_sort_t), fill_sort);
+            }
 
+            for (k=0; k < nprocs && cnt < app->num_procs; k++) {
+                proc = procs[k].proc;
                 prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                    "mca:rmaps:rank_fill: working object %d", i);
-
-                /* cycle thru the procs on this node */
-                for (j=0; j < node->procs->size && cnt < app->num_procs; j++) {
-                    if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
-                        continue;
-                    }
-                    /* ignore procs from other jobs */
-                    if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
-                        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                            "mca:rmaps:rank_fill skipping proc %s - from another job, num_ranked %d",
-                                            PRTE_NAME_PRINT(&proc->name), num_ranked);
-                        continue;
-                    }
-                    /* tie proc to its job */
-                    proc->job = jdata;
-                    /* ignore procs that are already assigned */
-                    if (PMIX_RANK_INVALID != proc->name.rank) {
-                        continue;
-                    }
-                    /* ignore procs from other apps */
-                    if (proc->app_idx != app->idx) {
-                        continue;
-                    }
-                     /* protect against bozo case */
-                    locale = NULL;
-                    if (!prte_get_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, (void**)&locale, PMIX_POINTER) ||
-                        NULL == locale) {
-                        /* all mappers are _required_ to set the locale where the proc
-                         * has been mapped - it is therefore an error for this attribute
-                         * not to be set. Likewise, only a programming error could allow
-                         * the attribute to be set to a NULL value - however, we add that
-                         * conditional here to silence any compiler warnings */
-                        PRTE_ERROR_LOG(PRTE_ERROR);
-                        return PRTE_ERROR;
-                    }
-                    /* ignore procs not on this object */
-                    if (!hwloc_bitmap_intersects(obj->cpuset, locale->cpuset)) {
-                        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                            "mca:rmaps:rank_fill: proc at position %d is not on object %d",
-                                            j, i);
-                        continue;
-                    }
-                    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
-                                        "mca:rmaps:rank_fill: assigning vpid %s", PRTE_VPID_PRINT(vpid));
-                    proc->name.rank = vpid;
-                    proc->rank = vpid++;
-                    if (0 == cnt) {
-                        app->first_rank = proc->name.rank;
-                    }
-                    cnt++;
+                                    "mca:rmaps:rank_fill: assigning vpid %s to proc at position %d on object %u",
+                                    PRTE_VPID_PRINT(vpid), procs[k].pos, procs[k].obj);
+                proc->name.rank = vpid;
+                proc->rank = vpid++;
+                if (0 == cnt) {
+                    app->first_rank = proc->name.rank;
+                }
+                cnt++;
 
-                    /* insert the proc into the jdata array */
-                    if (NULL != (pptr = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, proc->name.rank))) {
-                        PRTE_RELEASE(pptr);
-                    }
-                    PRTE_RETAIN(proc);
-                    if (PRTE_SUCCESS != (rc = prte_pointer_array_set_item(jdata->procs, proc->name.rank, proc))) {
-                        PRTE_ERROR_LOG(rc);
-                        return rc;
-                    }
-                    /* track where the highest vpid landed - this is our
-                     * new bookmark
-                     */
-                    jdata->bookmark = node;
+                /* insert the proc into the jdata array */
+                if (NULL != (pptr = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, proc->name.rank))) {
+                    PRTE_RELEASE(pptr);
                 }
+                PRTE_RETAIN(proc);
+                if (PRTE_SUCCESS != (rc = prte_pointer_array_set_item(jdata->procs, proc->name.rank, proc))) {
+                    PRTE_ERROR_LOG(rc);
+                    free(procs);
+                    return rc;
+                }
+                /* track where the highest vpid landed - this is our
+                 * new bookmark
+                 */
+                jdata->bookmark = node;
             }
         }
 
         /* Are all the procs ranked? we don't want to crash on INVALID ranks */
         if (cnt < app->num_procs) {
+            free(procs);
             return PRTE_ERR_FAILED_TO_MAP;
         }
     }
 
+    free(procs);
     return PRTE_SUCCESS;
 }
 
@@ -759,16 +800,39 @@ int prte_rmaps_base_compute_vpids(prte_job_t *jdata)
     return PRTE_ERR_NOT_IMPLEMENTED;
 }
 
+/* procs awaiting a local or node rank, along with their position
+ * in the node's proc array so that procs of different jobs sharing
+ * the same rank retain their order on the node */
+typedef struct {
+    prte_proc_t *proc;
+    int idx;
+} prte_rmaps_rank_sort_t;
+
+static int rank_sort(const void *a, const void *b)
+{
+    const prte_rmaps_rank_sort_t *pa = (const prte_rmaps_rank_sort_t*)a;
+    const prte_rmaps_rank_sort_t *pb = (const prte_rmaps_rank_sort_t*)b;
+
+    if (pa->proc->name.rank < pb->proc->name.rank) {
+        return -1;
+    }
+    if (pa->proc->name.rank > pb->proc->name.rank) {
+        return 1;
+    }
+    return (pa->idx < pb->idx) ? -1 : ((pa->idx > pb->idx) ? 1 : 0);
+}
+
 int prte_rmaps_base_compute_local_ranks(prte_job_t *jdata)
 {
     int32_t i;
-    int j, k;
+    int j, k, nlocal, nnode;
     prte_node_t *node;
-    prte_proc_t *proc, *psave, *psave2;
-    pmix_rank_t minv, minv2;
+    prte_proc_t *proc;
     prte_local_rank_t local_rank;
     prte_job_map_t *map;
     prte_app_context_t *app;
+    prte_rmaps_rank_sort_t *lsort = NULL, *nsort = NULL;
+    int nsize = 0;
 
     PRTE_OUTPUT_VERBOSE((5, prte_rmaps_base_framework.framework_output,
                          "%s rmaps:base:compute_usage",
@@ -787,57 +851,70 @@ int prte_rmaps_base_compute_local_ranks(prte_job_t *jdata)
             continue;
         }
 
-        /* init search values */
-        local_rank = 0;
+        /* make sure we have room for every proc on this node */
+        if (nsize < node->procs->size) {
+            free(lsort);
+            free(nsort);
+            nsize = node->procs->size;
+            lsort = (prte_rmaps_rank_sort_t*)malloc(nsize * sizeof(prte_rmaps_rank_sort_t));
+            nsort = (prte_rmaps_rank_sort_t*)malloc(nsize * sizeof(prte_rmaps_rank_sort_t));
+            if (NULL == lsort || NULL == nsort) {
+                PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                free(lsort);
+                free(nsort);
+                return PRTE_ERR_OUT_OF_RESOURCE;
+            }
+        }
 
-        /* the proc map may have holes in it, so cycle
-         * all the way through and avoid the holes
+        /* collect the procs still needing a rank - the proc map may
+         * have holes in it, so cycle all the way through and avoid
+         * the holes
          */
+        nlocal = 0;
+        nnode = 0;
         for (k=0; k < node->procs->size; k++) {
-            /* if this proc is NULL, skip it */
-            if (NULL == prte_pointer_array_get_item(node->procs, k)) {
+            if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, k))) {
                 continue;
             }
-            minv = PMIX_RANK_VALID;
-            minv2 = PMIX_RANK_VALID;
-            psave = NULL;
-            psave2 = NULL;
-            /* find the minimum vpid proc */
-            for (j=0; j < node->procs->size; j++) {
-                /* if this proc is NULL, skip it */
-                if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, j))) {
-                    continue;
-                }
-                /* only look at procs for this job when
-                 * determining local rank
-                 */
-                if (PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace) &&
-                    PRTE_LOCAL_RANK_INVALID == proc->local_rank &&
-                    proc->name.rank < minv) {
-                    minv = proc->name.rank;
-                    psave = proc;
-                }
-                /* no matter what job...still have to handle node_rank */
-                if (PRTE_NODE_RANK_INVALID == proc->node_rank &&
-                    proc->name.rank < minv2) {
-                    minv2 = proc->name.rank;
-                    psave2 = proc;
-                }
-            }
-            if (NULL == psave && NULL == psave2) {
-                /* we must have processed them all for this node! */
-                break;
+            if (PMIX_RANK_VALID <= proc->name.rank) {
+                continue;
             }
-            if (NULL != psave) {
-                psave->local_rank = local_rank;
-                ++local_rank;
+            /* only look at procs for this job when
+             * determining local rank
+             */
+            if (PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace) &&
+                PRTE_LOCAL_RANK_INVALID == proc->local_rank) {
+                lsort[nlocal].proc = proc;
+                lsort[nlocal].idx = k;
+                ++nlocal;
             }
-            if (NULL != psave2) {
-                psave2->node_rank = node->next_node_rank;
-                node->next_node_rank++;
+            /* no matter what job...still have to handle node_rank */
+            if (PRTE_NODE_RANK_INVALID == proc->node_rank) {
+                nsort[nnode].proc = proc;
+                nsort[nnode].idx = k;
+                ++nnode;
             }
         }
+
+        /* assign the ranks in vpid order */
+        if (1 < nlocal) {
+            qsort(lsort, nlocal, sizeof(prte_rmaps_rank_sort_t), rank_sort);
+        }
+        local_rank = 0;
+        for (k=0; k < nlocal; k++) {
+            lsort[k].proc->local_rank = local_rank;
+            ++local_rank;
+        }
+        if (1 < nnode) {
+            qsort(nsort, nnode, sizeof(prte_rmaps_rank_sort_t), rank_sort);
+        }
+        for (k=0; k < nnode; k++) {
+            nsort[k].proc->node_rank = node->next_node_rank;
+            node->next_node_rank++;
+        }
     }
+    free(lsort);
+    free(nsort);
 
     /* compute app_rank */
     for (i=0; i < jdata->apps->size; i++) {
@@ -502,6 +502,19 @@ int prte_rmaps_base_get_target_nodes(prte_list_t *allocated_nodes, int32_t *tota
         }
     }
 
+    /* topologies reported by the daemons are held compressed until
+     * a mapper needs them - import those of the nodes we will use */
+    PRTE_LIST_FOREACH(node, allocated_nodes, prte_node_t) {
+        if (NULL != node->topology && NULL == node->topology->topo) {
+            rc = prte_topology_import(node->topology);
+            /* not found just means it wasn't returned */
+            if (PRTE_SUCCESS != rc && PRTE_ERR_NOT_FOUND != rc) {
+                PRTE_ERROR_LOG(rc);
+                return rc;
+            }
+        }
+    }
+
     /* pass back the total number of available slots */
     *total_num_slots = num_slots;
 
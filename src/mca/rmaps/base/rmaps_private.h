@@ -67,6 +67,20 @@ PRTE_EXPORT void prte_rmaps_base_update_local_ranks(prte_job_t *jdata, prte_node
 
 PRTE_EXPORT int prte_rmaps_base_rearrange_map(prte_app_context_t *app, prte_job_map_t *map, prte_list_t *procs);
 
+/* map cache - compute the key for a job, returning false if its map
+ * cannot be cached, replay a cached map (PRTE_ERR_NOT_FOUND if there
+ * is none), and record the map of a job once its ranks are assigned.
+ * PRTE_ERR_NOT_FOUND is returned before the job is touched - any other
+ * error may leave a partial map behind which, as with a failed mapper,
+ * is released with the job when it is moved to MAP_FAILED */
+PRTE_EXPORT bool prte_rmaps_base_map_cache_key(prte_job_t *jdata, uint64_t *key);
+
+PRTE_EXPORT int prte_rmaps_base_map_cache_replay(prte_job_t *jdata, uint64_t key);
+
+PRTE_EXPORT void prte_rmaps_base_map_cache_store(prte_job_t *jdata, uint64_t key);
+
+PRTE_EXPORT void prte_rmaps_base_map_cache_flush(void);
+
 END_C_DECLS
 
 #endif
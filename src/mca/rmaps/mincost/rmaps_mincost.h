@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Minimum-cost mapper - places procs on the cpus of each node by
+ * solving a min-cost assignment between the procs and the available
+ * cpus, where the cost of a cpu reflects the distance of its NUMA
+ * region from the target device and how loaded that region is.
+ */
+#ifndef PRTE_RMAPS_MINCOST_H
+#define PRTE_RMAPS_MINCOST_H
+
+#include "prte_config.h"
+
+#include "src/hwloc/hwloc-internal.h"
+#include "src/class/prte_list.h"
+
+#include "src/mca/rmaps/rmaps.h"
+
+BEGIN_C_DECLS
+
+typedef struct {
+    prte_rmaps_base_component_t super;
+    /* weight given to the NUMA distance from the device */
+    int distance_weight;
+    /* weight given to the load on each NUMA region */
+    int bandwidth_weight;
+    /* comma-delimited list of app indices that are I/O-heavy - NULL
+     * means all apps are */
+    char *io_apps;
+} prte_rmaps_mincost_component_t;
+
+PRTE_MODULE_EXPORT extern prte_rmaps_mincost_component_t prte_rmaps_mincost_component;
+extern prte_rmaps_base_module_t prte_rmaps_mincost_module;
+
+END_C_DECLS
+
+#endif
@@ -0,0 +1,120 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include "src/mca/base/base.h"
+#include "src/mca/base/prte_mca_base_var.h"
+
+#include "src/mca/rmaps/base/rmaps_private.h"
+#include "rmaps_mincost.h"
+
+/*
+ * Local functions
+ */
+
+static int prte_rmaps_mincost_open(void);
+static int prte_rmaps_mincost_close(void);
+static int prte_rmaps_mincost_query(prte_mca_base_module_t **module, int *priority);
+static int prte_rmaps_mincost_register(void);
+
+static int my_priority = 15;
+
+prte_rmaps_mincost_component_t prte_rmaps_mincost_component = {
+    .super = {
+        .base_version = {
+            PRTE_RMAPS_BASE_VERSION_2_0_0,
+
+            .mca_component_name = "mincost",
+            PRTE_MCA_BASE_MAKE_VERSION(component, PRTE_MAJOR_VERSION, PRTE_MINOR_VERSION,
+                                      PRTE_RELEASE_VERSION),
+            .mca_open_component = prte_rmaps_mincost_open,
+            .mca_close_component = prte_rmaps_mincost_close,
+            .mca_query_component = prte_rmaps_mincost_query,
+            .mca_register_component_params = prte_rmaps_mincost_register,
+        },
+        .base_data = {
+            /* The component is checkpoint ready */
+            PRTE_MCA_BASE_METADATA_PARAM_CHECKPOINT
+        },
+    },
+};
+
+
+static int prte_rmaps_mincost_register(void)
+{
+    prte_mca_base_component_t *c = &prte_rmaps_mincost_component.super.base_version;
+
+    my_priority = 15;
+    (void) prte_mca_base_component_var_register(c, "priority",
+                                           "Priority of the mincost rmaps component (below mindist "
+                                           "so it must be requested, e.g., with \"--prtemca rmaps mincost\")",
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &my_priority);
+
+    prte_rmaps_mincost_component.distance_weight = 10;
+    (void) prte_mca_base_component_var_register(c, "distance_weight",
+                                           "Cost per unit of NUMA distance between a cpu and the target device",
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prte_rmaps_mincost_component.distance_weight);
+
+    prte_rmaps_mincost_component.bandwidth_weight = 1;
+    (void) prte_mca_base_component_var_register(c, "bandwidth_weight",
+                                           "Cost per percent of a NUMA region already occupied by procs of the job "
+                                           "(higher values spread procs across NUMA regions to balance memory bandwidth)",
+                                           PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prte_rmaps_mincost_component.bandwidth_weight);
+
+    prte_rmaps_mincost_component.io_apps = NULL;
+    (void) prte_mca_base_component_var_register(c, "io_apps",
+                                           "Comma-delimited list of the indices of the I/O-heavy app contexts - procs "
+                                           "from other apps ignore the distance to the device (default: all apps)",
+                                           PRTE_MCA_BASE_VAR_TYPE_STRING, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                           PRTE_INFO_LVL_9,
+                                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prte_rmaps_mincost_component.io_apps);
+    return PRTE_SUCCESS;
+}
+
+/**
+  * component open/close/init function
+  */
+static int prte_rmaps_mincost_open(void)
+{
+    return PRTE_SUCCESS;
+}
+
+
+static int prte_rmaps_mincost_query(prte_mca_base_module_t **module, int *priority)
+{
+    /* the RMAPS framework is -only- opened on HNP's,
+     * so no need to check for that here
+     */
+
+    *priority = my_priority;
+    *module = (prte_mca_base_module_t *)&prte_rmaps_mincost_module;
+    return PRTE_SUCCESS;
+}
+
+/**
+ *  Close all subsystems.
+ */
+
+static int prte_rmaps_mincost_close(void)
+{
+    return PRTE_SUCCESS;
+}
@@ -0,0 +1,890 @@
+/*
+ * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include <errno.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif  /* HAVE_UNISTD_H */
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "src/mca/base/prte_mca_base_var.h"
+
+#include "src/util/argv.h"
+#include "src/util/bipartite_graph.h"
+#include "src/util/show_help.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/util/error_strings.h"
+
+#include "src/mca/rmaps/base/rmaps_private.h"
+#include "src/mca/rmaps/base/base.h"
+#include "src/mca/rmaps/mincost/rmaps_mincost.h"
+
+static int mincost_map(prte_job_t *jdata);
+static int assign_locations(prte_job_t *jdata);
+
+prte_rmaps_base_module_t prte_rmaps_mincost_module = {
+    .map_job = mincost_map,
+    .assign_locations = assign_locations
+};
+
+/* the procs from each app to be placed on a node */
+typedef struct {
+    prte_list_item_t super;
+    prte_node_t *node;
+    int *counts;
+    int nprocs;
+    bool oversubscribed;
+    hwloc_obj_t *locales;
+} prte_rmaps_mincost_node_t;
+static void mncon(prte_rmaps_mincost_node_t *p)
+{
+    p->node = NULL;
+    p->counts = NULL;
+    p->nprocs = 0;
+    p->oversubscribed = false;
+    p->locales = NULL;
+}
+static void mndes(prte_rmaps_mincost_node_t *p)
+{
+    if (NULL != p->node) {
+        PRTE_RELEASE(p->node);
+    }
+    if (NULL != p->counts) {
+        free(p->counts);
+    }
+    if (NULL != p->locales) {
+        free(p->locales);
+    }
+}
+static PRTE_CLASS_INSTANCE(prte_rmaps_mincost_node_t,
+                           prte_list_item_t,
+                           mncon, mndes);
+
+/* a place a proc can go - an available cpu (or the first of a
+ * group of cpus_per_rank cpus) along with the distance of its NUMA
+ * region from the device, and how full that region will be once a
+ * proc is placed there (in percent) */
+typedef struct {
+    hwloc_obj_t obj;
+    int64_t dist;
+    int64_t fill;
+} prte_rmaps_mincost_slot_t;
+
+typedef struct {
+    int64_t cost;
+    int idx;
+} prte_rmaps_mincost_cost_t;
+
+static int cost_cmp(const void *a, const void *b)
+{
+    const prte_rmaps_mincost_cost_t *ca = (const prte_rmaps_mincost_cost_t*)a;
+    const prte_rmaps_mincost_cost_t *cb = (const prte_rmaps_mincost_cost_t*)b;
+
+    if (ca->cost != cb->cost) {
+        return (ca->cost < cb->cost) ? -1 : 1;
+    }
+    return (ca->idx < cb->idx) ? -1 : (ca->idx > cb->idx);
+}
+
+/* order locales by their logical index */
+static int locale_cmp(const void *a, const void *b)
+{
+    const hwloc_obj_t oa = *(const hwloc_obj_t*)a;
+    const hwloc_obj_t ob = *(const hwloc_obj_t*)b;
+
+    return (oa->logical_index < ob->logical_index) ? -1 : (oa->logical_index > ob->logical_index);
+}
+
+/* flag the apps whose procs care about their distance to the device */
+static bool* get_io_apps(prte_job_t *jdata)
+{
+    bool *io;
+    char **apps;
+    int n;
+    unsigned long idx;
+
+    io = (bool*)calloc(jdata->apps->size, sizeof(bool));
+    if (NULL == io) {
+        return NULL;
+    }
+    if (NULL == prte_rmaps_mincost_component.io_apps) {
+        for (n=0; n < jdata->apps->size; n++) {
+            io[n] = true;
+        }
+        return io;
+    }
+    apps = prte_argv_split(prte_rmaps_mincost_component.io_apps, ',');
+    for (n=0; NULL != apps && NULL != apps[n]; n++) {
+        idx = strtoul(apps[n], NULL, 10);
+        if (idx < (unsigned long)jdata->apps->size) {
+            io[idx] = true;
+        }
+    }
+    prte_argv_free(apps);
+    return io;
+}
+
+static char* get_device(prte_job_t *jdata)
+{
+    char *device = NULL;
+
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DIST_DEVICE, (void**)&device, PMIX_STRING) &&
+        NULL != device) {
+        return device;
+    }
+    if (NULL != prte_rmaps_base.device) {
+        return strdup(prte_rmaps_base.device);
+    }
+    return strdup("auto");
+}
+
+/*
+ * Assign each of the nprocs procs to be placed on the node to an
+ * available cpu. The procs are one side of a bipartite graph and the
+ * cpus (repeated if the node is oversubscribed) are the other. The
+ * cost of an edge is the weighted NUMA distance of the cpu from the
+ * device (only for I/O-heavy procs) plus the weighted fraction of
+ * the cpu's NUMA region that will be in use - including by procs of
+ * other jobs already bound there - so that the solver balances load
+ * across regions that are equally close.
+ *
+ * The procs of each class (I/O-heavy or not) are interchangeable, so
+ * the graph is built with the procs grouped by class and the locales
+ * each class receives are handed out in logical index order to the
+ * procs of that class in the order given. The result therefore only
+ * depends on the classes of the procs and the order of the procs
+ * within a class, which lets daemons recompute the locales the HNP
+ * assigned.
+ */
+static int solve_node(prte_job_t *jdata, prte_node_t *node, char *device,
+                      int nprocs, const bool *io, hwloc_obj_t *locales)
+{
+    hwloc_topology_t topo = node->topology->topo;
+    hwloc_obj_t root, obj;
+    hwloc_obj_type_t type;
+    hwloc_cpuset_t available, mycpus;
+    prte_hwloc_topo_data_t *rdata;
+    prte_list_t numa_list;
+    prte_rmaps_numa_node_t *numa;
+    prte_rmaps_mincost_slot_t *cand = NULL, *slots = NULL;
+    prte_rmaps_mincost_cost_t *costs = NULL;
+    prte_bp_graph_t *g = NULL;
+    hwloc_obj_t *numas = NULL;
+    float *lat = NULL, latmin = 0.0;
+    int *seen = NULL, *navail = NULL, *candnuma = NULL, *vtx = NULL, *vslot = NULL;
+    int *match = NULL, nmatch = 0, *resident = NULL;
+    int nnuma, ncpus, ncand = 0, cap, nslots, nedges = 0, nvtx;
+    int i, j, k, m, r, rc, cls, pos, first[2], nclass[2], next[2];
+    hwloc_obj_t *assigned = NULL;
+    uint64_t key;
+    prte_hwloc_obj_data_t *data;
+    int cpus_per_rank;
+    uint16_t u16, *u16ptr = &u16;
+    char *job_cpuset = NULL;
+    bool use_hwthread_cpus;
+    size_t sz;
+    struct timeval start, stop;
+
+    gettimeofday(&start, NULL);
+
+    root = hwloc_get_root_obj(topo);
+    if (NULL == root || NULL == root->userdata) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return PRTE_ERR_BAD_PARAM;
+    }
+    rdata = (prte_hwloc_topo_data_t*)root->userdata;
+
+    /* respect any limits on the cpus the job can use */
+    use_hwthread_cpus = prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PMIX_BOOL);
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void**)&u16ptr, PMIX_UINT16)) {
+        cpus_per_rank = u16;
+    } else {
+        cpus_per_rank = 1;
+    }
+    available = hwloc_bitmap_dup(rdata->available);
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_CPUSET, (void**)&job_cpuset, PMIX_STRING) &&
+        NULL != job_cpuset) {
+        mycpus = prte_hwloc_base_generate_cpuset(topo, use_hwthread_cpus, job_cpuset);
+        hwloc_bitmap_and(available, mycpus, available);
+        hwloc_bitmap_free(mycpus);
+        free(job_cpuset);
+    }
+
+    /* get the NUMA regions sorted by their distance from the device - we
+     * first need to fill the summary object for the root */
+    prte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_NODE, 0);
+    PRTE_CONSTRUCT(&numa_list, prte_list_t);
+    rc = prte_hwloc_get_sorted_numa_list(topo, device, &numa_list);
+    if (rc > 1) {
+        prte_show_help("help-prte-rmaps-mincost.txt", "several-devices",
+                       true, device, rc, node->name);
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+        goto cleanup;
+    } else if (rc < 0) {
+        prte_show_help("help-prte-rmaps-mincost.txt", "device-not-found",
+                       true, device, node->name);
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+        goto cleanup;
+    }
+    nnuma = prte_list_get_size(&numa_list);
+    if (0 == nnuma) {
+        if (hwloc_get_nbobjs_by_type(topo, HWLOC_OBJ_PACKAGE) > 1) {
+            /* don't have info about pci locality */
+            prte_show_help("help-prte-rmaps-mincost.txt", "no-pci-locality-info",
+                           true, node->name);
+        }
+        rc = PRTE_ERR_TAKE_NEXT_OPTION;
+        goto cleanup;
+    }
+    numas = (hwloc_obj_t*)calloc(nnuma, sizeof(hwloc_obj_t));
+    lat = (float*)calloc(nnuma, sizeof(float));
+    seen = (int*)calloc(nnuma, sizeof(int));
+    navail = (int*)calloc(nnuma, sizeof(int));
+    resident = (int*)calloc(nnuma, sizeof(int));
+    if (NULL == numas || NULL == lat || NULL == seen || NULL == navail || NULL == resident) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    j = 0;
+    PRTE_LIST_FOREACH(numa, &numa_list, prte_rmaps_numa_node_t) {
+        if (NULL == (numas[j] = prte_hwloc_base_get_obj_by_type(topo, HWLOC_OBJ_NODE, 0, numa->index))) {
+            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+            rc = PRTE_ERR_NOT_FOUND;
+            goto cleanup;
+        }
+        lat[j] = numa->dist_from_closed;
+        if (0 == j || lat[j] < latmin) {
+            latmin = lat[j];
+        }
+        ++j;
+    }
+
+    /* count the procs of other jobs already bound within each region */
+    if (NULL != node->usage && node->usage_topo == node->topology) {
+        PRTE_HASH_TABLE_FOREACH(key, uint64, data, node->usage) {
+            obj = (hwloc_obj_t)(uintptr_t)key;
+            if (NULL == obj || 0 == data->num_bound) {
+                continue;
+            }
+            for (j=0; j < nnuma; j++) {
+                if (hwloc_bitmap_intersects(obj->cpuset, numas[j]->cpuset)) {
+                    resident[j] += data->num_bound;
+                }
+            }
+        }
+    }
+
+    /* collect the available cpus, tracking the NUMA region of each
+     * and their position within it */
+    type = use_hwthread_cpus ? HWLOC_OBJ_PU : HWLOC_OBJ_CORE;
+    ncpus = hwloc_get_nbobjs_by_type(topo, type);
+    if (ncpus <= 0) {
+        prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
+        rc = PRTE_ERR_SILENT;
+        goto cleanup;
+    }
+    cand = (prte_rmaps_mincost_slot_t*)calloc(ncpus, sizeof(prte_rmaps_mincost_slot_t));
+    candnuma = (int*)calloc(ncpus, sizeof(int));
+    if (NULL == cand || NULL == candnuma) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for (m=0; m < ncpus; m++) {
+        obj = hwloc_get_obj_by_type(topo, type, m);
+        if (NULL == obj || !hwloc_bitmap_intersects(obj->cpuset, available)) {
+            continue;
+        }
+        for (j=0; j < nnuma; j++) {
+            if (hwloc_bitmap_intersects(obj->cpuset, numas[j]->cpuset)) {
+                break;
+            }
+        }
+        if (nnuma == j) {
+            /* no distance info - treat it as furthest away */
+            j = nnuma - 1;
+        }
+        /* each proc takes cpus_per_rank cpus */
+        if (0 != (seen[j]++ % cpus_per_rank)) {
+            continue;
+        }
+        cand[ncand].obj = obj;
+        cand[ncand].fill = navail[j]++;
+        candnuma[ncand] = j;
+        ++ncand;
+    }
+    if (0 == ncand) {
+        prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-available-cpus", true, node->name);
+        rc = PRTE_ERR_SILENT;
+        goto cleanup;
+    }
+
+    /* if there are more procs than cpus, then each cpu has to take
+     * more than one of them */
+    cap = (nprocs + ncand - 1) / ncand;
+    sz = (size_t)ncand * (size_t)cap;
+    if (sz > (size_t)INT_MAX) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    nslots = (int)sz;
+    slots = (prte_rmaps_mincost_slot_t*)calloc(sz, sizeof(prte_rmaps_mincost_slot_t));
+    costs = (prte_rmaps_mincost_cost_t*)calloc(sz, sizeof(prte_rmaps_mincost_cost_t));
+    vtx = (int*)malloc(sz * sizeof(int));
+    vslot = (int*)malloc(sz * sizeof(int));
+    assigned = (hwloc_obj_t*)calloc(nprocs, sizeof(hwloc_obj_t));
+    if (NULL == slots || NULL == costs || NULL == vtx || NULL == vslot || NULL == assigned) {
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for (r=0; r < cap; r++) {
+        for (k=0; k < ncand; k++) {
+            j = candnuma[k];
+            pos = r * navail[j] + cand[k].fill;
+            slots[r*ncand + k].obj = cand[k].obj;
+            slots[r*ncand + k].dist = (int64_t)(lat[j] - latmin + 0.5);
+            slots[r*ncand + k].fill = (100 * (int64_t)(resident[j] + pos)) / navail[j];
+        }
+    }
+
+    /* the procs are vertices [0, nprocs), grouped by class - slots only
+     * get a vertex if some proc has an edge to them */
+    nclass[0] = nclass[1] = 0;
+    for (i=0; i < nprocs; i++) {
+        nclass[io[i] ? 1 : 0]++;
+    }
+    first[0] = 0;
+    first[1] = nclass[0];
+    if (PRTE_SUCCESS != (rc = prte_bp_graph_create(NULL, NULL, &g))) {
+        PRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    for (i=0; i < nprocs; i++) {
+        if (PRTE_SUCCESS != (rc = prte_bp_graph_add_vertex(g, NULL, NULL))) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    }
+    for (k=0; k < nslots; k++) {
+        vtx[k] = -1;
+    }
+    nvtx = nprocs;
+    /* procs of the same class are interchangeable, and no proc ever
+     * needs one of the slots beyond the nprocs cheapest for its class
+     * (one of those would always be free), so only connect each proc
+     * to those */
+    for (cls=0; cls < 2; cls++) {
+        if (0 == nclass[cls]) {
+            continue;
+        }
+        for (k=0; k < nslots; k++) {
+            costs[k].idx = k;
+            costs[k].cost = (int64_t)prte_rmaps_mincost_component.bandwidth_weight * slots[k].fill;
+            if (1 == cls) {
+                costs[k].cost += (int64_t)prte_rmaps_mincost_component.distance_weight * slots[k].dist;
+            }
+        }
+        qsort(costs, nslots, sizeof(prte_rmaps_mincost_cost_t), cost_cmp);
+        for (k=0; k < nslots && k < nprocs; k++) {
+            if (vtx[costs[k].idx] < 0) {
+                if (PRTE_SUCCESS != (rc = prte_bp_graph_add_vertex(g, NULL, &vtx[costs[k].idx]))) {
+                    PRTE_ERROR_LOG(rc);
+                    goto cleanup;
+                }
+                vslot[vtx[costs[k].idx] - nprocs] = costs[k].idx;
+                ++nvtx;
+            }
+            for (i=first[cls]; i < first[cls] + nclass[cls]; i++) {
+                if (PRTE_SUCCESS != (rc = prte_bp_graph_add_edge(g, i, vtx[costs[k].idx],
+                                                                 costs[k].cost, 1, NULL))) {
+                    PRTE_ERROR_LOG(rc);
+                    goto cleanup;
+                }
+                ++nedges;
+            }
+        }
+    }
+
+    if (PRTE_SUCCESS != (rc = prte_bp_graph_solve_bipartite_assignment(g, &nmatch, &match))) {
+        PRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (nmatch != nprocs) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        rc = PRTE_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+    for (i=0; i < nmatch; i++) {
+        assigned[match[2*i]] = slots[vslot[match[2*i+1] - nprocs]].obj;
+    }
+    /* hand out the locales of each class in a canonical order */
+    for (cls=0; cls < 2; cls++) {
+        if (1 < nclass[cls]) {
+            qsort(&assigned[first[cls]], nclass[cls], sizeof(hwloc_obj_t), locale_cmp);
+        }
+        next[cls] = first[cls];
+    }
+    for (i=0; i < nprocs; i++) {
+        cls = io[i] ? 1 : 0;
+        locales[i] = assigned[next[cls]++];
+    }
+
+    gettimeofday(&stop, NULL);
+    prte_output_verbose(1, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps:mincost: node %s placed %d procs on %d cpus (%d vertices, %d edges) in %.6f seconds",
+                        node->name, nprocs, ncand, nvtx, nedges,
+                        (double)(stop.tv_sec - start.tv_sec) +
+                        (double)(stop.tv_usec - start.tv_usec) / 1000000.0);
+    rc = PRTE_SUCCESS;
+
+  cleanup:
+    PRTE_LIST_DESTRUCT(&numa_list);
+    hwloc_bitmap_free(available);
+    if (NULL != g) {
+        prte_bp_graph_free(g);
+    }
+    if (NULL != match) {
+        free(match);
+    }
+    if (NULL != numas) {
+        free(numas);
+    }
+    if (NULL != lat) {
+        free(lat);
+    }
+    if (NULL != seen) {
+        free(seen);
+    }
+    if (NULL != navail) {
+        free(navail);
+    }
+    if (NULL != resident) {
+        free(resident);
+    }
+    if (NULL != assigned) {
+        free(assigned);
+    }
+    if (NULL != cand) {
+        free(cand);
+    }
+    if (NULL != candnuma) {
+        free(candnuma);
+    }
+    if (NULL != slots) {
+        free(slots);
+    }
+    if (NULL != costs) {
+        free(costs);
+    }
+    if (NULL != vtx) {
+        free(vtx);
+    }
+    if (NULL != vslot) {
+        free(vslot);
+    }
+    return rc;
+}
+
+/* add procs from an app to the set to be placed on a node */
+static prte_rmaps_mincost_node_t* add_procs(prte_job_t *jdata, prte_node_t *node,
+                                            prte_app_context_t *app, int n,
+                                            prte_list_t *targets,
+                                            prte_pointer_array_t *lookup)
+{
+    prte_rmaps_mincost_node_t *mn;
+
+    if (NULL == (mn = (prte_rmaps_mincost_node_t*)prte_pointer_array_get_item(lookup, node->index))) {
+        mn = PRTE_NEW(prte_rmaps_mincost_node_t);
+        PRTE_RETAIN(node);
+        mn->node = node;
+        mn->counts = (int*)calloc(jdata->apps->size, sizeof(int));
+        if (NULL == mn->counts) {
+            PRTE_RELEASE(mn);
+            return NULL;
+        }
+        prte_pointer_array_set_item(lookup, node->index, mn);
+        prte_list_append(targets, &mn->super);
+    }
+    mn->counts[app->idx] += n;
+    mn->nprocs += n;
+    return mn;
+}
+
+static int pending(prte_node_t *node, prte_pointer_array_t *lookup)
+{
+    prte_rmaps_mincost_node_t *mn;
+
+    mn = (prte_rmaps_mincost_node_t*)prte_pointer_array_get_item(lookup, node->index);
+    return (NULL == mn) ? 0 : mn->nprocs;
+}
+
+/* decide how many procs from the app go on each node - fill each node
+ * in turn, or spread them one at a time if SPAN was given, and then
+ * spread any remaining procs across the nodes if we can oversubscribe */
+static int distribute(prte_job_t *jdata, prte_app_context_t *app,
+                      prte_list_t *node_list, prte_list_t *targets,
+                      prte_pointer_array_t *lookup)
+{
+    prte_node_t *node;
+    prte_rmaps_mincost_node_t *mn;
+    int nmapped = 0, avail, n;
+    bool progress;
+
+    if (PRTE_MAPPING_SPAN & jdata->map->mapping) {
+        do {
+            progress = false;
+            PRTE_LIST_FOREACH(node, node_list, prte_node_t) {
+                if (nmapped == app->num_procs) {
+                    break;
+                }
+                if (node->slots_available - pending(node, lookup) <= 0) {
+                    continue;
+                }
+                if (NULL == add_procs(jdata, node, app, 1, targets, lookup)) {
+                    return PRTE_ERR_OUT_OF_RESOURCE;
+                }
+                ++nmapped;
+                progress = true;
+            }
+        } while (progress && nmapped < app->num_procs);
+    } else {
+        PRTE_LIST_FOREACH(node, node_list, prte_node_t) {
+            if (nmapped == app->num_procs) {
+                break;
+            }
+            avail = node->slots_available - pending(node, lookup);
+            if (avail <= 0) {
+                continue;
+            }
+            n = (app->num_procs - nmapped) < avail ? (app->num_procs - nmapped) : avail;
+            if (NULL == add_procs(jdata, node, app, n, targets, lookup)) {
+                return PRTE_ERR_OUT_OF_RESOURCE;
+            }
+            nmapped += n;
+        }
+    }
+
+    if (nmapped < app->num_procs) {
+        if (PRTE_MAPPING_NO_OVERSUBSCRIBE & PRTE_GET_MAPPING_DIRECTIVE(jdata->map->mapping)) {
+            prte_show_help("help-prte-rmaps-base.txt", "prte-rmaps-base:alloc-error",
+                           true, app->num_procs, app->app);
+            PRTE_UPDATE_EXIT_STATUS(PRTE_ERROR_DEFAULT_EXIT_CODE);
+            return PRTE_ERR_SILENT;
+        }
+        while (nmapped < app->num_procs) {
+            PRTE_LIST_FOREACH(node, node_list, prte_node_t) {
+                if (nmapped == app->num_procs) {
+                    break;
+                }
+                if (NULL == (mn = add_procs(jdata, node, app, 1, targets, lookup))) {
+                    return PRTE_ERR_OUT_OF_RESOURCE;
+                }
+                mn->oversubscribed = true;
+                ++nmapped;
+            }
+        }
+    }
+
+    return PRTE_SUCCESS;
+}
+
+static int mincost_map(prte_job_t *jdata)
+{
+    prte_app_context_t *app;
+    prte_list_t node_list, targets;
+    prte_pointer_array_t lookup;
+    prte_rmaps_mincost_node_t *mn;
+    prte_node_t *node;
+    prte_proc_t *proc;
+    int32_t num_slots;
+    int i, j, n, p, rc;
+    bool initial_map = true;
+    bool *io = NULL, *procio;
+    char *device = NULL;
+    prte_mca_base_component_t *c = &prte_rmaps_mincost_component.super.base_version;
+
+    /* this mapper can only handle initial launch
+     * when mapping by distance is desired
+     */
+    if (PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_RESTART)) {
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:mincost: job %s is being restarted - mincost cannot map",
+                            PRTE_JOBID_PRINT(jdata->nspace));
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    if (NULL != jdata->map->req_mapper &&
+        0 != strcasecmp(jdata->map->req_mapper, c->mca_component_name)) {
+        /* a mapper has been specified, and it isn't me */
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:mincost: job %s not using mincost mapper",
+                            PRTE_JOBID_PRINT(jdata->nspace));
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+    if (PRTE_MAPPING_BYDIST != PRTE_GET_MAPPING_POLICY(jdata->map->mapping)) {
+        /* not me */
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:mincost: job %s not using mincost mapper",
+                            PRTE_JOBID_PRINT(jdata->nspace));
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps:mincost: mapping job %s",
+                        PRTE_JOBID_PRINT(jdata->nspace));
+
+    /* flag that I did the mapping */
+    if (NULL != jdata->map->last_mapper) {
+        free(jdata->map->last_mapper);
+    }
+    jdata->map->last_mapper = strdup(c->mca_component_name);
+
+    /* start at the beginning... */
+    jdata->num_procs = 0;
+
+    if (NULL == (io = get_io_apps(jdata))) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    device = get_device(jdata);
+
+    /* first decide how many procs from each app go on each node, so
+     * the placement on a node can consider the procs of all apps */
+    PRTE_CONSTRUCT(&node_list, prte_list_t);
+    PRTE_CONSTRUCT(&targets, prte_list_t);
+    PRTE_CONSTRUCT(&lookup, prte_pointer_array_t);
+    prte_pointer_array_init(&lookup, prte_node_pool->size, INT_MAX, 16);
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+
+        /* if the number of processes wasn't specified, then we know there can be only
+         * one app_context allowed in the launch, and that we are to launch it across
+         * all available slots. We'll double-check the single app_context rule first
+         */
+        if (0 == app->num_procs && 1 < jdata->num_apps) {
+            prte_show_help("help-prte-rmaps-mincost.txt", "multi-apps-and-zero-np",
+                           true, jdata->num_apps, NULL);
+            rc = PRTE_ERR_SILENT;
+            goto error;
+        }
+
+        /* for each app_context, we have to get the list of nodes that it can
+         * use since that can now be modified with a hostfile and/or -host
+         * option
+         */
+        if (PRTE_SUCCESS != (rc = prte_rmaps_base_get_target_nodes(&node_list, &num_slots, app,
+                                                                   jdata->map->mapping, initial_map, false))) {
+            PRTE_ERROR_LOG(rc);
+            goto error;
+        }
+        /* flag that all subsequent requests should not reset the node->mapped flag */
+        initial_map = false;
+        if (0 == prte_list_get_size(&node_list)) {
+            rc = PRTE_ERR_SILENT;
+            goto error;
+        }
+
+        /* if a bookmark exists from some prior mapping, set us to start there */
+        jdata->bookmark = prte_rmaps_base_get_starting_point(&node_list, jdata);
+
+        if (0 == app->num_procs) {
+            /* set the num_procs to equal the number of slots on these mapped nodes */
+            app->num_procs = num_slots;
+        }
+
+        if (PRTE_SUCCESS != (rc = distribute(jdata, app, &node_list, &targets, &lookup))) {
+            goto error;
+        }
+
+        /* track the total number of processes we mapped - must update
+         * this value AFTER we compute vpids so that computation
+         * is done correctly
+         */
+        jdata->num_procs += app->num_procs;
+
+        /* cleanup the node list - it can differ from one app_context
+         * to another, so we have to get it every time
+         */
+        PRTE_LIST_DESTRUCT(&node_list);
+        PRTE_CONSTRUCT(&node_list, prte_list_t);
+    }
+
+    /* solve the placement on every node before creating any procs so
+     * we can cleanly defer to another mapper */
+    PRTE_LIST_FOREACH(mn, &targets, prte_rmaps_mincost_node_t) {
+        node = mn->node;
+        if (NULL == node->topology || NULL == node->topology->topo) {
+            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-topology",
+                           true, node->name);
+            rc = PRTE_ERR_SILENT;
+            goto error;
+        }
+        mn->locales = (hwloc_obj_t*)calloc(mn->nprocs, sizeof(hwloc_obj_t));
+        procio = (bool*)calloc(mn->nprocs, sizeof(bool));
+        if (NULL == mn->locales || NULL == procio) {
+            if (NULL != procio) {
+                free(procio);
+            }
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto error;
+        }
+        p = 0;
+        for (j=0; j < jdata->apps->size; j++) {
+            for (n=0; n < mn->counts[j]; n++) {
+                procio[p++] = io[j];
+            }
+        }
+        rc = solve_node(jdata, node, device, mn->nprocs, procio, mn->locales);
+        free(procio);
+        if (PRTE_SUCCESS != rc) {
+            if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+                PRTE_SET_MAPPING_POLICY(jdata->map->mapping, PRTE_MAPPING_BYSLOT);
+            }
+            jdata->num_procs = 0;
+            goto error;
+        }
+    }
+
+    /* now create the procs */
+    PRTE_LIST_FOREACH(mn, &targets, prte_rmaps_mincost_node_t) {
+        node = mn->node;
+        if (!PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_MAPPED)) {
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_MAPPED);
+            PRTE_RETAIN(node);  /* maintain accounting on object */
+            jdata->map->num_nodes++;
+            prte_pointer_array_add(jdata->map->nodes, node);
+        }
+        if (mn->oversubscribed) {
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_OVERSUBSCRIBED);
+            PRTE_FLAG_SET(jdata, PRTE_JOB_FLAG_OVERSUBSCRIBED);
+        }
+        p = 0;
+        for (j=0; j < jdata->apps->size; j++) {
+            for (n=0; n < mn->counts[j]; n++) {
+                if (NULL == (proc = prte_rmaps_base_setup_proc(jdata, node, j))) {
+                    rc = PRTE_ERR_OUT_OF_RESOURCE;
+                    goto error;
+                }
+                prte_set_attribute(&proc->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_ATTR_LOCAL,
+                                   mn->locales[p++], PMIX_POINTER);
+            }
+        }
+        prte_output_verbose(2, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:mincost: assigned %d procs to node %s",
+                            mn->nprocs, node->name);
+    }
+    rc = PRTE_SUCCESS;
+
+  error:
+    PRTE_LIST_DESTRUCT(&node_list);
+    PRTE_LIST_DESTRUCT(&targets);
+    PRTE_DESTRUCT(&lookup);
+    free(io);
+    if (NULL != device) {
+        free(device);
+    }
+    return rc;
+}
+
+static int assign_locations(prte_job_t *jdata)
+{
+    int a, i, m, n, rc;
+    prte_node_t *node;
+    prte_proc_t *proc, **procs;
+    hwloc_obj_t *locales;
+    bool *io, *procio;
+    char *device;
+    prte_mca_base_component_t *c = &prte_rmaps_mincost_component.super.base_version;
+
+    if (NULL == jdata->map->last_mapper ||
+        0 != strcasecmp(jdata->map->last_mapper, c->mca_component_name)) {
+        /* the mapper should have been set to me */
+        prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                            "mca:rmaps:mincost: job %s not using mincost mapper",
+                            PRTE_JOBID_PRINT(jdata->nspace));
+        return PRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    prte_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "mca:rmaps:mincost: assign locations for job %s",
+                        PRTE_JOBID_PRINT(jdata->nspace));
+
+    if (NULL == (io = get_io_apps(jdata))) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    device = get_device(jdata);
+
+    rc = PRTE_SUCCESS;
+    for (m=0; m < jdata->map->nodes->size && PRTE_SUCCESS == rc; m++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(jdata->map->nodes, m))) {
+            continue;
+        }
+        if (NULL == node->topology || NULL == node->topology->topo) {
+            prte_show_help("help-prte-rmaps-base.txt", "rmaps:no-topology",
+                           true, node->name);
+            rc = PRTE_ERR_SILENT;
+            break;
+        }
+        procs = (prte_proc_t**)calloc(node->procs->size, sizeof(prte_proc_t*));
+        procio = (bool*)calloc(node->procs->size, sizeof(bool));
+        locales = (hwloc_obj_t*)calloc(node->procs->size, sizeof(hwloc_obj_t));
+        if (NULL == procs || NULL == procio || NULL == locales) {
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+        } else {
+            /* take the procs in the order the HNP placed them - by
+             * app, and in the order they were added within an app */
+            n = 0;
+            for (a=0; a < jdata->apps->size; a++) {
+                for (i=0; i < node->procs->size; i++) {
+                    if (NULL == (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, i))) {
+                        continue;
+                    }
+                    if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace) ||
+                        a != (int)proc->app_idx) {
+                        continue;
+                    }
+                    procs[n] = proc;
+                    procio[n] = io[a];
+                    ++n;
+                }
+            }
+            if (0 < n &&
+                PRTE_SUCCESS == (rc = solve_node(jdata, node, device, n, procio, locales))) {
+                for (i=0; i < n; i++) {
+                    prte_set_attribute(&procs[i]->attributes, PRTE_PROC_HWLOC_LOCALE, PRTE_ATTR_LOCAL,
+                                       locales[i], PMIX_POINTER);
+                }
+            }
+        }
+        if (NULL != procs) {
+            free(procs);
+        }
+        if (NULL != procio) {
+            free(procio);
+        }
+        if (NULL != locales) {
+            free(locales);
+        }
+    }
+    if (PRTE_ERR_TAKE_NEXT_OPTION == rc) {
+        PRTE_SET_MAPPING_POLICY(jdata->map->mapping, PRTE_MAPPING_BYSLOT);
+    }
+
+    free(io);
+    free(device);
+    return rc;
+}
@@ -604,6 +604,7 @@ static void prune(pmix_nspace_t jobid,
                                 "mca:rmaps:ppr: removing proc at posn %d",
                                 idxmax);
             prte_pointer_array_set_item(node->procs, idxmax, NULL);
+            prte_node_untrack_binding(procmax);
             node->num_procs--;
             node->slots_inuse--;
             if (node->slots_inuse < 0) {
@@ -327,6 +327,10 @@ static int prte_rmaps_rf_map(prte_job_t *jdata)
                 /* setup the bitmap */
                 hwloc_cpuset_t bitmap;
                 char *cpu_bitmap;
+                /* the topology is held compressed until it is needed */
+                if (NULL != node->topology) {
+                    prte_topology_import(node->topology);
+                }
                 if (NULL == node->topology || NULL == node->topology->topo) {
                     /* not allowed - for rank-file, we must have
                      * the topology info
@@ -375,6 +375,10 @@ static int prte_rmaps_seq_map(prte_job_t *jdata)
                                 "mca:rmaps:seq: assign proc %s to node %s for app %s",
                                 PRTE_VPID_PRINT(proc->name.rank), sq->hostname, app->app);
 
+            /* the topology is held compressed until it is needed */
+            if (NULL != node->topology) {
+                prte_topology_import(node->topology);
+            }
             /* record the cpuset, if given */
             if (NULL != sq->cpuset) {
                 hwloc_cpuset_t bitmap;
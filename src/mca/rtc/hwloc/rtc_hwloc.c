@@ -28,6 +28,15 @@
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
 #include <sys/mman.h>
+#ifdef HAVE_SCHED_H
+#include <sched.h>
+#endif
+#ifdef HAVE_SYS_SYSCALL_H
+#include <sys/syscall.h>
+#endif
+#ifdef HAVE_LINUX_MEMPOLICY_H
+#include <linux/mempolicy.h>
+#endif
 #ifdef HAVE_SYS_STAT_H
 #include <sys/stat.h>
 #endif
@@ -55,6 +64,25 @@
 #include "src/mca/rtc/base/base.h"
 #include "rtc_hwloc.h"
 
+#if defined(CPU_SETSIZE) && defined(SYS_set_mempolicy) && defined(HAVE_LINUX_MEMPOLICY_H)
+#define PRTE_RTC_HWLOC_DIRECT_BIND 1
+#include <hwloc/glibc-sched.h>
+
+#define PRTE_RTC_HWLOC_MAX_NODES  1024
+
+/* binding for a child as computed by the daemon before the fork,
+ * in the form expected by the kernel so that the child need not
+ * make any hwloc calls between fork and exec */
+typedef struct {
+    cpu_set_t cpus;
+    int mpolicy;
+    unsigned long maxnode;
+    unsigned long nodemask[PRTE_RTC_HWLOC_MAX_NODES / (8 * sizeof(unsigned long))];
+} prte_rtc_hwloc_affinity_t;
+#else
+#define PRTE_RTC_HWLOC_DIRECT_BIND 0
+#endif
+
 static int init(void);
 static void finalize(void);
 static void assign(prte_job_t *jdata);
@@ -217,13 +245,121 @@ static void finalize(void)
     return;
 }
 
+#if PRTE_RTC_HWLOC_DIRECT_BIND
+/* convert a cpuset string into the kernel-ready binding for a child */
+static int compute_affinity(const char *cpu_bitmap, prte_rtc_hwloc_affinity_t *aff)
+{
+    hwloc_cpuset_t cpuset;
+    hwloc_nodeset_t nodeset;
+    unsigned i, nulongs;
+    int rc = PRTE_ERROR;
+
+    memset(aff, 0, sizeof(*aff));
+
+    cpuset = hwloc_bitmap_alloc();
+    nodeset = hwloc_bitmap_alloc();
+    if (0 != hwloc_bitmap_list_sscanf(cpuset, cpu_bitmap) ||
+        CPU_SETSIZE <= hwloc_bitmap_last(cpuset)) {
+        goto cleanup;
+    }
+    if (0 != hwloc_cpuset_to_glibc_sched_affinity(prte_hwloc_topology, cpuset,
+                                                  &aff->cpus, sizeof(aff->cpus))) {
+        goto cleanup;
+    }
+
+    /* mirror prte_hwloc_base_set_process_membind_policy */
+    if (PRTE_HWLOC_BASE_MAP_LOCAL_ONLY == prte_hwloc_base_map) {
+        hwloc_cpuset_to_nodeset(prte_hwloc_topology, cpuset, nodeset);
+        if (hwloc_bitmap_iszero(nodeset) ||
+            PRTE_RTC_HWLOC_MAX_NODES <= hwloc_bitmap_last(nodeset)) {
+            goto cleanup;
+        }
+        aff->mpolicy = MPOL_BIND;
+        nulongs = (hwloc_bitmap_last(nodeset) / (8 * sizeof(unsigned long))) + 1;
+        for (i=0; i < nulongs; i++) {
+            aff->nodemask[i] = hwloc_bitmap_to_ith_ulong(nodeset, i);
+        }
+        /* the kernel ignores the last bit of maxnode */
+        aff->maxnode = nulongs * 8 * sizeof(unsigned long) + 1;
+    } else {
+        aff->mpolicy = MPOL_DEFAULT;
+    }
+    rc = PRTE_SUCCESS;
+
+  cleanup:
+    hwloc_bitmap_free(cpuset);
+    hwloc_bitmap_free(nodeset);
+    return rc;
+}
+
+/* precompute the binding of each local child of this job so the
+ * children need only issue the syscalls after they are forked */
+static void assign_affinity(prte_job_t *jdata)
+{
+    prte_proc_t *child;
+    prte_rtc_hwloc_affinity_t aff;
+    pmix_byte_object_t bo;
+    char *cpu_bitmap, *prev = NULL;
+    bool valid = false;
+    int i;
+
+    if (NULL == prte_hwloc_topology) {
+        return;
+    }
+
+    bo.bytes = (char*)&aff;
+    bo.size = sizeof(aff);
+    for (i=0; i < prte_local_children->size; i++) {
+        if (NULL == (child = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i))) {
+            continue;
+        }
+        if (!PMIX_CHECK_NSPACE(child->name.nspace, jdata->nspace)) {
+            continue;
+        }
+        cpu_bitmap = NULL;
+        if (!prte_get_attribute(&child->attributes, PRTE_PROC_CPU_BITMAP, (void**)&cpu_bitmap, PMIX_STRING) ||
+            NULL == cpu_bitmap || 0 == strlen(cpu_bitmap)) {
+            /* nothing to precompute - let the child do whatever
+             * is required for an unbound proc */
+            prte_remove_attribute(&child->attributes, PRTE_PROC_CPU_AFFINITY);
+            free(cpu_bitmap);
+            continue;
+        }
+        /* most children share a small number of distinct cpusets
+         * and are usually adjacent, so only recompute on change */
+        if (NULL == prev || 0 != strcmp(prev, cpu_bitmap)) {
+            free(prev);
+            prev = cpu_bitmap;
+            valid = (PRTE_SUCCESS == compute_affinity(cpu_bitmap, &aff));
+        } else {
+            free(cpu_bitmap);
+        }
+        if (valid) {
+            prte_set_attribute(&child->attributes, PRTE_PROC_CPU_AFFINITY,
+                               PRTE_ATTR_LOCAL, &bo, PMIX_BYTE_OBJECT);
+        } else {
+            prte_remove_attribute(&child->attributes, PRTE_PROC_CPU_AFFINITY);
+        }
+    }
+    free(prev);
+}
+#endif
+
 static void assign(prte_job_t *jdata)
 {
 #if PMIX_VERSION_MAJOR < 4
 #if HWLOC_API_VERSION >= 0x20000
     prte_list_t *cache;
     prte_value_t *kv;
+#endif
+#endif
+
+#if PRTE_RTC_HWLOC_DIRECT_BIND
+    assign_affinity(jdata);
+#endif
 
+#if PMIX_VERSION_MAJOR < 4
+#if HWLOC_API_VERSION >= 0x20000
     if (VM_HOLE_NONE == prte_rtc_hwloc_component.kind ||
         NULL == shmemfile) {
         return;
@@ -274,6 +410,9 @@ static void set(prte_job_t *jobdat,
     int rc=PRTE_ERROR;
     char *msg;
     char *cpu_bitmap;
+#if PRTE_RTC_HWLOC_DIRECT_BIND
+    pmix_byte_object_t *bo = NULL;
+#endif
 
     prte_output_verbose(2, prte_rtc_base_framework.framework_output,
                         "%s hwloc:set on child %s",
@@ -292,6 +431,28 @@ static void set(prte_job_t *jobdat,
 
     context = (prte_app_context_t*)prte_pointer_array_get_item(jobdat->apps, child->app_idx);
 
+#if PRTE_RTC_HWLOC_DIRECT_BIND
+    /* if the daemon precomputed our binding, then just apply it. Should
+     * anything go wrong, fall thru to the full procedure so that any
+     * error gets properly reported */
+    if (prte_get_attribute(&child->attributes, PRTE_PROC_CPU_AFFINITY, (void**)&bo, PMIX_BYTE_OBJECT) &&
+        NULL != bo) {
+        prte_rtc_hwloc_affinity_t *aff = (prte_rtc_hwloc_affinity_t*)bo->bytes;
+        if (sizeof(*aff) == bo->size &&
+            0 == sched_setaffinity(0, sizeof(aff->cpus), &aff->cpus) &&
+            0 == syscall(SYS_set_mempolicy, aff->mpolicy,
+                         (MPOL_DEFAULT == aff->mpolicy) ? NULL : aff->nodemask,
+                         (MPOL_DEFAULT == aff->mpolicy) ? 0 : aff->maxnode)) {
+            PMIX_BYTE_OBJECT_FREE(bo, 1);
+            if (prte_get_attribute(&jobdat->attributes, PRTE_JOB_REPORT_BINDINGS, NULL, PMIX_BOOL)) {
+                report_binding(jobdat, child->name.rank);
+            }
+            return;
+        }
+        PMIX_BYTE_OBJECT_FREE(bo, 1);
+    }
+#endif
+
     /* Set process affinity, if given */
     cpu_bitmap = NULL;
     if (!prte_get_attribute(&child->attributes, PRTE_PROC_CPU_BITMAP, (void**)&cpu_bitmap, PMIX_STRING) ||
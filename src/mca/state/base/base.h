@@ -40,9 +40,29 @@ PRTE_EXPORT void prte_state_base_print_job_state_machine(void);
 
 PRTE_EXPORT void prte_state_base_print_proc_state_machine(void);
 
+/* Batched proc state updates - collect the updates for the procs of
+ * one job in a batch and then activate them in a single event. The
+ * job-level accounting (e.g., checking if all procs have launched)
+ * is performed once for the entire batch. Activation takes ownership
+ * of the batch */
+PRTE_EXPORT prte_state_batch_t* prte_state_base_batch_create(prte_job_t *jdata);
+
+PRTE_EXPORT int prte_state_base_batch_add(prte_state_batch_t *batch,
+                                          pmix_rank_t rank,
+                                          prte_proc_state_t state);
+
+PRTE_EXPORT void prte_state_base_activate_proc_states(prte_state_batch_t *batch);
+
 PRTE_EXPORT extern int prte_state_base_parent_fd;
 PRTE_EXPORT extern bool prte_state_base_ready_msg;
 
+/* Version of the state machine - incremented whenever a job or proc
+ * state is activated and again once the state has been processed, so
+ * anything derived from the job and proc data is known to be current
+ * as long as the version has not changed. Each proc is also stamped
+ * with the version at which its state last changed */
+PRTE_EXPORT extern uint64_t prte_state_base_version;
+
 END_C_DECLS
 
 #endif
@@ -50,51 +50,142 @@
 #include "src/mca/state/base/base.h"
 #include "src/mca/state/base/state_private.h"
 
-void prte_state_base_activate_job_state(prte_job_t *jdata,
-                                        prte_job_state_t state)
+/* The state lists were searched on every activation, so keep a
+ * table giving direct access to the handler of each state within
+ * the table's range, plus the ANY and ERROR handlers used for states
+ * that have no handler of their own. The tables hold a reference to
+ * each entry so they can never point to a released object. States
+ * outside the range are still found by searching the lists */
+#define PRTE_STATE_TABLE_SIZE   256
+
+static prte_state_t *job_state_table[PRTE_STATE_TABLE_SIZE] = {NULL};
+static prte_state_t *job_state_any = NULL;
+static prte_state_t *job_state_error = NULL;
+static prte_state_t *proc_state_table[PRTE_STATE_TABLE_SIZE] = {NULL};
+static prte_state_t *proc_state_any = NULL;
+static prte_state_t *proc_state_error = NULL;
+
+static void table_store(prte_state_t **slot, prte_state_t *st)
+{
+    if (NULL != *slot) {
+        PRTE_RELEASE(*slot);
+    }
+    if (NULL != st) {
+        PRTE_RETAIN(st);
+    }
+    *slot = st;
+}
+
+static void job_table_update(prte_job_state_t state, prte_state_t *st)
+{
+    if (PRTE_JOB_STATE_ANY == state) {
+        table_store(&job_state_any, st);
+    } else if (0 <= state && state < PRTE_STATE_TABLE_SIZE) {
+        table_store(&job_state_table[state], st);
+        if (PRTE_JOB_STATE_ERROR == state) {
+            table_store(&job_state_error, st);
+        }
+    }
+}
+
+static prte_state_t* job_state_lookup(prte_job_state_t state)
 {
-    prte_list_item_t *itm, *any=NULL, *error=NULL;
+    prte_list_item_t *itm;
     prte_state_t *s;
-    prte_state_caddy_t *caddy;
 
+    if (0 <= state && state < PRTE_STATE_TABLE_SIZE) {
+        return job_state_table[state];
+    }
     for (itm = prte_list_get_first(&prte_job_states);
          itm != prte_list_get_end(&prte_job_states);
          itm = prte_list_get_next(itm)) {
         s = (prte_state_t*)itm;
-        if (s->job_state == PRTE_JOB_STATE_ANY) {
-            /* save this place */
-            any = itm;
+        if (s->job_state == state) {
+            return s;
         }
-        if (s->job_state == PRTE_JOB_STATE_ERROR) {
-            error = itm;
+    }
+    return NULL;
+}
+
+static void proc_table_update(prte_proc_state_t state, prte_state_t *st)
+{
+    if (PRTE_PROC_STATE_ANY == state) {
+        table_store(&proc_state_any, st);
+    } else if (state < PRTE_STATE_TABLE_SIZE) {
+        table_store(&proc_state_table[state], st);
+        if (PRTE_PROC_STATE_ERROR == state) {
+            table_store(&proc_state_error, st);
         }
-        if (s->job_state == state) {
-            PRTE_REACHING_JOB_STATE(jdata, state, s->priority);
-            if (NULL == s->cbfunc) {
-                PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR JOB %s STATE %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     (NULL == jdata) ? "ALL" : PRTE_JOBID_PRINT(jdata->nspace),
-                                     prte_job_state_to_str(state)));
-                return;
-            }
-            caddy = PRTE_NEW(prte_state_caddy_t);
-            if (NULL != jdata) {
-                caddy->jdata = jdata;
-                caddy->job_state = state;
-                PRTE_RETAIN(jdata);
-            }
-            PRTE_THREADSHIFT(caddy, prte_event_base, s->cbfunc, s->priority);
+    }
+}
+
+static prte_state_t* proc_state_lookup(prte_proc_state_t state)
+{
+    prte_list_item_t *itm;
+    prte_state_t *s;
+
+    if (state < PRTE_STATE_TABLE_SIZE) {
+        return proc_state_table[state];
+    }
+    for (itm = prte_list_get_first(&prte_proc_states);
+         itm != prte_list_get_end(&prte_proc_states);
+         itm = prte_list_get_next(itm)) {
+        s = (prte_state_t*)itm;
+        if (s->proc_state == state) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+void prte_state_base_clear_state_tables(void)
+{
+    int n;
+
+    for (n=0; n < PRTE_STATE_TABLE_SIZE; n++) {
+        table_store(&job_state_table[n], NULL);
+        table_store(&proc_state_table[n], NULL);
+    }
+    table_store(&job_state_any, NULL);
+    table_store(&job_state_error, NULL);
+    table_store(&proc_state_any, NULL);
+    table_store(&proc_state_error, NULL);
+}
+
+void prte_state_base_activate_job_state(prte_job_t *jdata,
+                                        prte_job_state_t state)
+{
+    prte_state_t *s;
+    prte_state_caddy_t *caddy;
+
+    ++prte_state_base_version;
+
+    if (NULL != (s = job_state_lookup(state))) {
+        PRTE_REACHING_JOB_STATE(jdata, state, s->priority);
+        if (NULL == s->cbfunc) {
+            PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                                 "%s NULL CBFUNC FOR JOB %s STATE %s",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                 (NULL == jdata) ? "ALL" : PRTE_JOBID_PRINT(jdata->nspace),
+                                 prte_job_state_to_str(state)));
             return;
         }
+        caddy = PRTE_NEW(prte_state_caddy_t);
+        if (NULL != jdata) {
+            caddy->jdata = jdata;
+            caddy->job_state = state;
+            PRTE_RETAIN(jdata);
+        }
+        PRTE_THREADSHIFT(caddy, prte_event_base, s->cbfunc, s->priority);
+        return;
     }
     /* if we get here, then the state wasn't found, so execute
      * the default handler if it is defined
      */
-    if (PRTE_JOB_STATE_ERROR < state && NULL != error) {
-        s = (prte_state_t*)error;
-    } else if (NULL != any) {
-        s = (prte_state_t*)any;
+    if (PRTE_JOB_STATE_ERROR < state && NULL != job_state_error) {
+        s = job_state_error;
+    } else if (NULL != job_state_any) {
+        s = job_state_any;
     } else {
         PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
                              "ACTIVATE: JOB STATE %s NOT REGISTERED", prte_job_state_to_str(state)));
@@ -141,6 +232,7 @@ int prte_state_base_add_job_state(prte_job_state_t state,
     st->cbfunc = cbfunc;
     st->priority = priority;
     prte_list_append(&prte_job_states, &(st->super));
+    job_table_update(state, st);
 
     return PRTE_SUCCESS;
 }
@@ -167,6 +259,7 @@ int prte_state_base_set_job_state_callback(prte_job_state_t state,
     st->cbfunc = cbfunc;
     st->priority = PRTE_SYS_PRI;
     prte_list_append(&prte_job_states, &(st->super));
+    job_table_update(state, st);
 
     return PRTE_SUCCESS;
 }
@@ -199,6 +292,7 @@ int prte_state_base_remove_job_state(prte_job_state_t state)
          item = prte_list_get_next(item)) {
         st = (prte_state_t*)item;
         if (st->job_state == state) {
+            job_table_update(state, NULL);
             prte_list_remove_item(&prte_job_states, item);
             PRTE_RELEASE(item);
             return PRTE_SUCCESS;
@@ -228,45 +322,38 @@ void prte_state_base_print_job_state_machine(void)
 void prte_state_base_activate_proc_state(pmix_proc_t *proc,
                                          prte_proc_state_t state)
 {
-    prte_list_item_t *itm, *any=NULL, *error=NULL;
     prte_state_t *s;
     prte_state_caddy_t *caddy;
+    prte_proc_t *pptr;
 
-    for (itm = prte_list_get_first(&prte_proc_states);
-         itm != prte_list_get_end(&prte_proc_states);
-         itm = prte_list_get_next(itm)) {
-        s = (prte_state_t*)itm;
-        if (s->proc_state == PRTE_PROC_STATE_ANY) {
-            /* save this place */
-            any = itm;
-        }
-        if (s->proc_state == PRTE_PROC_STATE_ERROR) {
-            error = itm;
-        }
-        if (s->proc_state == state) {
-            PRTE_REACHING_PROC_STATE(proc, state, s->priority);
-            if (NULL == s->cbfunc) {
-                PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR PROC %s STATE %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     PRTE_NAME_PRINT(proc),
-                                     prte_proc_state_to_str(state)));
-                return;
-            }
-            caddy = PRTE_NEW(prte_state_caddy_t);
-            caddy->name = *proc;
-            caddy->proc_state = state;
-            PRTE_THREADSHIFT(caddy, prte_event_base, s->cbfunc, s->priority);
+    ++prte_state_base_version;
+    if (NULL != (pptr = prte_get_proc_object(proc))) {
+        pptr->state_version = prte_state_base_version;
+    }
+
+    if (NULL != (s = proc_state_lookup(state))) {
+        PRTE_REACHING_PROC_STATE(proc, state, s->priority);
+        if (NULL == s->cbfunc) {
+            PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                                 "%s NULL CBFUNC FOR PROC %s STATE %s",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                 PRTE_NAME_PRINT(proc),
+                                 prte_proc_state_to_str(state)));
             return;
         }
+        caddy = PRTE_NEW(prte_state_caddy_t);
+        caddy->name = *proc;
+        caddy->proc_state = state;
+        PRTE_THREADSHIFT(caddy, prte_event_base, s->cbfunc, s->priority);
+        return;
     }
     /* if we get here, then the state wasn't found, so execute
      * the default handler if it is defined
      */
-    if (PRTE_PROC_STATE_ERROR < state && NULL != error) {
-        s = (prte_state_t*)error;
-    } else if (NULL != any) {
-        s = (prte_state_t*)any;
+    if (PRTE_PROC_STATE_ERROR < state && NULL != proc_state_error) {
+        s = proc_state_error;
+    } else if (NULL != proc_state_any) {
+        s = proc_state_any;
     } else {
         PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
                              "INCREMENT: ANY STATE NOT FOUND"));
@@ -309,6 +396,7 @@ int prte_state_base_add_proc_state(prte_proc_state_t state,
     st->cbfunc = cbfunc;
     st->priority = priority;
     prte_list_append(&prte_proc_states, &(st->super));
+    proc_table_update(state, st);
 
     return PRTE_SUCCESS;
 }
@@ -359,6 +447,7 @@ int prte_state_base_remove_proc_state(prte_proc_state_t state)
          item = prte_list_get_next(item)) {
         st = (prte_state_t*)item;
         if (st->proc_state == state) {
+            proc_table_update(state, NULL);
             prte_list_remove_item(&prte_proc_states, item);
             PRTE_RELEASE(item);
             return PRTE_SUCCESS;
@@ -582,41 +671,15 @@ static void _send_notification(int status,
     }
 }
 
-static void opcbfunc(pmix_status_t status, void *cbdata)
-{
-    prte_pmix_lock_t *lock = (prte_pmix_lock_t*)cbdata;
-    PRTE_PMIX_WAKEUP_THREAD(lock);
-}
-
-void prte_state_base_track_procs(int fd, short argc, void *cbdata)
+/* update the tracking of a single proc - any job-level
+ * consequences are handled by track_job */
+static void track_proc(prte_job_t *jdata, prte_proc_t *pdata,
+                       prte_proc_state_t state)
 {
-    prte_state_caddy_t *caddy = (prte_state_caddy_t*)cbdata;
-    pmix_proc_t *proc;
-    prte_proc_state_t state;
-    prte_job_t *jdata;
-    prte_proc_t *pdata;
+    pmix_proc_t *proc = &pdata->name;
+    prte_proc_t *child;
     int i;
-    pmix_proc_t parent, target;
-    prte_pmix_lock_t lock;
-
-    PRTE_ACQUIRE_OBJECT(caddy);
-    proc = &caddy->name;
-    state = caddy->proc_state;
-
-    prte_output_verbose(5, prte_state_base_framework.framework_output,
-                        "%s state:base:track_procs called for proc %s state %s",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                        PRTE_NAME_PRINT(proc),
-                        prte_proc_state_to_str(state));
-
-    /* get the job object for this proc */
-    if (NULL == (jdata = prte_get_job_data_object(proc->nspace))) {
-        goto cleanup;
-    }
-    pdata = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, proc->rank);
-    if (NULL == pdata) {
-        goto cleanup;
-    }
+    pmix_proc_t parent;
 
     if (PRTE_PROC_STATE_RUNNING == state) {
         /* update the proc state */
@@ -624,21 +687,12 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
             pdata->state = state;
         }
         jdata->num_launched++;
-        if (1 == jdata->num_launched) {
-            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_STARTED);
-        }
-        if (jdata->num_launched == jdata->num_procs) {
-            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_RUNNING);
-        }
     } else if (PRTE_PROC_STATE_REGISTERED == state) {
         /* update the proc state */
         if (pdata->state < PRTE_PROC_STATE_TERMINATED) {
             pdata->state = state;
         }
         jdata->num_reported++;
-        if (jdata->num_reported == jdata->num_procs) {
-            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_REGISTERED);
-        }
     } else if (PRTE_PROC_STATE_IOF_COMPLETE == state) {
         /* update the proc state */
         if (pdata->state < PRTE_PROC_STATE_TERMINATED) {
@@ -668,7 +722,7 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                  PRTE_NAME_PRINT(proc),
                                  prte_proc_state_to_str(state));
-            goto cleanup;
+            return;
         }
 
         /* update the proc state */
@@ -677,10 +731,9 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
             pdata->state = state;
         }
         if (PRTE_FLAG_TEST(pdata, PRTE_PROC_FLAG_LOCAL)) {
-            PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-            PMIx_server_deregister_client(proc, opcbfunc, &lock);
-            PRTE_PMIX_WAIT_THREAD(&lock);
-            PRTE_PMIX_DESTRUCT_LOCK(&lock);
+            /* PMIx copies the proc and processes requests in order,
+             * so there is no need to wait for this to complete */
+            PMIx_server_deregister_client(proc, prte_pmix_nowait_cbfunc, NULL);
 
             /* Clean up the session directory as if we were the process
              * itself.  This covers the case where the process died abnormally
@@ -698,10 +751,10 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
         if (prte_prteds_term_ordered &&
             0 == prte_routed.num_routes()) {
             for (i=0; i < prte_local_children->size; i++) {
-                if (NULL != (pdata = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i)) &&
-                    PRTE_FLAG_TEST(pdata, PRTE_PROC_FLAG_ALIVE)) {
+                if (NULL != (child = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i)) &&
+                    PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_ALIVE)) {
                     /* at least one is still alive */
-                    goto cleanup;
+                    return;
                 }
             }
             /* call our appropriate exit procedure */
@@ -709,24 +762,13 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
                                  "%s state:base all routes and children gone - exiting",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_DAEMONS_TERMINATED);
-            goto cleanup;
+            return;
         }
         /* track job status */
         jdata->num_terminated++;
-        if (jdata->num_terminated == jdata->num_procs) {
-            /* if requested, check fd status for leaks */
-            if (prte_state_base_run_fdcheck) {
-                prte_state_base_check_fds(jdata);
-            }
-            /* if ompi-server is around, then notify it to purge
-             * any session-related info */
-            if (NULL != prte_data_server_uri) {
-                PMIX_LOAD_PROCID(&target, jdata->nspace, PMIX_RANK_WILDCARD);
-                prte_state_base_notify_data_server(&target);
-            }
-            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_TERMINATED);
-        } else if (PRTE_PROC_STATE_TERMINATED < pdata->state &&
-                   !prte_job_term_ordered) {
+        if (jdata->num_terminated != jdata->num_procs &&
+            PRTE_PROC_STATE_TERMINATED < pdata->state &&
+            !prte_job_term_ordered) {
             /* if this was an abnormal term, notify the other procs of the termination */
             PMIX_LOAD_PROCID(&parent, jdata->nspace, PMIX_RANK_WILDCARD);
 
@@ -737,11 +779,187 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
             }
         }
     }
+}
+
+/* check for job-level transitions caused by proc updates, given
+ * the job's counters from before the updates were applied */
+static void track_job(prte_job_t *jdata, pmix_rank_t launched,
+                      pmix_rank_t reported, pmix_rank_t terminated)
+{
+    pmix_proc_t target;
+
+    if (launched != jdata->num_launched) {
+        if (0 == launched) {
+            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_STARTED);
+        }
+        if (launched < jdata->num_procs &&
+            jdata->num_procs <= jdata->num_launched) {
+            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_RUNNING);
+        }
+    }
+    if (reported < jdata->num_procs &&
+        jdata->num_procs <= jdata->num_reported) {
+        PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_REGISTERED);
+    }
+    if (terminated < jdata->num_procs &&
+        jdata->num_procs <= jdata->num_terminated) {
+        /* if requested, check fd status for leaks */
+        if (prte_state_base_run_fdcheck) {
+            prte_state_base_check_fds(jdata);
+        }
+        /* if ompi-server is around, then notify it to purge
+         * any session-related info */
+        if (NULL != prte_data_server_uri) {
+            PMIX_LOAD_PROCID(&target, jdata->nspace, PMIX_RANK_WILDCARD);
+            prte_state_base_notify_data_server(&target);
+        }
+        PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_TERMINATED);
+    }
+}
+
+void prte_state_base_track_procs(int fd, short argc, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t*)cbdata;
+    pmix_proc_t *proc;
+    prte_proc_state_t state;
+    prte_job_t *jdata;
+    prte_proc_t *pdata;
+    pmix_rank_t launched, reported, terminated;
+
+    PRTE_ACQUIRE_OBJECT(caddy);
+    proc = &caddy->name;
+    state = caddy->proc_state;
+
+    prte_output_verbose(5, prte_state_base_framework.framework_output,
+                        "%s state:base:track_procs called for proc %s state %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        PRTE_NAME_PRINT(proc),
+                        prte_proc_state_to_str(state));
+
+    /* get the job object for this proc */
+    if (NULL == (jdata = prte_get_job_data_object(proc->nspace))) {
+        goto cleanup;
+    }
+    pdata = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, proc->rank);
+    if (NULL == pdata) {
+        goto cleanup;
+    }
+
+    launched = jdata->num_launched;
+    reported = jdata->num_reported;
+    terminated = jdata->num_terminated;
+    track_proc(jdata, pdata, state);
+    track_job(jdata, launched, reported, terminated);
 
  cleanup:
     PRTE_RELEASE(caddy);
 }
 
+static void track_proc_batch(int fd, short argc, void *cbdata)
+{
+    prte_state_batch_t *batch = (prte_state_batch_t*)cbdata;
+    prte_job_t *jdata;
+    prte_proc_t *pdata;
+    prte_state_t *s;
+    pmix_proc_t name;
+    pmix_rank_t launched, reported, terminated;
+    int32_t n;
+
+    PRTE_ACQUIRE_OBJECT(batch);
+    jdata = batch->jdata;
+
+    prte_output_verbose(5, prte_state_base_framework.framework_output,
+                        "%s state:base:track_procs called for %d procs of job %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        batch->num, PRTE_JOBID_PRINT(jdata->nspace));
+
+    launched = jdata->num_launched;
+    reported = jdata->num_reported;
+    terminated = jdata->num_terminated;
+    PMIX_LOAD_NSPACE(name.nspace, jdata->nspace);
+
+    for (n=0; n < batch->num; n++) {
+        name.rank = batch->ranks[n];
+        s = proc_state_lookup(batch->states[n]);
+        if (NULL == s || prte_state_base_track_procs != s->cbfunc) {
+            /* someone else handles this state, so pass it
+             * thru the state machine as usual */
+            PRTE_ACTIVATE_PROC_STATE(&name, batch->states[n]);
+            continue;
+        }
+        pdata = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, name.rank);
+        if (NULL == pdata) {
+            continue;
+        }
+        PRTE_REACHING_PROC_STATE(&name, batch->states[n], s->priority);
+        track_proc(jdata, pdata, batch->states[n]);
+    }
+    track_job(jdata, launched, reported, terminated);
+
+    PRTE_RELEASE(batch);
+}
+
+prte_state_batch_t* prte_state_base_batch_create(prte_job_t *jdata)
+{
+    prte_state_batch_t *batch;
+
+    batch = PRTE_NEW(prte_state_batch_t);
+    PRTE_RETAIN(jdata);
+    batch->jdata = jdata;
+    return batch;
+}
+
+int prte_state_base_batch_add(prte_state_batch_t *batch,
+                              pmix_rank_t rank,
+                              prte_proc_state_t state)
+{
+    pmix_rank_t *ranks;
+    prte_proc_state_t *states;
+    int32_t size;
+
+    if (batch->num == batch->size) {
+        size = (0 == batch->size) ? 32 : 2 * batch->size;
+        ranks = (pmix_rank_t*)realloc(batch->ranks, size * sizeof(pmix_rank_t));
+        if (NULL == ranks) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        batch->ranks = ranks;
+        states = (prte_proc_state_t*)realloc(batch->states, size * sizeof(prte_proc_state_t));
+        if (NULL == states) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        batch->states = states;
+        batch->size = size;
+    }
+    batch->ranks[batch->num] = rank;
+    batch->states[batch->num] = state;
+    batch->num++;
+    return PRTE_SUCCESS;
+}
+
+void prte_state_base_activate_proc_states(prte_state_batch_t *batch)
+{
+    prte_proc_t *pptr;
+    int32_t n;
+
+    if (0 == batch->num) {
+        PRTE_RELEASE(batch);
+        return;
+    }
+    ++prte_state_base_version;
+    for (n=0; n < batch->num; n++) {
+        pptr = (prte_proc_t*)prte_pointer_array_get_item(batch->jdata->procs, batch->ranks[n]);
+        if (NULL != pptr) {
+            pptr->state_version = prte_state_base_version;
+        }
+    }
+    PRTE_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                         "%s ACTIVATE %d PROC STATES FOR JOB %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), batch->num,
+                         PRTE_JOBID_PRINT(batch->jdata->nspace)));
+    PRTE_THREADSHIFT(batch, prte_event_base, track_proc_batch, PRTE_SYS_PRI);
+}
+
 void prte_state_base_check_all_complete(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t*)cbdata;
@@ -756,7 +974,6 @@ void prte_state_base_check_all_complete(int fd, short args, void *cbdata)
     bool one_still_alive;
     pmix_rank_t lowest=0;
     int32_t i32, *i32ptr;
-    prte_pmix_lock_t lock;
 
     PRTE_ACQUIRE_OBJECT(caddy);
     jdata = caddy->jdata;
@@ -786,11 +1003,9 @@ void prte_state_base_check_all_complete(int fd, short args, void *cbdata)
         prte_iof.complete(jdata);
     }
 
-    /* tell the PMIx server to release its data */
-    PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-    PMIx_server_deregister_nspace(jdata->nspace, opcbfunc, &lock);
-    PRTE_PMIX_WAIT_THREAD(&lock);
-    PRTE_PMIX_DESTRUCT_LOCK(&lock);
+    /* tell the PMIx server to release its data - it copies the
+     * nspace, so we don't need to wait for it */
+    PMIx_server_deregister_nspace(jdata->nspace, prte_pmix_nowait_cbfunc, NULL);
 
     i32ptr = &i32;
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_NUM_NONZERO_EXIT, (void**)&i32ptr, PMIX_INT32) && !prte_abort_non_zero_exit) {
@@ -886,6 +1101,7 @@ void prte_state_base_check_all_complete(int fd, short args, void *cbdata)
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                      PRTE_NAME_PRINT(&proc->name), node->name));
                 /* set the entry in the node array to NULL */
+                prte_node_untrack_binding(proc);
                 prte_pointer_array_set_item(node->procs, i, NULL);
                 /* release the proc once for the map entry */
                 PRTE_RELEASE(proc);
@@ -46,6 +46,7 @@ prte_state_base_module_t prte_state = {0};
 bool prte_state_base_run_fdcheck = false;
 int prte_state_base_parent_fd = -1;
 bool prte_state_base_ready_msg = true;
+uint64_t prte_state_base_version = 0;
 
 static int prte_state_base_register(prte_mca_base_register_flag_t flags)
 {
@@ -67,6 +68,7 @@ static int prte_state_base_close(void)
     if (NULL != prte_state.finalize) {
         prte_state.finalize();
     }
+    prte_state_base_clear_state_tables();
 
     return prte_mca_base_framework_components_close(&prte_state_base_framework, NULL);
 }
@@ -106,6 +108,8 @@ static void prte_state_caddy_construct(prte_state_caddy_t *caddy)
 }
 static void prte_state_caddy_destruct(prte_state_caddy_t *caddy)
 {
+    /* the state has been processed */
+    ++prte_state_base_version;
     prte_event_del(&caddy->ev);
     if (NULL != caddy->jdata) {
         PRTE_RELEASE(caddy->jdata);
@@ -115,3 +119,32 @@ PRTE_CLASS_INSTANCE(prte_state_caddy_t,
                    prte_object_t,
                    prte_state_caddy_construct,
                    prte_state_caddy_destruct);
+
+static void prte_state_batch_construct(prte_state_batch_t *batch)
+{
+    memset(&batch->ev, 0, sizeof(prte_event_t));
+    batch->jdata = NULL;
+    batch->ranks = NULL;
+    batch->states = NULL;
+    batch->num = 0;
+    batch->size = 0;
+}
+static void prte_state_batch_destruct(prte_state_batch_t *batch)
+{
+    /* the states have been processed */
+    ++prte_state_base_version;
+    prte_event_del(&batch->ev);
+    if (NULL != batch->jdata) {
+        PRTE_RELEASE(batch->jdata);
+    }
+    if (NULL != batch->ranks) {
+        free(batch->ranks);
+    }
+    if (NULL != batch->states) {
+        free(batch->states);
+    }
+}
+PRTE_CLASS_INSTANCE(prte_state_batch_t,
+                   prte_object_t,
+                   prte_state_batch_construct,
+                   prte_state_batch_destruct);
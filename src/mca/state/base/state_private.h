@@ -75,6 +75,9 @@ PRTE_EXPORT int prte_state_base_remove_proc_state(prte_proc_state_t state);
 
 PRTE_EXPORT void prte_util_print_proc_state_machine(void);
 
+/* drop the direct-dispatch tables of registered states */
+PRTE_EXPORT void prte_state_base_clear_state_tables(void);
+
 /* common state processing functions */
 PRTE_EXPORT void prte_state_base_local_launch_complete(int fd, short argc, void *cbdata);
 PRTE_EXPORT void prte_state_base_cleanup_job(int fd, short argc, void *cbdata);
@@ -419,14 +419,6 @@ static void ready_for_debug(int fd, short args, void *cbdata)
     PRTE_RELEASE(caddy);
 }
 
-static void opcbfunc(pmix_status_t status, void *cbdata)
-{
-    prte_pmix_lock_t *lk = (prte_pmix_lock_t*)cbdata;
-
-    PRTE_POST_OBJECT(lk);
-    lk->status = prte_pmix_convert_status(status);
-    PRTE_PMIX_WAKEUP_THREAD(lk);
-}
 static void check_complete(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t*)cbdata;
@@ -437,7 +429,6 @@ static void check_complete(int fd, short args, void *cbdata)
     prte_job_map_t *map;
     int32_t index;
     pmix_proc_t pname;
-    prte_pmix_lock_t lock;
     uint8_t command = PRTE_PMIX_PURGE_PROC_CMD;
     pmix_data_buffer_t *buf;
     prte_pointer_array_t procs;
@@ -510,11 +501,9 @@ static void check_complete(int fd, short args, void *cbdata)
         prte_iof.complete(jdata);
     }
 
-    /* tell the PMIx subsystem the job is complete */
-    PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-    PMIx_server_deregister_nspace(pname.nspace, opcbfunc, &lock);
-    PRTE_PMIX_WAIT_THREAD(&lock);
-    PRTE_PMIX_DESTRUCT_LOCK(&lock);
+    /* tell the PMIx subsystem the job is complete - it copies
+     * the nspace, so we don't need to wait for it */
+    PMIx_server_deregister_nspace(pname.nspace, prte_pmix_nowait_cbfunc, NULL);
 
     if (!prte_persistent) {
         /* update our exit status */
@@ -643,6 +632,7 @@ static void check_complete(int fd, short args, void *cbdata)
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                      PRTE_NAME_PRINT(&proc->name), node->name));
                 /* set the entry in the node array to NULL */
+                prte_node_untrack_binding(proc);
                 prte_pointer_array_set_item(node->procs, i, NULL);
                 /* release the proc once for the map entry */
                 PRTE_RELEASE(proc);
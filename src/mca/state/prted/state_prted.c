@@ -358,14 +358,6 @@ static void track_jobs(int fd, short argc, void *cbdata)
     PRTE_RELEASE(caddy);
 }
 
-static void opcbfunc(pmix_status_t status, void *cbdata)
-{
-    prte_pmix_lock_t *lk = (prte_pmix_lock_t*)cbdata;
-
-    PRTE_POST_OBJECT(lk);
-    lk->status = prte_pmix_convert_status(status);
-    PRTE_PMIX_WAKEUP_THREAD(lk);
-}
 static void track_procs(int fd, short argc, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t*)cbdata;
@@ -380,7 +372,6 @@ static void track_procs(int fd, short argc, void *cbdata)
     prte_job_map_t *map;
     prte_node_t *node;
     pmix_proc_t target;
-    prte_pmix_lock_t lock;
 
     PRTE_ACQUIRE_OBJECT(caddy);
     proc = &caddy->name;
@@ -597,11 +588,9 @@ static void track_procs(int fd, short argc, void *cbdata)
                 prte_iof.complete(jdata);
             }
 
-            /* tell the PMIx subsystem the job is complete */
-            PRTE_PMIX_CONSTRUCT_LOCK(&lock);
-            PMIx_server_deregister_nspace(jdata->nspace, opcbfunc, &lock);
-            PRTE_PMIX_WAIT_THREAD(&lock);
-            PRTE_PMIX_DESTRUCT_LOCK(&lock);
+            /* tell the PMIx subsystem the job is complete - it copies
+             * the nspace, so we don't need to wait for it */
+            PMIx_server_deregister_nspace(jdata->nspace, prte_pmix_nowait_cbfunc, NULL);
 
             /* release the resources */
             if (NULL != jdata->map) {
@@ -632,6 +621,7 @@ static void track_procs(int fd, short argc, void *cbdata)
                                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                              PRTE_NAME_PRINT(&pptr->name), node->name));
                         /* set the entry in the node array to NULL */
+                        prte_node_untrack_binding(pptr);
                         prte_pointer_array_set_item(node->procs, i, NULL);
                         /* release the proc once for the map entry */
                         PRTE_RELEASE(pptr);
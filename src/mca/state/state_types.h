@@ -76,5 +76,18 @@ typedef struct {
 } prte_state_caddy_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_state_caddy_t);
 
+/* caddy for passing a set of proc state updates for a
+ * single job to the state machine in one event */
+typedef struct {
+    prte_object_t super;
+    prte_event_t ev;
+    prte_job_t *jdata;
+    pmix_rank_t *ranks;
+    prte_proc_state_t *states;
+    int32_t num;
+    int32_t size;
+} prte_state_batch_t;
+PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_state_batch_t);
+
 END_C_DECLS
 #endif
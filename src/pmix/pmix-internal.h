@@ -42,6 +42,30 @@
 BEGIN_C_DECLS
 
 PRTE_EXPORT extern int prte_pmix_verbose_output;
+PRTE_EXPORT extern bool prte_pmix_check_blocking_waits;
+
+/* record the thread that progresses the PRTE event base so
+ * that blocking waits executed from within it can be flagged -
+ * clear it once the event loop has stopped, as the waits made
+ * by that thread during finalize block nothing */
+PRTE_EXPORT void prte_pmix_mark_event_thread(void);
+PRTE_EXPORT void prte_pmix_clear_event_thread(void);
+PRTE_EXPORT bool prte_pmix_in_event_thread(void);
+
+/* completion callback for PMIx operations that are not waited
+ * upon - any error is reported, but nothing else is done */
+PRTE_EXPORT void prte_pmix_nowait_cbfunc(pmix_status_t status, void *cbdata);
+
+/* a blocking wait from within the event base stalls every other
+ * event until the operation completes - report them when asked */
+#define PRTE_PMIX_CHECK_BLOCKING_WAIT()                                 \
+    do {                                                                \
+        if (prte_pmix_check_blocking_waits &&                           \
+            prte_pmix_in_event_thread()) {                              \
+            prte_output(0, "Blocking wait in event base at %s:%d",      \
+                        __FILE__, __LINE__);                            \
+        }                                                               \
+    } while(0)
 
 typedef struct {
     prte_list_item_t super;
@@ -162,6 +186,7 @@ pmix_proc_hton_intr(pmix_proc_t *name)
 #if PRTE_ENABLE_DEBUG
 #define PRTE_PMIX_WAIT_THREAD(lck)                                 \
     do {                                                            \
+        PRTE_PMIX_CHECK_BLOCKING_WAIT();                            \
         prte_mutex_lock(&(lck)->mutex);                            \
         if (prte_debug_threads) {                                  \
             prte_output(0, "Waiting for thread %s:%d",             \
@@ -180,6 +205,7 @@ pmix_proc_hton_intr(pmix_proc_t *name)
 #else
 #define PRTE_PMIX_WAIT_THREAD(lck)                                 \
     do {                                                            \
+        PRTE_PMIX_CHECK_BLOCKING_WAIT();                            \
         prte_mutex_lock(&(lck)->mutex);                            \
         while ((lck)->active) {                                     \
             prte_pmix_condition_wait(&(lck)->cond, &(lck)->mutex); \
@@ -463,6 +489,12 @@ pmix_proc_hton_intr(pmix_proc_t *name)
 
 #define PRTE_PMIX_SHOW_HELP    "prte.show.help"
 
+/* query the current version of the state machine. A tool can pass it
+ * back as a PRTE_QUERY_SINCE qualifier on a (local) proc table query
+ * to only be given the procs whose state changed since that version */
+#define PRTE_QUERY_VERSION     "prte.query.version"     // uint64_t
+#define PRTE_QUERY_SINCE       "prte.query.since"       // uint64_t
+
 
 /* PRTE attribute */
 typedef uint16_t prte_attribute_key_t;
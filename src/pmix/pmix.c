@@ -26,6 +26,7 @@
 
 #include <time.h>
 #include <string.h>
+#include <pthread.h>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -40,6 +41,33 @@
 #include "src/mca/plm/base/plm_private.h"
 #include "src/pmix/pmix-internal.h"
 
+static pthread_t prte_pmix_event_thread;
+static bool prte_pmix_event_thread_set = false;
+
+void prte_pmix_mark_event_thread(void)
+{
+    prte_pmix_event_thread = pthread_self();
+    prte_pmix_event_thread_set = true;
+}
+
+void prte_pmix_clear_event_thread(void)
+{
+    prte_pmix_event_thread_set = false;
+}
+
+bool prte_pmix_in_event_thread(void)
+{
+    return (prte_pmix_event_thread_set &&
+            pthread_equal(pthread_self(), prte_pmix_event_thread));
+}
+
+void prte_pmix_nowait_cbfunc(pmix_status_t status, void *cbdata)
+{
+    if (PMIX_SUCCESS != status) {
+        PMIX_ERROR_LOG(status);
+    }
+}
+
 pmix_status_t prte_pmix_convert_rc(int rc)
 {
     switch (rc) {
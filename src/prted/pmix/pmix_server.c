@@ -254,6 +254,25 @@ void pmix_server_register_params(void)
                                   PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
                                   PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
                                   &prte_pmix_server_globals.num_rooms);
+    /* specify the window for combining direct modex messages */
+    prte_pmix_server_globals.dmdx_batch_window = 0;
+    (void) prte_mca_base_var_register ("prte", "pmix", NULL, "dmodex_batch_window",
+                                  "Time (in microseconds) to collect direct modex requests and responses going to the same daemon so they can be sent as a single message (0 => only combine those raised in the same pass of the event loop)",
+                                  PRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prte_pmix_server_globals.dmdx_batch_window);
+    if (prte_pmix_server_globals.dmdx_batch_window < 0) {
+        prte_pmix_server_globals.dmdx_batch_window = 0;
+    }
+
+    /* whether or not to cache query results */
+    prte_pmix_server_globals.query_cache = true;
+    (void) prte_mca_base_var_register ("prte", "pmix", NULL, "query_cache",
+                                  "Whether or not to cache the results of queries for namespaces, proc tables and psets until the next change of job or proc state",
+                                  PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                                  PRTE_INFO_LVL_9, PRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prte_pmix_server_globals.query_cache);
+
     /* specify the timeout for the hotel */
     prte_pmix_server_globals.timeout = 2;
     (void) prte_mca_base_var_register ("prte", "pmix", NULL, "server_max_wait",
@@ -295,6 +314,351 @@ void pmix_server_register_params(void)
                                   &prte_pmix_server_globals.system_server);
 }
 
+/* Outstanding direct modex requests are indexed by the proc whose data
+ * they want, so we can tell at once whether that data is already on its
+ * way and find everyone waiting for it when it arrives. The tracker
+ * retains each request it holds, and a request is only considered to
+ * be pending while it still occupies its room in the hotel - the hotel
+ * remains in charge of timing requests out */
+typedef struct {
+    prte_list_item_t super;
+    pmix_proc_t tproc;
+    prte_pointer_array_t reqs;
+} pmix_server_dmdx_t;
+static void dmdxcon(pmix_server_dmdx_t *p)
+{
+    PRTE_CONSTRUCT(&p->reqs, prte_pointer_array_t);
+    prte_pointer_array_init(&p->reqs, 4, INT_MAX, 4);
+}
+static void dmdxdes(pmix_server_dmdx_t *p)
+{
+    int n;
+    pmix_server_req_t *req;
+
+    for (n=0; n < p->reqs.size; n++) {
+        if (NULL != (req = (pmix_server_req_t*)prte_pointer_array_get_item(&p->reqs, n))) {
+            PRTE_RELEASE(req);
+        }
+    }
+    PRTE_DESTRUCT(&p->reqs);
+}
+static PRTE_CLASS_INSTANCE(pmix_server_dmdx_t,
+                           prte_list_item_t,
+                           dmdxcon, dmdxdes);
+
+static void dmdx_key(pmix_proc_t *key, const pmix_proc_t *proc)
+{
+    /* the key is hashed as raw bytes, so clear the unused part
+     * of the nspace */
+    memset(key, 0, sizeof(pmix_proc_t));
+    PMIX_LOAD_PROCID(key, proc->nspace, proc->rank);
+}
+
+static pmix_server_dmdx_t* dmdx_lookup(const pmix_proc_t *proc)
+{
+    pmix_proc_t key;
+    pmix_server_dmdx_t *trk;
+
+    dmdx_key(&key, proc);
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(&prte_pmix_server_globals.dmdx,
+                                                      &key, sizeof(key), (void**)&trk)) {
+        return NULL;
+    }
+    return trk;
+}
+
+static void dmdx_remove(pmix_server_dmdx_t *trk)
+{
+    pmix_proc_t key;
+
+    dmdx_key(&key, &trk->tproc);
+    prte_hash_table_remove_value_ptr(&prte_pmix_server_globals.dmdx, &key, sizeof(key));
+    PRTE_RELEASE(trk);
+}
+
+static bool dmdx_in_hotel(pmix_server_req_t *req)
+{
+    void *occupant;
+
+    if (req->room_num < 0 || prte_pmix_server_globals.reqs.num_rooms <= req->room_num) {
+        return false;
+    }
+    prte_hotel_knock(&prte_pmix_server_globals.reqs, req->room_num, &occupant);
+    return (occupant == (void*)req);
+}
+
+/* NOTE: this function must be called from within an event! */
+bool pmix_server_dmdx_pending(const pmix_proc_t *proc)
+{
+    pmix_server_dmdx_t *trk;
+    pmix_server_req_t *req;
+    int n;
+
+    if (NULL == (trk = dmdx_lookup(proc))) {
+        return false;
+    }
+    for (n=0; n < trk->reqs.size; n++) {
+        if (NULL == (req = (pmix_server_req_t*)prte_pointer_array_get_item(&trk->reqs, n))) {
+            continue;
+        }
+        if (dmdx_in_hotel(req)) {
+            return true;
+        }
+        /* this one has already completed or timed out */
+        prte_pointer_array_set_item(&trk->reqs, n, NULL);
+        PRTE_RELEASE(req);
+    }
+    /* nothing is outstanding */
+    dmdx_remove(trk);
+    return false;
+}
+
+/* NOTE: this function must be called from within an event! */
+int pmix_server_dmdx_track(pmix_server_req_t *req)
+{
+    pmix_proc_t key;
+    pmix_server_dmdx_t *trk;
+    int rc;
+
+    if (NULL == (trk = dmdx_lookup(&req->tproc))) {
+        trk = PRTE_NEW(pmix_server_dmdx_t);
+        PMIX_XFER_PROCID(&trk->tproc, &req->tproc);
+        dmdx_key(&key, &req->tproc);
+        rc = prte_hash_table_set_value_ptr(&prte_pmix_server_globals.dmdx,
+                                           &key, sizeof(key), trk);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_RELEASE(trk);
+            return rc;
+        }
+    }
+    PRTE_RETAIN(req);
+    if (0 > prte_pointer_array_add(&trk->reqs, req)) {
+        PRTE_RELEASE(req);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* Direct modex requests and responses are sent to the daemon hosting
+ * the target proc (or back to the requesting daemon). Rather than
+ * sending each one as it is generated, they are queued per daemon and
+ * tag and sent as a single message when the batch window expires. The
+ * receivers simply process records until they reach the end of the
+ * message */
+typedef struct {
+    prte_object_t super;
+    prte_event_t ev;
+    pmix_proc_t dest;
+    prte_rml_tag_t tag;
+    pmix_data_buffer_t *buf;
+} pmix_server_dmdx_msg_t;
+static void dmsgcon(pmix_server_dmdx_msg_t *p)
+{
+    p->buf = NULL;
+}
+static void dmsgdes(pmix_server_dmdx_msg_t *p)
+{
+    if (NULL != p->buf) {
+        PMIX_DATA_BUFFER_RELEASE(p->buf);
+    }
+}
+static PRTE_CLASS_INSTANCE(pmix_server_dmdx_msg_t,
+                           prte_object_t,
+                           dmsgcon, dmsgdes);
+
+typedef struct {
+    prte_list_item_t super;
+    pmix_proc_t dest;
+    prte_rml_tag_t tag;
+    pmix_data_buffer_t *buf;
+    int nrecords;
+} pmix_server_dmdx_batch_t;
+static void dbcon(pmix_server_dmdx_batch_t *p)
+{
+    p->buf = NULL;
+    p->nrecords = 0;
+}
+static void dbdes(pmix_server_dmdx_batch_t *p)
+{
+    if (NULL != p->buf) {
+        PMIX_DATA_BUFFER_RELEASE(p->buf);
+    }
+}
+static PRTE_CLASS_INSTANCE(pmix_server_dmdx_batch_t,
+                           prte_list_item_t,
+                           dbcon, dbdes);
+
+/* batches waiting to go out, indexed by daemon rank for requests
+ * and for responses */
+static prte_list_t dmdx_batches;
+static prte_pointer_array_t dmdx_req_batches;
+static prte_pointer_array_t dmdx_resp_batches;
+static prte_event_t dmdx_flush_ev;
+static bool dmdx_flush_pending = false;
+
+/* a batch of requests could not be sent - don't leave the requests
+ * it carries waiting in the hotel for a reply that will never come.
+ * Each record carries the room number of its request, so check them
+ * out and let the requestors know */
+static void dmdx_fail(prte_rml_tag_t tag, pmix_data_buffer_t *buf, int rc)
+{
+    pmix_proc_t pproc;
+    int room_num;
+    size_t ninfo;
+    pmix_info_t *info;
+    pmix_server_req_t *req;
+    pmix_server_dmdx_t *trk;
+    int32_t cnt;
+    int n;
+    pmix_status_t prc = prte_pmix_convert_rc(rc);
+
+    /* responses are timed out by the requesting daemon */
+    if (PRTE_RML_TAG_DIRECT_MODEX != tag || NULL == buf) {
+        return;
+    }
+    while (1) {
+        cnt = 1;
+        if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, buf, &pproc, &cnt, PMIX_PROC)) {
+            break;
+        }
+        cnt = 1;
+        if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, buf, &room_num, &cnt, PMIX_INT)) {
+            break;
+        }
+        cnt = 1;
+        if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, buf, &ninfo, &cnt, PMIX_SIZE)) {
+            break;
+        }
+        if (0 < ninfo) {
+            PMIX_INFO_CREATE(info, ninfo);
+            cnt = ninfo;
+            if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, buf, info, &cnt, PMIX_INFO)) {
+                PMIX_INFO_FREE(info, ninfo);
+                break;
+            }
+            PMIX_INFO_FREE(info, ninfo);
+        }
+        if (0 <= room_num && room_num < prte_pmix_server_globals.reqs.num_rooms) {
+            prte_hotel_knock(&prte_pmix_server_globals.reqs, room_num, (void**)&req);
+            if (NULL != req && PMIX_CHECK_PROCID(&req->tproc, &pproc)) {
+                prte_hotel_checkout(&prte_pmix_server_globals.reqs, room_num);
+                if (NULL != req->mdxcbfunc) {
+                    req->mdxcbfunc(prc, NULL, 0, req->cbdata, NULL, NULL);
+                }
+                PRTE_RELEASE(req);
+            }
+        }
+        /* anyone waiting on this request would wait in vain */
+        if (NULL != (trk = dmdx_lookup(&pproc))) {
+            for (n=0; n < trk->reqs.size; n++) {
+                req = (pmix_server_req_t*)prte_pointer_array_get_item(&trk->reqs, n);
+                if (NULL == req || !dmdx_in_hotel(req)) {
+                    continue;
+                }
+                prte_hotel_checkout(&prte_pmix_server_globals.reqs, req->room_num);
+                if (NULL != req->mdxcbfunc) {
+                    req->mdxcbfunc(prc, NULL, 0, req->cbdata, NULL, NULL);
+                }
+                PRTE_RELEASE(req);
+            }
+            dmdx_remove(trk);
+        }
+    }
+}
+
+static void dmdx_flush(int sd, short args, void *cbdata)
+{
+    pmix_server_dmdx_batch_t *batch;
+    prte_pointer_array_t *index;
+    int rc;
+
+    while (NULL != (batch = (pmix_server_dmdx_batch_t*)prte_list_remove_first(&dmdx_batches))) {
+        index = (PRTE_RML_TAG_DIRECT_MODEX == batch->tag) ? &dmdx_req_batches : &dmdx_resp_batches;
+        prte_pointer_array_set_item(index, batch->dest.rank, NULL);
+        prte_output_verbose(2, prte_pmix_server_globals.output,
+                            "%s dmdx: sending %d %s to %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), batch->nrecords,
+                            (PRTE_RML_TAG_DIRECT_MODEX == batch->tag) ? "requests" : "responses",
+                            PRTE_NAME_PRINT(&batch->dest));
+        rc = prte_rml.send_buffer_nb(&batch->dest, batch->buf, batch->tag,
+                                     prte_rml_send_callback, NULL);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            dmdx_fail(batch->tag, batch->buf, rc);
+        } else {
+            batch->buf = NULL;
+        }
+        PRTE_RELEASE(batch);
+    }
+    dmdx_flush_pending = false;
+}
+
+static void dmdx_queue(int sd, short args, void *cbdata)
+{
+    pmix_server_dmdx_msg_t *msg = (pmix_server_dmdx_msg_t*)cbdata;
+    pmix_server_dmdx_batch_t *batch;
+    prte_pointer_array_t *index;
+    pmix_status_t prc;
+    struct timeval tv;
+    int rc;
+
+    PRTE_ACQUIRE_OBJECT(msg);
+
+    if (!PMIX_CHECK_NSPACE(msg->dest.nspace, PRTE_PROC_MY_NAME->nspace)) {
+        /* not one of our daemons - just send it */
+        rc = prte_rml.send_buffer_nb(&msg->dest, msg->buf, msg->tag,
+                                     prte_rml_send_callback, NULL);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            dmdx_fail(msg->tag, msg->buf, rc);
+        } else {
+            msg->buf = NULL;
+        }
+        PRTE_RELEASE(msg);
+        return;
+    }
+
+    index = (PRTE_RML_TAG_DIRECT_MODEX == msg->tag) ? &dmdx_req_batches : &dmdx_resp_batches;
+    batch = (pmix_server_dmdx_batch_t*)prte_pointer_array_get_item(index, msg->dest.rank);
+    if (NULL == batch) {
+        batch = PRTE_NEW(pmix_server_dmdx_batch_t);
+        PMIX_XFER_PROCID(&batch->dest, &msg->dest);
+        batch->tag = msg->tag;
+        /* start from the first record we were given */
+        batch->buf = msg->buf;
+        msg->buf = NULL;
+        prte_pointer_array_set_item(index, msg->dest.rank, batch);
+        prte_list_append(&dmdx_batches, &batch->super);
+    } else if (PMIX_SUCCESS != (prc = PMIx_Data_copy_payload(batch->buf, msg->buf))) {
+        PMIX_ERROR_LOG(prc);
+        dmdx_fail(msg->tag, msg->buf, prte_pmix_convert_status(prc));
+        PRTE_RELEASE(msg);
+        return;
+    }
+    batch->nrecords++;
+    PRTE_RELEASE(msg);
+
+    if (!dmdx_flush_pending) {
+        dmdx_flush_pending = true;
+        tv.tv_sec = prte_pmix_server_globals.dmdx_batch_window / 1000000;
+        tv.tv_usec = prte_pmix_server_globals.dmdx_batch_window % 1000000;
+        prte_event_evtimer_add(&dmdx_flush_ev, &tv);
+    }
+}
+
+void pmix_server_dmdx_send(pmix_proc_t *dest, prte_rml_tag_t tag,
+                           pmix_data_buffer_t *buf)
+{
+    pmix_server_dmdx_msg_t *msg;
+
+    msg = PRTE_NEW(pmix_server_dmdx_msg_t);
+    PMIX_XFER_PROCID(&msg->dest, dest);
+    msg->tag = tag;
+    msg->buf = buf;
+    PRTE_THREADSHIFT(msg, prte_event_base, dmdx_queue, PRTE_MSG_PRI);
+}
+
 static void eviction_cbfunc(struct prte_hotel_t *hotel,
                             int room_num, void *occupant)
 {
@@ -376,6 +740,9 @@ void prte_pmix_server_clear(pmix_proc_t *pname)
 {
     int n;
     pmix_server_req_t *req;
+    pmix_server_dmdx_t *trk;
+    prte_list_t stale;
+    void *key;
 
     for (n=0; n < prte_pmix_server_globals.reqs.num_rooms; n++) {
         prte_hotel_knock(&prte_pmix_server_globals.reqs, n, (void**)&req);
@@ -386,6 +753,18 @@ void prte_pmix_server_clear(pmix_proc_t *pname)
             }
         }
     }
+
+    /* drop the trackers of any direct modex requests we just released */
+    PRTE_CONSTRUCT(&stale, prte_list_t);
+    PRTE_HASH_TABLE_FOREACH_PTR(key, trk, &prte_pmix_server_globals.dmdx, {
+        if (PMIX_CHECK_PROCID(&trk->tproc, pname)) {
+            prte_list_append(&stale, &trk->super);
+        }
+    });
+    while (NULL != (trk = (pmix_server_dmdx_t*)prte_list_remove_first(&stale))) {
+        dmdx_remove(trk);
+    }
+    PRTE_DESTRUCT(&stale);
 }
 /*
  * Initialize global variables used w/in the server.
@@ -407,6 +786,15 @@ int pmix_server_init(void)
 
     /* setup the server's state variables */
     PRTE_CONSTRUCT(&prte_pmix_server_globals.reqs, prte_hotel_t);
+    PRTE_CONSTRUCT(&prte_pmix_server_globals.dmdx, prte_hash_table_t);
+    prte_hash_table_init(&prte_pmix_server_globals.dmdx, 1024);
+    PRTE_CONSTRUCT(&dmdx_batches, prte_list_t);
+    PRTE_CONSTRUCT(&dmdx_req_batches, prte_pointer_array_t);
+    prte_pointer_array_init(&dmdx_req_batches, 8, INT_MAX, 8);
+    PRTE_CONSTRUCT(&dmdx_resp_batches, prte_pointer_array_t);
+    prte_pointer_array_init(&dmdx_resp_batches, 8, INT_MAX, 8);
+    prte_event_evtimer_set(prte_event_base, &dmdx_flush_ev, dmdx_flush, NULL);
+    prte_event_set_priority(&dmdx_flush_ev, PRTE_MSG_PRI);
     PRTE_CONSTRUCT(&prte_pmix_server_globals.psets, prte_list_t);
 
     /* by the time we init the server, we should know how many nodes we
@@ -660,6 +1048,9 @@ void pmix_server_start(void)
 
 void pmix_server_finalize(void)
 {
+    pmix_server_dmdx_t *trk;
+    void *key;
+
     if (!prte_pmix_server_globals.initialized) {
         return;
     }
@@ -685,6 +1076,19 @@ void pmix_server_finalize(void)
     PMIx_server_finalize();
 
     /* cleanup collectives */
+    PRTE_HASH_TABLE_FOREACH_PTR(key, trk, &prte_pmix_server_globals.dmdx, {
+        PRTE_RELEASE(trk);
+    });
+    PRTE_DESTRUCT(&prte_pmix_server_globals.dmdx);
+    pmix_server_clear_locality_cache();
+    pmix_server_clear_query_cache();
+    if (dmdx_flush_pending) {
+        prte_event_evtimer_del(&dmdx_flush_ev);
+        dmdx_flush_pending = false;
+    }
+    PRTE_LIST_DESTRUCT(&dmdx_batches);
+    PRTE_DESTRUCT(&dmdx_req_batches);
+    PRTE_DESTRUCT(&dmdx_resp_batches);
     PRTE_DESTRUCT(&prte_pmix_server_globals.reqs);
     PRTE_LIST_DESTRUCT(&prte_pmix_server_globals.notifications);
     PRTE_LIST_DESTRUCT(&prte_pmix_server_globals.psets);
@@ -720,9 +1124,7 @@ static void send_error(int status, pmix_proc_t *idreq,
     }
 
     /* send the response */
-    prte_rml.send_buffer_nb(remote, reply,
-                            PRTE_RML_TAG_DIRECT_MODEX_RESP,
-                            prte_rml_send_callback, NULL);
+    pmix_server_dmdx_send(remote, PRTE_RML_TAG_DIRECT_MODEX_RESP, reply);
 }
 
 static void _mdxresp(int sd, short args, void *cbdata)
@@ -774,11 +1176,12 @@ static void _mdxresp(int sd, short args, void *cbdata)
     }
 
     /* send the response */
-    prte_rml.send_buffer_nb(&req->proxy, reply,
-                            PRTE_RML_TAG_DIRECT_MODEX_RESP,
-                            prte_rml_send_callback, NULL);
+    pmix_server_dmdx_send(&req->proxy, PRTE_RML_TAG_DIRECT_MODEX_RESP, reply);
+    PRTE_RELEASE(req);
+    return;
 
   error:
+    PMIX_DATA_BUFFER_RELEASE(reply);
     PRTE_RELEASE(req);
     return;
 }
@@ -810,52 +1213,20 @@ static void modex_resp(pmix_status_t status,
     PRTE_POST_OBJECT(req);
     prte_event_active(&(req->ev), PRTE_EV_WRITE, 1);
 }
-static void pmix_server_dmdx_recv(int status, pmix_proc_t* sender,
-                                  pmix_data_buffer_t *buffer,
-                                  prte_rml_tag_t tg, void *cbdata)
+static void dmdx_request(pmix_proc_t *sender, pmix_proc_t *tproc,
+                         int room_num, pmix_info_t *info, size_t ninfo)
 {
-    int rc, room_num;
-    int32_t cnt;
+    int rc;
     prte_job_t *jdata;
     prte_proc_t *proc;
     pmix_server_req_t *req;
     pmix_proc_t pproc;
     pmix_status_t prc;
-    pmix_info_t *info=NULL;
-    size_t ninfo;
     char *key=NULL;
     size_t sz;
     pmix_value_t *pval = NULL;
 
-    cnt = 1;
-    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC))) {
-        PMIX_ERROR_LOG(prc);
-        return;
-    }
-    prte_output_verbose(2, prte_pmix_server_globals.output,
-                        "%s dmdx:recv request from proc %s for proc %s:%u",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                        PRTE_NAME_PRINT(sender),
-                        pproc.nspace, pproc.rank);
-    /* and the remote daemon's tracking room number */
-    cnt = 1;
-    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &room_num, &cnt, PMIX_INT))) {
-        PMIX_ERROR_LOG(prc);
-        return;
-    }
-    cnt = 1;
-    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &ninfo, &cnt, PMIX_SIZE))) {
-        PMIX_ERROR_LOG(prc);
-        return;
-    }
-    if (0 < ninfo) {
-        PMIX_INFO_CREATE(info, ninfo);
-        cnt = ninfo;
-        if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, info, &cnt, PMIX_INFO))) {
-            PMIX_ERROR_LOG(prc);
-            return;
-        }
-    }
+    PMIX_XFER_PROCID(&pproc, tproc);
 
 #if PMIX_VERSION_MAJOR >=4
     /* see if they want us to await a particular key before sending
@@ -981,6 +1352,59 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t* sender,
     return;
 }
 
+static void pmix_server_dmdx_recv(int status, pmix_proc_t* sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tg, void *cbdata)
+{
+    int room_num;
+    int32_t cnt;
+    pmix_proc_t pproc;
+    pmix_status_t prc;
+    pmix_info_t *info;
+    size_t ninfo;
+
+    /* requests from the same daemon may have been batched
+     * into one message, so process them until we run out */
+    while (1) {
+        cnt = 1;
+        prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC);
+        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == prc) {
+            break;
+        }
+        if (PMIX_SUCCESS != prc) {
+            PMIX_ERROR_LOG(prc);
+            return;
+        }
+        prte_output_verbose(2, prte_pmix_server_globals.output,
+                            "%s dmdx:recv request from proc %s for proc %s:%u",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            PRTE_NAME_PRINT(sender),
+                            pproc.nspace, pproc.rank);
+        /* and the remote daemon's tracking room number */
+        cnt = 1;
+        if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &room_num, &cnt, PMIX_INT))) {
+            PMIX_ERROR_LOG(prc);
+            return;
+        }
+        cnt = 1;
+        if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &ninfo, &cnt, PMIX_SIZE))) {
+            PMIX_ERROR_LOG(prc);
+            return;
+        }
+        info = NULL;
+        if (0 < ninfo) {
+            PMIX_INFO_CREATE(info, ninfo);
+            cnt = ninfo;
+            if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, info, &cnt, PMIX_INFO))) {
+                PMIX_ERROR_LOG(prc);
+                PMIX_INFO_FREE(info, ninfo);
+                return;
+            }
+        }
+        dmdx_request(sender, &pproc, room_num, info, ninfo);
+    }
+}
+
 typedef struct {
     prte_object_t super;
     char *data;
@@ -1015,6 +1439,7 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t* sender,
     int room_num, rnum;
     int32_t cnt;
     pmix_server_req_t *req;
+    pmix_server_dmdx_t *trk;
     datacaddy_t *d;
     pmix_proc_t pproc;
     size_t psz;
@@ -1025,84 +1450,93 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t* sender,
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_NAME_PRINT(sender));
 
-    d = PRTE_NEW(datacaddy_t);
-
-    /* unpack the status */
-    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pret, &cnt, PMIX_STATUS))) {
-        PMIX_ERROR_LOG(prc);
-        PRTE_RELEASE(d);
-        return;
-    }
+    /* responses from the same daemon may have been batched
+     * into one message, so process them until we run out */
+    while (1) {
+        /* unpack the status */
+        cnt = 1;
+        prc = PMIx_Data_unpack(NULL, buffer, &pret, &cnt, PMIX_STATUS);
+        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == prc) {
+            break;
+        }
+        if (PMIX_SUCCESS != prc) {
+            PMIX_ERROR_LOG(prc);
+            return;
+        }
 
-    /* unpack the id of the target whose info we just received */
-    cnt = 1;
-    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC))) {
-        PMIX_ERROR_LOG(prc);
-        PRTE_RELEASE(d);
-        return;
-    }
+        d = PRTE_NEW(datacaddy_t);
 
-    /* unpack our tracking room number */
-    cnt = 1;
-    if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &room_num, &cnt, PMIX_INT))) {
-        PMIX_ERROR_LOG(prc);
-        PRTE_RELEASE(d);
-        return;
-    }
+        /* unpack the id of the target whose info we just received */
+        cnt = 1;
+        if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC))) {
+            PMIX_ERROR_LOG(prc);
+            PRTE_RELEASE(d);
+            return;
+        }
 
-    /* unload the remainder of the buffer */
-    if (PMIX_SUCCESS == pret) {
+        /* unpack our tracking room number */
         cnt = 1;
-        if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &psz, &cnt, PMIX_SIZE))) {
+        if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &room_num, &cnt, PMIX_INT))) {
             PMIX_ERROR_LOG(prc);
             PRTE_RELEASE(d);
             return;
         }
-        if (0 < psz) {
-            d->ndata = psz;
-            d->data = (char*)malloc(psz);
-            if (NULL == d->data) {
-                PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
-            }
-            cnt = psz;
-            if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, d->data, &cnt, PMIX_BYTE))) {
+
+        /* unload the remainder of the buffer */
+        if (PMIX_SUCCESS == pret) {
+            cnt = 1;
+            if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &psz, &cnt, PMIX_SIZE))) {
                 PMIX_ERROR_LOG(prc);
                 PRTE_RELEASE(d);
                 return;
             }
+            if (0 < psz) {
+                d->ndata = psz;
+                d->data = (char*)malloc(psz);
+                if (NULL == d->data) {
+                    PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                }
+                cnt = psz;
+                if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, d->data, &cnt, PMIX_BYTE))) {
+                    PMIX_ERROR_LOG(prc);
+                    PRTE_RELEASE(d);
+                    return;
+                }
+            }
         }
-    }
-
-    /* check the request out of the tracking hotel */
-    prte_hotel_checkout_and_return_occupant(&prte_pmix_server_globals.reqs, room_num, (void**)&req);
-    /* return the returned data to the requestor */
-    if (NULL != req) {
-        if (NULL != req->mdxcbfunc) {
-            PRTE_RETAIN(d);
-            req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
-        }
-        PRTE_RELEASE(req);
-    } else {
-        prte_output_verbose(2, prte_pmix_server_globals.output,
-                             "REQ WAS NULL IN ROOM %d", room_num);
-    }
 
-    /* now see if anyone else was waiting for data from this target */
-    for (rnum=0; rnum < prte_pmix_server_globals.reqs.num_rooms; rnum++) {
-        prte_hotel_knock(&prte_pmix_server_globals.reqs, rnum, (void**)&req);
-        if (NULL == req) {
-            continue;
-        }
-        if (PMIX_CHECK_PROCID(&req->tproc, &pproc)) {
+        /* check the request out of the tracking hotel */
+        prte_hotel_checkout_and_return_occupant(&prte_pmix_server_globals.reqs, room_num, (void**)&req);
+        /* return the returned data to the requestor */
+        if (NULL != req) {
             if (NULL != req->mdxcbfunc) {
                 PRTE_RETAIN(d);
                 req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
             }
-            prte_hotel_checkout(&prte_pmix_server_globals.reqs, rnum);
             PRTE_RELEASE(req);
+        } else {
+            prte_output_verbose(2, prte_pmix_server_globals.output,
+                                 "REQ WAS NULL IN ROOM %d", room_num);
+        }
+
+        /* now see if anyone else was waiting for data from this target */
+        if (NULL != (trk = dmdx_lookup(&pproc))) {
+            for (rnum=0; rnum < trk->reqs.size; rnum++) {
+                req = (pmix_server_req_t*)prte_pointer_array_get_item(&trk->reqs, rnum);
+                if (NULL == req || !dmdx_in_hotel(req)) {
+                    continue;
+                }
+                if (NULL != req->mdxcbfunc) {
+                    PRTE_RETAIN(d);
+                    req->mdxcbfunc(pret, d->data, d->ndata, req->cbdata, relcbfunc, d);
+                }
+                prte_hotel_checkout(&prte_pmix_server_globals.reqs, req->room_num);
+                PRTE_RELEASE(req);
+            }
+            dmdx_remove(trk);
         }
+        PRTE_RELEASE(d);  // maintain accounting
     }
-    PRTE_RELEASE(d);  // maintain accounting
 }
 
 static void pmix_server_log(int status, pmix_proc_t* sender,
@@ -38,6 +38,12 @@ PRTE_EXPORT void pmix_server_register_params(void);
 
 PRTE_EXPORT int prte_pmix_server_register_nspace(prte_job_t *jdata);
 
+/* pack the job-level info that is common to all daemons into the
+ * job attributes so it goes out with the launch msg. The node and
+ * proc map regex can be passed in if they were already generated */
+PRTE_EXPORT int prte_pmix_server_pack_job_info(prte_job_t *jdata,
+                                               pmix_info_t *maps, size_t nmaps);
+
 PRTE_EXPORT void prte_pmix_server_clear(pmix_proc_t *pname);
 
 
@@ -165,11 +165,12 @@ static void modex_resp(pmix_status_t status,
     }
 
     /* send the response */
-    prte_rml.send_buffer_nb(&req->proxy, reply,
-                            PRTE_RML_TAG_DIRECT_MODEX_RESP,
-                            prte_rml_send_callback, NULL);
+    pmix_server_dmdx_send(&req->proxy, PRTE_RML_TAG_DIRECT_MODEX_RESP, reply);
+    PRTE_RELEASE(req);
+    return;
 
   error:
+    PMIX_DATA_BUFFER_RELEASE(reply);
     PRTE_RELEASE(req);
     return;
 }
@@ -177,10 +178,9 @@ static void modex_resp(pmix_status_t status,
 static void dmodex_req(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
-    pmix_server_req_t *r;
     prte_job_t *jdata;
     prte_proc_t *proct, *dmn;
-    int rc, rnum;
+    int rc;
     pmix_data_buffer_t *buf;
     pmix_status_t prc = PMIX_ERROR;
     bool refresh_cache = false;
@@ -253,23 +253,21 @@ static void dmodex_req(int sd, short args, void *cbdata)
 
     /* has anyone already requested data for this target? If so,
      * then the data is already on its way */
-    for (rnum=0; rnum < prte_pmix_server_globals.reqs.num_rooms; rnum++) {
-        prte_hotel_knock(&prte_pmix_server_globals.reqs, rnum, (void**)&r);
-        if (NULL == r) {
-            continue;
+    if (pmix_server_dmdx_pending(&req->tproc)) {
+        /* save the request in the hotel until the
+         * data is returned */
+        if (PRTE_SUCCESS != (rc = prte_hotel_checkin(&prte_pmix_server_globals.reqs, req, &req->room_num))) {
+            prte_show_help("help-prted.txt", "noroom", true, req->operation, prte_pmix_server_globals.num_rooms);
+            /* can't just return as that would cause the requestor
+             * to hang, so instead execute the callback */
+            prc = prte_pmix_convert_rc(rc);
+            goto callback;
         }
-        if (PMIX_CHECK_PROCID(&r->target, &req->tproc)) {
-            /* save the request in the hotel until the
-             * data is returned */
-            if (PRTE_SUCCESS != (rc = prte_hotel_checkin(&prte_pmix_server_globals.reqs, req, &req->room_num))) {
-                prte_show_help("help-prted.txt", "noroom", true, req->operation, prte_pmix_server_globals.num_rooms);
-                /* can't just return as that would cause the requestor
-                 * to hang, so instead execute the callback */
-                prc = prte_pmix_convert_rc(rc);
-                goto callback;
-            }
-            return;
+        /* wait on the outstanding request */
+        if (PRTE_SUCCESS != (rc = pmix_server_dmdx_track(req))) {
+            PRTE_ERROR_LOG(rc);
         }
+        return;
     }
 
     /* lookup who is hosting this proc */
@@ -277,7 +275,9 @@ static void dmodex_req(int sd, short args, void *cbdata)
         /* if we don't know the job, then it could be a race
          * condition where we are being asked about a process
          * that we don't know about yet. In this case, just
-         * record the request and we will process it later */
+         * record the request and we will process it later. Note that
+         * no request has been sent, so later requests for this proc
+         * must not wait on this one */
         if (PRTE_SUCCESS != (rc = prte_hotel_checkin(&prte_pmix_server_globals.reqs, req, &req->room_num))) {
             prte_show_help("help-prted.txt", "noroom", true, req->operation, prte_pmix_server_globals.num_rooms);
             /* can't just return as that would cause the requestor
@@ -338,7 +338,8 @@ static void dmodex_req(int sd, short args, void *cbdata)
                         __FILE__, __LINE__, req->room_num,
                         (NULL == req->key) ? "NULL" : req->key);
     /* if we are the host daemon, then this is a local request, so
-     * just wait for the data to come in */
+     * just wait for the data to come in - nothing is sent, so it
+     * isn't tracked for later requests to wait on */
     if (PRTE_PROC_MY_NAME->rank == dmn->name.rank) {
         return;
     }
@@ -374,15 +375,13 @@ static void dmodex_req(int sd, short args, void *cbdata)
         }
     }
 
-    /* send it to the host daemon */
-    if (PRTE_SUCCESS != (rc = prte_rml.send_buffer_nb(&dmn->name, buf, PRTE_RML_TAG_DIRECT_MODEX,
-                                                      prte_rml_send_callback, NULL))) {
+    /* let any later requests for this target wait on this one */
+    if (PRTE_SUCCESS != (rc = pmix_server_dmdx_track(req))) {
         PRTE_ERROR_LOG(rc);
-        prte_hotel_checkout(&prte_pmix_server_globals.reqs, req->room_num);
-        PRTE_RELEASE(buf);
-        prc = prte_pmix_convert_rc(rc);
-        goto callback;
     }
+    /* send it to the host daemon - this will be combined with any
+     * other requests going to the same daemon */
+    pmix_server_dmdx_send(&dmn->name, PRTE_RML_TAG_DIRECT_MODEX, buf);
     return;
 
   callback:
@@ -41,6 +41,7 @@
 #include <pmix_server.h>
 
 #include "types.h"
+#include "src/class/prte_hash_table.h"
 #include "src/class/prte_hotel.h"
 #include "src/mca/base/base.h"
 #include "src/event/event-internal.h"
@@ -331,6 +332,23 @@ PRTE_EXPORT extern pmix_status_t pmix_server_group_fn(pmix_group_operation_t op,
 PRTE_EXPORT void prte_pmix_server_tool_conn_complete(prte_job_t *jdata,
                                                        pmix_server_req_t *req);
 
+/* direct modex request tracking - a request must be checked into
+ * the hotel before it is tracked */
+PRTE_EXPORT bool pmix_server_dmdx_pending(const pmix_proc_t *proc);
+PRTE_EXPORT int pmix_server_dmdx_track(pmix_server_req_t *req);
+
+/* drop the locality strings cached during nspace registration */
+PRTE_EXPORT void pmix_server_clear_locality_cache(void);
+
+/* drop the cached query results */
+PRTE_EXPORT void pmix_server_clear_query_cache(void);
+
+/* queue a direct modex request or response for the given daemon - the
+ * buffer is consumed. Messages for the same daemon and tag are
+ * combined into one. May be called from any thread */
+PRTE_EXPORT void pmix_server_dmdx_send(pmix_proc_t *dest, prte_rml_tag_t tag,
+                                       pmix_data_buffer_t *buf);
+
 /* declare the RML recv functions for responses */
 PRTE_EXPORT extern void pmix_server_launch_resp(int status, pmix_proc_t* sender,
                                                  pmix_data_buffer_t *buffer,
@@ -358,6 +376,9 @@ typedef struct {
     int verbosity;
     int output;
     prte_hotel_t reqs;
+    prte_hash_table_t dmdx;
+    int dmdx_batch_window;
+    bool query_cache;
     int num_rooms;
     int timeout;
     bool wait_for_server;
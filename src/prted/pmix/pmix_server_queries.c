@@ -44,6 +44,7 @@
 #include "src/mca/rmaps/rmaps_types.h"
 #include "src/mca/schizo/schizo.h"
 #include "src/mca/state/state.h"
+#include "src/mca/state/base/base.h"
 #include "src/util/name_fns.h"
 #include "src/util/show_help.h"
 #include "src/threads/threads.h"
@@ -54,6 +55,101 @@
 
 #include "src/prted/pmix/pmix_server_internal.h"
 
+/* Tools polling a large DVM repeatedly ask for the same namespace
+ * lists and proc tables, each of which requires walking the global
+ * job and proc data. Cache the results - an entry is only valid for
+ * the state machine version at which it was built, so any change of
+ * job or proc state invalidates it. All entries are dropped the next
+ * time a result is stored at a different version. Only results that
+ * are derived from job and proc state can be cached */
+typedef struct {
+    prte_object_t super;
+    pmix_info_t info;
+} query_cache_entry_t;
+static void qccon(query_cache_entry_t *p)
+{
+    PMIX_INFO_CONSTRUCT(&p->info);
+}
+static void qcdes(query_cache_entry_t *p)
+{
+    PMIX_INFO_DESTRUCT(&p->info);
+}
+static PRTE_CLASS_INSTANCE(query_cache_entry_t,
+                          prte_object_t,
+                          qccon, qcdes);
+
+static prte_hash_table_t *query_cache = NULL;
+static uint64_t query_cache_version = 0;
+
+void pmix_server_clear_query_cache(void)
+{
+    void *key;
+    query_cache_entry_t *entry;
+
+    if (NULL == query_cache) {
+        return;
+    }
+    PRTE_HASH_TABLE_FOREACH_PTR(key, entry, query_cache, {
+        PRTE_RELEASE(entry);
+    });
+    PRTE_RELEASE(query_cache);
+    query_cache = NULL;
+}
+
+static void cache_key(char *ckey, const char *key, const char *nspace)
+{
+    snprintf(ckey, PMIX_MAX_KEYLEN + PMIX_MAX_NSLEN + 3, "%s:%s",
+             key, (NULL == nspace) ? "" : nspace);
+}
+
+/* add a copy of the cached result for this key to the results */
+static bool cache_lookup(const char *key, const char *nspace, prte_list_t *results)
+{
+    char ckey[PMIX_MAX_KEYLEN + PMIX_MAX_NSLEN + 3];
+    query_cache_entry_t *entry;
+    prte_info_item_t *kv;
+
+    if (NULL == query_cache || query_cache_version != prte_state_base_version) {
+        return false;
+    }
+    cache_key(ckey, key, nspace);
+    if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(query_cache, ckey, strlen(ckey),
+                                                      (void**)&entry)) {
+        return false;
+    }
+    kv = PRTE_NEW(prte_info_item_t);
+    PMIX_INFO_XFER(&kv->info, &entry->info);
+    prte_list_append(results, &kv->super);
+    return true;
+}
+
+static void cache_store(const char *key, const char *nspace, pmix_info_t *info)
+{
+    char ckey[PMIX_MAX_KEYLEN + PMIX_MAX_NSLEN + 3];
+    query_cache_entry_t *entry;
+
+    if (!prte_pmix_server_globals.query_cache) {
+        return;
+    }
+    if (NULL != query_cache && query_cache_version != prte_state_base_version) {
+        /* everything in there is out of date */
+        pmix_server_clear_query_cache();
+    }
+    if (NULL == query_cache) {
+        query_cache = PRTE_NEW(prte_hash_table_t);
+        prte_hash_table_init(query_cache, 32);
+        query_cache_version = prte_state_base_version;
+    }
+    cache_key(ckey, key, nspace);
+    if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(query_cache, ckey, strlen(ckey),
+                                                      (void**)&entry)) {
+        PRTE_RELEASE(entry);
+    }
+    entry = PRTE_NEW(query_cache_entry_t);
+    PMIX_INFO_XFER(&entry->info, info);
+    prte_hash_table_set_value_ptr(query_cache, ckey, strlen(ckey), entry);
+}
+
 static void qrel(void *cbdata)
 {
     prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t*)cbdata;
@@ -70,6 +166,9 @@ static void _query(int sd, short args, void *cbdata)
     pmix_query_t *q;
     pmix_status_t ret = PMIX_SUCCESS;
     prte_info_item_t *kv;
+#ifdef PMIX_QUERY_NAMESPACE_INFO
+    prte_info_item_t *kptr;
+#endif
     pmix_nspace_t jobid;
     prte_job_t *jdata;
     prte_node_t *node, *ndptr;
@@ -88,6 +187,8 @@ static void _query(int sd, short args, void *cbdata)
     pmix_info_t *info;
     pmix_data_array_t *darray;
     prte_proc_t *proct;
+    uint64_t since;
+    bool incremental;
 #if PMIX_NUMERIC_VERSION >= 0x00040000
     size_t sz;
 #endif
@@ -105,6 +206,8 @@ static void _query(int sd, short args, void *cbdata)
         q = &cd->queries[m];
         hostname = NULL;
         nodeid = UINT32_MAX;
+        since = 0;
+        incremental = false;
         /* default to the requestor's jobid */
         PMIX_LOAD_NSPACE(jobid, cd->proct.nspace);
         /* see if they provided any qualifiers */
@@ -150,6 +253,9 @@ static void _query(int sd, short args, void *cbdata)
                     hostname = q->qualifiers[n].value.data.string;
                 } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_NODEID)) {
                     PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, nodeid, uint32_t);
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PRTE_QUERY_SINCE)) {
+                    PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, since, uint64_t);
+                    incremental = (PRTE_SUCCESS == rc);
                 }
             }
         }
@@ -157,7 +263,14 @@ static void _query(int sd, short args, void *cbdata)
             prte_output_verbose(2, prte_pmix_server_globals.output,
                                 "%s processing key %s",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), q->keys[n]);
-            if (0 == strcmp(q->keys[n], PMIX_QUERY_NAMESPACES)) {
+            if (0 == strcmp(q->keys[n], PRTE_QUERY_VERSION)) {
+                kv = PRTE_NEW(prte_info_item_t);
+                PMIX_INFO_LOAD(&kv->info, PRTE_QUERY_VERSION, &prte_state_base_version, PMIX_UINT64);
+                prte_list_append(&results, &kv->super);
+            } else if (0 == strcmp(q->keys[n], PMIX_QUERY_NAMESPACES)) {
+                if (cache_lookup(q->keys[n], NULL, &results)) {
+                    continue;
+                }
                 /* get the current jobids */
                 nspaces = NULL;
                 PRTE_CONSTRUCT(&stack, prte_list_t);
@@ -179,8 +292,12 @@ static void _query(int sd, short args, void *cbdata)
                 PMIX_INFO_LOAD(&kv->info, PMIX_QUERY_NAMESPACES, tmp, PMIX_STRING);
                 free(tmp);
                 prte_list_append(&results, &kv->super);
+                cache_store(q->keys[n], NULL, &kv->info);
 #ifdef PMIX_QUERY_NAMESPACE_INFO
             } else if (0 == strcmp(q->keys[n], PMIX_QUERY_NAMESPACE_INFO)) {
+                if (cache_lookup(q->keys[n], NULL, &results)) {
+                    continue;
+                }
                 /* get the current jobids */
                 PRTE_CONSTRUCT(&stack, prte_list_t);
                 for (k = 0; k < prte_job_data->size; k++) {
@@ -221,12 +338,13 @@ static void _query(int sd, short args, void *cbdata)
                 /* join the results into an array */
                 info = (pmix_info_t*)darray->array;
                 p=0;
-                while (NULL != (kv = (prte_info_item_t*)prte_list_remove_first(&stack))) {
-                    PMIX_INFO_XFER(&info[p], &kv->info);
-                    PRTE_RELEASE(kv);
+                while (NULL != (kptr = (prte_info_item_t*)prte_list_remove_first(&stack))) {
+                    PMIX_INFO_XFER(&info[p], &kptr->info);
+                    PRTE_RELEASE(kptr);
                     ++p;
                 }
                 PRTE_LIST_DESTRUCT(&stack);
+                cache_store(q->keys[n], NULL, &kv->info);
 #endif
             } else if (0 == strcmp(q->keys[n], PMIX_QUERY_SPAWN_SUPPORT)) {
                 ans = NULL;
@@ -376,12 +494,26 @@ static void _query(int sd, short args, void *cbdata)
                     ret = PMIX_ERR_NOT_FOUND;
                     goto done;
                 }
+                if (!incremental && cache_lookup(q->keys[n], jobid, &results)) {
+                    continue;
+                }
+                /* if they only want the changes, then count them */
+                p = jdata->num_procs;
+                if (incremental) {
+                    p = 0;
+                    for (k=0; k < jdata->procs->size; k++) {
+                        proct = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, k);
+                        if (NULL != proct && since <= proct->state_version) {
+                            ++p;
+                        }
+                    }
+                }
                 /* setup the reply */
                 kv = PRTE_NEW(prte_info_item_t);
                 (void)strncpy(kv->info.key, PMIX_QUERY_PROC_TABLE, PMIX_MAX_KEYLEN);
                 prte_list_append(&results, &kv->super);
                  /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CREATE(darray, jdata->num_procs, PMIX_PROC_INFO);
+                PMIX_DATA_ARRAY_CREATE(darray, p, PMIX_PROC_INFO);
                 kv->info.value.type = PMIX_DATA_ARRAY;
                 kv->info.value.data.darray = darray;
         #if PMIX_NUMERIC_VERSION < 0x00030100
@@ -393,6 +525,9 @@ static void _query(int sd, short args, void *cbdata)
                     if (NULL == (proct = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, k))) {
                         continue;
                     }
+                    if (incremental && proct->state_version < since) {
+                        continue;
+                    }
                     PMIX_LOAD_PROCID(&procinfo[p].proc, proct->name.nspace, proct->name.rank);
                     if (NULL != proct->node && NULL != proct->node->name) {
                         procinfo[p].hostname = strdup(proct->node->name);
@@ -406,6 +541,9 @@ static void _query(int sd, short args, void *cbdata)
                     procinfo[p].state = prte_pmix_convert_state(proct->state);
                     ++p;
                 }
+                if (!incremental) {
+                    cache_store(q->keys[n], jobid, &kv->info);
+                }
             } else if (0 == strcmp(q->keys[n], PMIX_QUERY_LOCAL_PROC_TABLE)) {
                 /* construct a list of values with prte_proc_info_t
                  * entries for each LOCAL proc in the indicated job */
@@ -419,12 +557,27 @@ static void _query(int sd, short args, void *cbdata)
                     ret = PMIX_ERR_NOT_FOUND;
                     goto done;
                 }
+                if (!incremental && cache_lookup(q->keys[n], jobid, &results)) {
+                    continue;
+                }
+                /* if they only want the changes, then count them */
+                p = jdata->num_local_procs;
+                if (incremental) {
+                    p = 0;
+                    for (k=0; k < jdata->procs->size; k++) {
+                        proct = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, k);
+                        if (NULL != proct && PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_LOCAL) &&
+                            since <= proct->state_version) {
+                            ++p;
+                        }
+                    }
+                }
                 /* setup the reply */
                 kv = PRTE_NEW(prte_info_item_t);
                 (void)strncpy(kv->info.key, PMIX_QUERY_LOCAL_PROC_TABLE, PMIX_MAX_KEYLEN);
                 prte_list_append(&results, &kv->super);
                 /* cycle thru the job and create an entry for each proc */
-                PMIX_DATA_ARRAY_CREATE(darray, jdata->num_local_procs, PMIX_PROC_INFO);
+                PMIX_DATA_ARRAY_CREATE(darray, p, PMIX_PROC_INFO);
                 kv->info.value.type = PMIX_DATA_ARRAY;
                 kv->info.value.data.darray = darray;
         #if PMIX_NUMERIC_VERSION < 0x00030100
@@ -436,6 +589,9 @@ static void _query(int sd, short args, void *cbdata)
                     if (NULL == (proct = (prte_proc_t*)prte_pointer_array_get_item(jdata->procs, k))) {
                         continue;
                     }
+                    if (incremental && proct->state_version < since) {
+                        continue;
+                    }
                     if (PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_LOCAL)) {
                         PMIX_LOAD_PROCID(&procinfo[p].proc, proct->name.nspace, proct->name.rank);
                         if (NULL != proct->node && NULL != proct->node->name) {
@@ -451,6 +607,9 @@ static void _query(int sd, short args, void *cbdata)
                         ++p;
                     }
                 }
+                if (!incremental) {
+                    cache_store(q->keys[n], jobid, &kv->info);
+                }
     #endif
     #ifdef PMIX_QUERY_NUM_PSETS
             } else if (0 == strcmp(q->keys[n], PMIX_QUERY_NUM_PSETS)) {
@@ -460,6 +619,8 @@ static void _query(int sd, short args, void *cbdata)
                 prte_list_append(&results, &kv->super);
             } else if (0 == strcmp(q->keys[n], PMIX_QUERY_PSET_NAMES)) {
                 pmix_server_pset_t *ps;
+                /* not cached - process sets come and go with group
+                 * operations, which don't change the state version */
                 ans = NULL;
                 PRTE_LIST_FOREACH(ps, &prte_pmix_server_globals.psets, pmix_server_pset_t) {
                     prte_argv_append_nosize(&ans, ps->name);
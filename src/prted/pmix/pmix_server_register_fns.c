@@ -34,6 +34,7 @@
 #include <unistd.h>
 #endif
 #include <fcntl.h>
+#include <string.h>
 #include <pmix_server.h>
 
 #include "prte_stdint.h"
@@ -55,37 +56,430 @@
 #include "src/prted/pmix/pmix_server.h"
 
 static void opcbfunc(pmix_status_t status, void *cbdata);
+static void regcbfunc(pmix_status_t status, void *cbdata);
+
+/* track a batch of client registrations so we can wait
+ * for all of them with a single thread handoff */
+typedef struct {
+    prte_pmix_lock_t lock;
+    int nreg;
+} prte_client_reg_tracker_t;
+
+/* Most local procs are bound to one of a few distinct cpusets, so
+ * remember the locality string computed for each cpuset string on our
+ * topology instead of parsing the cpuset and generating the string
+ * again for every proc. The cache is dropped if the topology changes */
+static prte_hash_table_t *locality_cache = NULL;
+static hwloc_topology_t locality_topo = NULL;
+
+void pmix_server_clear_locality_cache(void)
+{
+    void *key;
+    size_t keysize;
+    char *locality;
+    void *nptr = NULL;
+
+    if (NULL == locality_cache) {
+        return;
+    }
+    while (PRTE_SUCCESS == prte_hash_table_get_next_key_ptr(locality_cache, &key, &keysize,
+                                                            (void**)&locality, nptr, &nptr)) {
+        free(locality);
+    }
+    PRTE_RELEASE(locality_cache);
+    locality_cache = NULL;
+    locality_topo = NULL;
+}
+
+/* returns the locality string for the given cpuset - the string
+ * belongs to the cache and must not be free'd */
+static char* get_locality_string(char *cpustr, pmix_status_t *ret)
+{
+    char *locality = NULL;
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+    pmix_cpuset_t cpuset;
+#endif
+
+    *ret = PMIX_SUCCESS;
+    if (locality_topo != prte_hwloc_topology) {
+        pmix_server_clear_locality_cache();
+    }
+    if (NULL == locality_cache) {
+        locality_cache = PRTE_NEW(prte_hash_table_t);
+        prte_hash_table_init(locality_cache, 32);
+        locality_topo = prte_hwloc_topology;
+    }
+    if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(locality_cache, cpustr, strlen(cpustr),
+                                                      (void**)&locality)) {
+        return locality;
+    }
+
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+    /* let PMIx generate the locality string */
+    PMIX_CPUSET_CONSTRUCT(&cpuset);
+    cpuset.source = "hwloc";
+    cpuset.bitmap = hwloc_bitmap_alloc();
+    hwloc_bitmap_list_sscanf(cpuset.bitmap, cpustr);
+    *ret = PMIx_server_generate_locality_string(&cpuset, &locality);
+    hwloc_bitmap_free(cpuset.bitmap);
+    if (PMIX_SUCCESS != *ret) {
+        return NULL;
+    }
+#else
+    /* generate the locality string ourselves */
+    locality = prte_hwloc_base_get_locality_string(prte_hwloc_topology, cpustr);
+#endif
+    if (NULL != locality) {
+        prte_hash_table_set_value_ptr(locality_cache, cpustr, strlen(cpustr), locality);
+    }
+    return locality;
+}
+
+/* number of job-level keys in the job info in addition
+ * to the info array for each node and each app */
+#define PRTE_JOB_INFO_NKEYS     13
+/* max number of keys in the info array for a node, an app, or a proc */
+#define PRTE_NODE_INFO_NKEYS    7
+#define PRTE_APP_INFO_NKEYS     6
+#define PRTE_PROC_INFO_NKEYS    12
+
+/* assemble the portion of the job info that is the same on every
+ * daemon - i.e., everything that doesn't depend on the node we are on.
+ * The entries are loaded directly into the returned array instead of
+ * being collected on lists and transferred. If the caller already
+ * generated the node and proc map regex, they can be passed in so
+ * we don't have to compute them again */
+static int build_job_info(prte_job_t *jdata, pmix_info_t *maps, size_t nmaps,
+                          pmix_info_t **info, size_t *ninfo)
+{
+    prte_job_map_t *map = jdata->map;
+    prte_node_t *node;
+    prte_proc_t *pptr;
+    prte_app_context_t *app;
+    pmix_info_t *iptr, *kptr;
+    pmix_rank_t vpid;
+    pmix_status_t ret;
+    char **list = NULL, **procs = NULL, **micro, *tmp, *regex;
+    uint32_t ui32;
+    size_t n, m, nalloc;
+    int i, k;
+
+    *info = NULL;
+    *ninfo = 0;
+
+    nalloc = PRTE_JOB_INFO_NKEYS;
+    for (i=0; i < map->nodes->size; i++) {
+        if (NULL != prte_pointer_array_get_item(map->nodes, i)) {
+            ++nalloc;
+        }
+    }
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL != prte_pointer_array_get_item(jdata->apps, i)) {
+            ++nalloc;
+        }
+    }
+    PMIX_INFO_CREATE(iptr, nalloc);
+    n = 0;
+
+    /* jobid */
+    PMIX_LOAD_KEY(iptr[n].key, PMIX_JOBID);
+    iptr[n].value.type = PMIX_PROC;
+    PMIX_PROC_CREATE(iptr[n].value.data.proc, 1);
+    PMIX_LOAD_NSPACE(iptr[n].value.data.proc->nspace, jdata->nspace);
+    ++n;
+
+    /* offset */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_NPROC_OFFSET, &jdata->offset, PMIX_PROC_RANK);
+    ++n;
+
+    /* assemble the node info and the node/proc maps */
+    for (i=0; i < map->nodes->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(map->nodes, i))) {
+            continue;
+        }
+        micro = NULL;
+        tmp = NULL;
+        vpid = PMIX_RANK_VALID;
+        ui32 = 0;
+        if (NULL == maps) {
+            prte_argv_append_nosize(&list, node->name);
+        }
+        /* assemble all the ranks for this job that are on this node */
+        for (k=0; k < node->procs->size; k++) {
+            if (NULL == (pptr = (prte_proc_t*)prte_pointer_array_get_item(node->procs, k))) {
+                continue;
+            }
+            if (PMIX_CHECK_NSPACE(jdata->nspace, pptr->name.nspace)) {
+                prte_argv_append_nosize(&micro, PRTE_VPID_PRINT(pptr->name.rank));
+                if (pptr->name.rank < vpid) {
+                    vpid = pptr->name.rank;
+                }
+                ++ui32;
+            }
+        }
+        /* assemble the rank/node map */
+        if (NULL != micro) {
+            tmp = prte_argv_join(micro, ',');
+            prte_argv_free(micro);
+            if (NULL == maps) {
+                prte_argv_append_nosize(&procs, tmp);
+            }
+        }
+        /* construct the node info array */
+        PMIX_LOAD_KEY(iptr[n].key, PMIX_NODE_INFO_ARRAY);
+        iptr[n].value.type = PMIX_DATA_ARRAY;
+        PMIX_DATA_ARRAY_CREATE(iptr[n].value.data.darray, PRTE_NODE_INFO_NKEYS, PMIX_INFO);
+        kptr = (pmix_info_t*)iptr[n].value.data.darray->array;
+        m = 0;
+        /* start with the hostname */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_HOSTNAME, node->name, PMIX_STRING);
+        ++m;
+#ifdef PMIX_HOSTNAME_ALIASES
+        /* add any aliases */
+        regex = NULL;
+        if (prte_get_attribute(&node->attributes, PRTE_NODE_ALIAS, (void**)&regex, PMIX_STRING) &&
+            NULL != regex) {
+            PMIX_INFO_LOAD(&kptr[m], PMIX_HOSTNAME_ALIASES, regex, PMIX_STRING);
+            ++m;
+            free(regex);
+        }
+#endif
+        /* pass the node ID */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_NODEID, &node->index, PMIX_UINT32);
+        ++m;
+        /* add node size */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_NODE_SIZE, &node->num_procs, PMIX_UINT32);
+        ++m;
+        /* add local size for this job */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_LOCAL_SIZE, &ui32, PMIX_UINT32);
+        ++m;
+        /* pass the local ldr */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_LOCALLDR, &vpid, PMIX_PROC_RANK);
+        ++m;
+        /* add the local peers */
+        if (NULL != tmp) {
+            PMIX_INFO_LOAD(&kptr[m], PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
+            ++m;
+            free(tmp);
+        }
+        iptr[n].value.data.darray->size = m;
+        ++n;
+    }
+
+    if (NULL != maps) {
+        /* use the regex the caller already generated */
+        for (m=0; m < nmaps; m++) {
+            if (PMIX_CHECK_KEY(&maps[m], PMIX_NODE_MAP) ||
+                PMIX_CHECK_KEY(&maps[m], PMIX_PROC_MAP)) {
+                PMIX_INFO_XFER(&iptr[n], &maps[m]);
+                ++n;
+            }
+        }
+    }
+
+    /* let the PMIx server generate the nodemap regex */
+    if (NULL != list) {
+        tmp = prte_argv_join(list, ',');
+        prte_argv_free(list);
+        list = NULL;
+        if (PMIX_SUCCESS != (ret = PMIx_generate_regex(tmp, &regex))) {
+            PMIX_ERROR_LOG(ret);
+            free(tmp);
+            prte_argv_free(procs);
+            PMIX_INFO_FREE(iptr, nalloc);
+            return prte_pmix_convert_status(ret);
+        }
+        free(tmp);
+#ifdef PMIX_REGEX
+        PMIX_INFO_LOAD(&iptr[n], PMIX_NODE_MAP, regex, PMIX_REGEX);
+#else
+        PMIX_INFO_LOAD(&iptr[n], PMIX_NODE_MAP, regex, PMIX_STRING);
+#endif
+        free(regex);
+        ++n;
+    }
+
+    /* let the PMIx server generate the procmap regex */
+    if (NULL != procs) {
+        tmp = prte_argv_join(procs, ';');
+        prte_argv_free(procs);
+        procs = NULL;
+        if (PMIX_SUCCESS != (ret = PMIx_generate_ppn(tmp, &regex))) {
+            PMIX_ERROR_LOG(ret);
+            free(tmp);
+            PMIX_INFO_FREE(iptr, nalloc);
+            return prte_pmix_convert_status(ret);
+        }
+        free(tmp);
+#ifdef PMIX_REGEX
+        PMIX_INFO_LOAD(&iptr[n], PMIX_PROC_MAP, regex, PMIX_REGEX);
+#else
+        PMIX_INFO_LOAD(&iptr[n], PMIX_PROC_MAP, regex, PMIX_STRING);
+#endif
+        free(regex);
+        ++n;
+    }
+
+    /* pass the number of nodes in the job */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_NUM_NODES, &map->num_nodes, PMIX_UINT32);
+    ++n;
+
+    /* univ size */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_UNIV_SIZE, &jdata->total_slots_alloc, PMIX_UINT32);
+    ++n;
+
+    /* job size */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_JOB_SIZE, &jdata->num_procs, PMIX_UINT32);
+    ++n;
+
+    /* number of apps in this job */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_JOB_NUM_APPS, &jdata->num_apps, PMIX_UINT32);
+    ++n;
+
+    /* max procs */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_MAX_PROCS, &jdata->total_slots_alloc, PMIX_UINT32);
+    ++n;
+
+    /* pass the mapping policy used for this job */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_MAPBY, prte_rmaps_base_print_mapping(map->mapping), PMIX_STRING);
+    ++n;
+
+    /* pass the ranking policy used for this job */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_RANKBY, prte_rmaps_base_print_ranking(map->ranking), PMIX_STRING);
+    ++n;
+
+    /* pass the binding policy used for this job */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_BINDTO, prte_hwloc_base_print_binding(map->binding), PMIX_STRING);
+    ++n;
+
+#ifdef PMIX_HOSTNAME_KEEP_FQDN
+    /* tell the user what we did with FQDN */
+    PMIX_INFO_LOAD(&iptr[n], PMIX_HOSTNAME_KEEP_FQDN, &prte_keep_fqdn_hostnames, PMIX_BOOL);
+    ++n;
+#endif
+
+    /* for each app in the job, create an app-array */
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
+            continue;
+        }
+        PMIX_LOAD_KEY(iptr[n].key, PMIX_APP_INFO_ARRAY);
+        iptr[n].value.type = PMIX_DATA_ARRAY;
+        PMIX_DATA_ARRAY_CREATE(iptr[n].value.data.darray, PRTE_APP_INFO_NKEYS, PMIX_INFO);
+        kptr = (pmix_info_t*)iptr[n].value.data.darray->array;
+        m = 0;
+        /* start with the app number */
+        ui32 = i;
+        PMIX_INFO_LOAD(&kptr[m], PMIX_APPNUM, &ui32, PMIX_UINT32);
+        ++m;
+        /* add the app size */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_APP_SIZE, &app->num_procs, PMIX_UINT32);
+        ++m;
+        /* add the app leader */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_APPLDR, &app->first_rank, PMIX_PROC_RANK);
+        ++m;
+        /* add the wdir */
+        PMIX_INFO_LOAD(&kptr[m], PMIX_WDIR, app->cwd, PMIX_STRING);
+        ++m;
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+        /* add the argv */
+        tmp = prte_argv_join(app->argv, ' ');
+        PMIX_INFO_LOAD(&kptr[m], PMIX_APP_ARGV, tmp, PMIX_STRING);
+        ++m;
+        free(tmp);
+        /* add the pset name */
+        tmp = NULL;
+        if (prte_get_attribute(&app->attributes, PRTE_APP_PSET_NAME, (void**)&tmp, PMIX_STRING) &&
+            NULL != tmp) {
+            PMIX_INFO_LOAD(&kptr[m], PMIX_PSET_NAME, tmp, PMIX_STRING);
+            ++m;
+            free(tmp);
+        }
+#endif
+        iptr[n].value.data.darray->size = m;
+        ++n;
+    }
+
+    *info = iptr;
+    *ninfo = n;
+    return PRTE_SUCCESS;
+}
+
+int prte_pmix_server_pack_job_info(prte_job_t *jdata,
+                                   pmix_info_t *maps, size_t nmaps)
+{
+    int rc;
+    pmix_info_t *info;
+    size_t ninfo;
+    pmix_data_buffer_t pbkt;
+    pmix_byte_object_t pbo;
+    pmix_status_t ret;
+
+    if (NULL == jdata->map) {
+        return PRTE_SUCCESS;
+    }
+
+    if (PRTE_SUCCESS != (rc = build_job_info(jdata, maps, nmaps, &info, &ninfo))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+    ret = PMIx_Data_pack(NULL, &pbkt, &ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == ret) {
+        ret = PMIx_Data_pack(NULL, &pbkt, info, ninfo, PMIX_INFO);
+    }
+    PMIX_INFO_FREE(info, ninfo);
+    if (PMIX_SUCCESS == ret) {
+        ret = PMIx_Data_unload(&pbkt, &pbo);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return prte_pmix_convert_status(ret);
+    }
+
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_SHARED_INFO, PRTE_ATTR_GLOBAL, &pbo, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    return PRTE_SUCCESS;
+}
 
 /* stuff proc attributes for sending back to a proc */
 int prte_pmix_server_register_nspace(prte_job_t *jdata)
 {
     int rc;
     prte_proc_t *pptr;
-    int i, k, n, p;
-    prte_list_t *info, *pmap, nodeinfo, appinfo;
-    prte_info_item_t *kv, *kptr;
-    prte_info_array_item_t *iarray;
+    int i, k;
+    size_t n, m, nprocs;
+    prte_list_t *info;
+    prte_info_item_t *kv;
     prte_node_t *node;
     pmix_rank_t vpid;
-    char **list, **procs, **micro, *tmp, *regex;
+    char *tmp;
     prte_job_map_t *map;
-    prte_app_context_t *app;
     uid_t uid;
     gid_t gid;
     prte_list_t *cache;
     hwloc_obj_t machine;
     pmix_proc_t pproc;
     pmix_status_t ret;
-    pmix_info_t *pinfo, *iptr;
-    size_t ninfo;
+    pmix_info_t *pinfo, *iptr, *jinfo = NULL;
+    size_t ninfo, njinfo = 0;
     prte_pmix_lock_t lock;
     prte_list_t local_procs;
     prte_namelist_t *nm;
     size_t nmsize;
+    prte_pointer_array_t clients;
+    prte_client_reg_tracker_t regtrk;
+    pmix_byte_object_t *bo;
+    pmix_data_buffer_t jbkt;
+    int32_t cnt;
+    bool shared, local;
 #if PMIX_NUMERIC_VERSION >= 0x00040000
+    prte_app_context_t *app;
     pmix_server_pset_t *pset;
-    pmix_cpuset_t cpuset;
 #endif
+    char *locality;
     uint32_t ui32;
 
     prte_output_verbose(2, prte_pmix_server_globals.output,
@@ -93,10 +487,8 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         PRTE_JOBID_PRINT(jdata->nspace));
 
-    /* setup the info list */
+    /* setup the info list for the info that is specific to us */
     info = PRTE_NEW(prte_list_t);
-    PRTE_CONSTRUCT(&nodeinfo, prte_list_t);
-    PRTE_CONSTRUCT(&appinfo, prte_list_t);
     uid = geteuid();
     gid = getegid();
 
@@ -113,19 +505,6 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     PMIX_INFO_LOAD(&kv->info, PMIX_SERVER_RANK, &prte_process_info.myproc.rank, PMIX_PROC_RANK);
     prte_list_append(info, &kv->super);
 
-    /* jobid */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_LOAD_KEY(kv->info.key, PMIX_JOBID);
-    kv->info.value.type = PMIX_PROC;
-    PMIX_PROC_CREATE(kv->info.value.data.proc, 1);
-    PMIX_LOAD_NSPACE(kv->info.value.data.proc->nspace, jdata->nspace);
-    prte_list_append(info, &kv->super);
-
-    /* offset */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_NPROC_OFFSET, &jdata->offset, PMIX_PROC_RANK);
-    prte_list_append(info, &kv->super);
-
     /* check for cached values to add to the job info */
     cache = NULL;
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_INFO_CACHE, (void**)&cache, PMIX_POINTER) &&
@@ -137,163 +516,38 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
         PRTE_RELEASE(cache);
     }
 
-    /* assemble the node and proc map info */
-    list = NULL;
-    procs = NULL;
+    /* collect the procs on our node and count the procs in the job */
     map = jdata->map;
     PMIX_LOAD_NSPACE(pproc.nspace, jdata->nspace);
     PRTE_CONSTRUCT(&local_procs, prte_list_t);
+    PRTE_CONSTRUCT(&clients, prte_pointer_array_t);
+    prte_pointer_array_init(&clients, jdata->num_local_procs + 1, INT_MAX, 64);
+    nprocs = 0;
     for (i=0; i < map->nodes->size; i++) {
-        if (NULL != (node = (prte_node_t*)prte_pointer_array_get_item(map->nodes, i))) {
-            micro = NULL;
-            tmp = NULL;
-            vpid = PMIX_RANK_VALID;
-            ui32 = 0;
-            prte_argv_append_nosize(&list, node->name);
-            /* assemble all the ranks for this job that are on this node */
-            for (k=0; k < node->procs->size; k++) {
-                if (NULL != (pptr = (prte_proc_t*)prte_pointer_array_get_item(node->procs, k))) {
-                    if (PMIX_CHECK_NSPACE(jdata->nspace, pptr->name.nspace)) {
-                        prte_argv_append_nosize(&micro, PRTE_VPID_PRINT(pptr->name.rank));
-                        if (pptr->name.rank < vpid) {
-                            vpid = pptr->name.rank;
-                        }
-                        ++ui32;
-                    }
-                    if (PRTE_PROC_MY_NAME->rank == node->daemon->name.rank) {
-                        /* track all procs on our node */
-                        nm = PRTE_NEW(prte_namelist_t);
-                        PMIX_LOAD_PROCID(&nm->name, pptr->name.nspace, pptr->name.rank);
-                        prte_list_append(&local_procs, &nm->super);
-                        if (PMIX_CHECK_NSPACE(jdata->nspace, pptr->name.nspace)) {
-                            /* go ahead and register this client - since we are going to wait
-                             * for register_nspace to complete and the PMIx library serializes
-                             * the registration requests, we don't need to wait here */
-                            ret = PMIx_server_register_client(&pptr->name, uid, gid, (void*)pptr, NULL, NULL);
-                            if (PMIX_SUCCESS != ret && PMIX_OPERATION_SUCCEEDED != ret) {
-                                PMIX_ERROR_LOG(ret);
-                            }
-                        }
-                    }
-                }
-            }
-            /* assemble the rank/node map */
-            if (NULL != micro) {
-                tmp = prte_argv_join(micro, ',');
-                prte_argv_free(micro);
-                prte_argv_append_nosize(&procs, tmp);
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(map->nodes, i))) {
+            continue;
+        }
+        local = (PRTE_PROC_MY_NAME->rank == node->daemon->name.rank);
+        for (k=0; k < node->procs->size; k++) {
+            if (NULL == (pptr = (prte_proc_t*)prte_pointer_array_get_item(node->procs, k))) {
+                continue;
             }
-            /* construct the node info array */
-            iarray = PRTE_NEW(prte_info_array_item_t);
-            /* start with the hostname */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_HOSTNAME, node->name, PMIX_STRING);
-            prte_list_append(&iarray->infolist, &kv->super);
-#ifdef PMIX_HOSTNAME_ALIASES
-            /* add any aliases */
-            if (prte_get_attribute(&node->attributes, PRTE_NODE_ALIAS, (void**)&regex, PMIX_STRING) &&
-                NULL != regex) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_HOSTNAME_ALIASES, regex, PMIX_STRING);
-                prte_list_append(&iarray->infolist, &kv->super);
-                free(regex);
+            if (PMIX_CHECK_NSPACE(jdata->nspace, pptr->name.nspace)) {
+                ++nprocs;
             }
-#endif
-            /* pass the node ID */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_NODEID, &node->index, PMIX_UINT32);
-            prte_list_append(&iarray->infolist, &kv->super);
-            /* add node size */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_NODE_SIZE, &node->num_procs, PMIX_UINT32);
-            prte_list_append(&iarray->infolist, &kv->super);
-            /* add local size for this job */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_LOCAL_SIZE, &ui32, PMIX_UINT32);
-            prte_list_append(&iarray->infolist, &kv->super);
-            /* pass the local ldr */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_LOCALLDR, &vpid, PMIX_PROC_RANK);
-            prte_list_append(&iarray->infolist, &kv->super);
-            /* add the local peers */
-            if (NULL != tmp) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
-                prte_list_append(&iarray->infolist, &kv->super);
-                free(tmp);
+            if (local) {
+                /* track all procs on our node */
+                nm = PRTE_NEW(prte_namelist_t);
+                PMIX_LOAD_PROCID(&nm->name, pptr->name.nspace, pptr->name.rank);
+                prte_list_append(&local_procs, &nm->super);
+                if (PMIX_CHECK_NSPACE(jdata->nspace, pptr->name.nspace)) {
+                    /* collect this client - we will register all of them
+                     * in one pass once the job info is assembled */
+                    prte_pointer_array_add(&clients, pptr);
+                }
             }
-            /* add to the overall payload */
-            prte_list_append(&nodeinfo, &iarray->super);
         }
     }
-    /* let the PMIx server generate the nodemap regex */
-    if (NULL != list) {
-        tmp = prte_argv_join(list, ',');
-        prte_argv_free(list);
-        list = NULL;
-        if (PRTE_SUCCESS != (rc = PMIx_generate_regex(tmp, &regex))) {
-            PRTE_ERROR_LOG(rc);
-            free(tmp);
-            PRTE_LIST_RELEASE(info);
-            return rc;
-        }
-        free(tmp);
-        kv = PRTE_NEW(prte_info_item_t);
-#ifdef PMIX_REGEX
-        PMIX_INFO_LOAD(&kv->info, PMIX_NODE_MAP, regex, PMIX_REGEX);
-#else
-        PMIX_INFO_LOAD(&kv->info, PMIX_NODE_MAP, regex, PMIX_STRING);
-#endif
-        free(regex);
-        prte_list_append(info, &kv->super);
-    }
-
-    /* let the PMIx server generate the procmap regex */
-    if (NULL != procs) {
-        tmp = prte_argv_join(procs, ';');
-        prte_argv_free(procs);
-        procs = NULL;
-        if (PRTE_SUCCESS != (rc = PMIx_generate_ppn(tmp, &regex))) {
-            PRTE_ERROR_LOG(rc);
-            free(tmp);
-            PRTE_LIST_RELEASE(info);
-            return rc;
-        }
-        free(tmp);
-        kv = PRTE_NEW(prte_info_item_t);
-#ifdef PMIX_REGEX
-        PMIX_INFO_LOAD(&kv->info, PMIX_PROC_MAP, regex, PMIX_REGEX);
-#else
-        PMIX_INFO_LOAD(&kv->info, PMIX_PROC_MAP, regex, PMIX_STRING);
-#endif
-        free(regex);
-        prte_list_append(info, &kv->super);
-    }
-
-    /* pass the number of nodes in the job */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_NUM_NODES, &map->num_nodes, PMIX_UINT32);
-    prte_list_append(info, &kv->super);
-
-    /* univ size */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_UNIV_SIZE, &jdata->total_slots_alloc, PMIX_UINT32);
-    prte_list_append(info, &kv->super);
-
-    /* job size */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_JOB_SIZE, &jdata->num_procs, PMIX_UINT32);
-    prte_list_append(info, &kv->super);
-
-    /* number of apps in this job */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_JOB_NUM_APPS, &jdata->num_apps, PMIX_UINT32);
-    prte_list_append(info, &kv->super);
-
-    /* max procs */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_MAX_PROCS, &jdata->total_slots_alloc, PMIX_UINT32);
-    prte_list_append(info, &kv->super);
 
     /* topology signature */
     kv = PRTE_NEW(prte_info_item_t);
@@ -316,28 +570,6 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
         prte_list_append(info, &kv->super);
     }
 
-    /* pass the mapping policy used for this job */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_MAPBY, prte_rmaps_base_print_mapping(jdata->map->mapping), PMIX_STRING);
-    prte_list_append(info, &kv->super);
-
-    /* pass the ranking policy used for this job */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_RANKBY, prte_rmaps_base_print_ranking(jdata->map->ranking), PMIX_STRING);
-    prte_list_append(info, &kv->super);
-
-    /* pass the binding policy used for this job */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_BINDTO, prte_hwloc_base_print_binding(jdata->map->binding), PMIX_STRING);
-    prte_list_append(info, &kv->super);
-
-#ifdef PMIX_HOSTNAME_KEEP_FQDN
-    /* tell the user what we did with FQDN */
-    kv = PRTE_NEW(prte_info_item_t);
-    PMIX_INFO_LOAD(&kv->info, PMIX_HOSTNAME_KEEP_FQDN, &prte_keep_fqdn_hostnames, PMIX_BOOL);
-    prte_list_append(info, &kv->super);
-#endif
-
     /* pass the top-level session directory - this is our jobfam session dir */
     kv = PRTE_NEW(prte_info_item_t);
     PMIX_INFO_LOAD(&kv->info, PMIX_TMPDIR, prte_process_info.jobfam_session_dir, PMIX_STRING);
@@ -346,10 +578,17 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     /* create and pass a job-level session directory */
     if (0 > prte_asprintf(&tmp, "%s/%u", prte_process_info.jobfam_session_dir, PRTE_LOCAL_JOBID(jdata->nspace))) {
         PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        PRTE_LIST_RELEASE(info);
+        PRTE_LIST_DESTRUCT(&local_procs);
+        PRTE_DESTRUCT(&clients);
         return PRTE_ERR_OUT_OF_RESOURCE;
     }
     if (PRTE_SUCCESS != (rc = prte_os_dirpath_create(prte_process_info.jobfam_session_dir, S_IRWXU))) {
         PRTE_ERROR_LOG(rc);
+        free(tmp);
+        PRTE_LIST_RELEASE(info);
+        PRTE_LIST_DESTRUCT(&local_procs);
+        PRTE_DESTRUCT(&clients);
         return rc;
     }
     kv = PRTE_NEW(prte_info_item_t);
@@ -357,67 +596,129 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
     free(tmp);
     prte_list_append(info, &kv->super);
 
-    /* for each app in the job, create an app-array */
-    for (n=0; n < jdata->apps->size; n++) {
-        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, n))) {
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+    /* register any psets defined by the apps in this job */
+    for (i=0; i < jdata->apps->size; i++) {
+        if (NULL == (app = (prte_app_context_t*)prte_pointer_array_get_item(jdata->apps, i))) {
             continue;
         }
-        iarray = PRTE_NEW(prte_info_array_item_t);
-        /* start with the app number */
-        kv = PRTE_NEW(prte_info_item_t);
-        PMIX_INFO_LOAD(&kv->info, PMIX_APPNUM, &n, PMIX_UINT32);
-        prte_list_append(&iarray->infolist, &kv->super);
-        /* add the app size */
-        kv = PRTE_NEW(prte_info_item_t);
-        PMIX_INFO_LOAD(&kv->info, PMIX_APP_SIZE, &app->num_procs, PMIX_UINT32);
-        prte_list_append(&iarray->infolist, &kv->super);
-        /* add the app leader */
-        kv = PRTE_NEW(prte_info_item_t);
-        PMIX_INFO_LOAD(&kv->info, PMIX_APPLDR, &app->first_rank, PMIX_PROC_RANK);
-        prte_list_append(&iarray->infolist, &kv->super);
-        /* add the wdir */
-        kv = PRTE_NEW(prte_info_item_t);
-        PMIX_INFO_LOAD(&kv->info, PMIX_WDIR, app->cwd, PMIX_STRING);
-        prte_list_append(&iarray->infolist, &kv->super);
-#if PMIX_NUMERIC_VERSION >= 0x00040000
-        /* add the argv */
-        tmp = prte_argv_join(app->argv, ' ');
-        kv = PRTE_NEW(prte_info_item_t);
-        PMIX_INFO_LOAD(&kv->info, PMIX_APP_ARGV, tmp, PMIX_STRING);
-        free(tmp);
-        prte_list_append(&iarray->infolist, &kv->super);
-        /* add the pset name */
         tmp = NULL;
         if (prte_get_attribute(&app->attributes, PRTE_APP_PSET_NAME, (void**)&tmp, PMIX_STRING) &&
             NULL != tmp) {
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_PSET_NAME, tmp, PMIX_STRING);
-            prte_list_append(&iarray->infolist, &kv->super);
-            /* register it */
             pset = PRTE_NEW(pmix_server_pset_t);
-            pset->name = strdup(tmp);
+            pset->name = tmp;
             prte_list_append(&prte_pmix_server_globals.psets, &pset->super);
-            free(tmp);
         }
+    }
 #endif
-        /* add to the main payload */
-        prte_list_append(&appinfo, &iarray->super);
+
+    /* the job-level info that is common to all daemons is normally
+     * provided by the HNP in the launch msg, already packed so it can
+     * be unpacked directly into the array we hand to the PMIx server.
+     * Otherwise, we have to generate it ourselves */
+    shared = false;
+    bo = NULL;
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_SHARED_INFO, (void**)&bo, PMIX_BYTE_OBJECT) &&
+        NULL != bo) {
+        PMIX_DATA_BUFFER_CONSTRUCT(&jbkt);
+        ret = PMIx_Data_load(&jbkt, bo);
+        bo->bytes = NULL;
+        PMIX_BYTE_OBJECT_FREE(bo, 1);
+        if (PMIX_SUCCESS == ret) {
+            cnt = 1;
+            ret = PMIx_Data_unpack(NULL, &jbkt, &njinfo, &cnt, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == ret) {
+            shared = true;
+        } else {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&jbkt);
+        }
+        /* no longer needed */
+        prte_remove_attribute(&jdata->attributes, PRTE_JOB_SHARED_INFO);
     }
+    if (!shared) {
+        if (PRTE_SUCCESS != (rc = build_job_info(jdata, NULL, 0, &jinfo, &njinfo))) {
+            PRTE_ERROR_LOG(rc);
+            PRTE_LIST_RELEASE(info);
+            PRTE_LIST_DESTRUCT(&local_procs);
+            PRTE_DESTRUCT(&clients);
+            return rc;
+        }
+    }
+
+    /* setup the array we pass down */
+    ninfo = prte_list_get_size(info) + njinfo + nprocs;
+    /* if there are local procs, then we add that here */
+    if (0 < (nmsize = prte_list_get_size(&local_procs))) {
+        ++ninfo;
+    }
+    PMIX_INFO_CREATE(pinfo, ninfo);
+
+#if PMIX_NUMERIC_VERSION >= 0x00040000
+    /* first add the local procs, if they are defined */
+    if (0 < nmsize) {
+        pmix_proc_t *procs_tmp;
+        PMIX_LOAD_KEY(pinfo[0].key, PMIX_LOCAL_PROCS);
+        pinfo[0].value.type = PMIX_DATA_ARRAY;
+        PMIX_DATA_ARRAY_CREATE(pinfo[0].value.data.darray, nmsize, PMIX_PROC);
+        procs_tmp = (pmix_proc_t*)pinfo[0].value.data.darray->array;
+        n = 0;
+        PRTE_LIST_FOREACH(nm, &local_procs, prte_namelist_t) {
+            PMIX_LOAD_PROCID(&procs_tmp[n], nm->name.nspace, nm->name.rank);
+            ++n;
+        }
+    }
+#endif
+
+    PRTE_LIST_DESTRUCT(&local_procs);
+
+    /* now load our own job info */
+    if (0 < nmsize) {
+        n = 1;
+    } else {
+        n = 0;
+    }
+    PRTE_LIST_FOREACH(kv, info, prte_info_item_t) {
+        PMIX_INFO_XFER(&pinfo[n], &kv->info);
+        ++n;
+    }
+    PRTE_LIST_RELEASE(info);
+
+    /* add the common job info */
+    if (shared) {
+        cnt = njinfo;
+        ret = PMIx_Data_unpack(NULL, &jbkt, &pinfo[n], &cnt, PMIX_INFO);
+        PMIX_DATA_BUFFER_DESTRUCT(&jbkt);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_INFO_FREE(pinfo, ninfo);
+            PRTE_DESTRUCT(&clients);
+            return prte_pmix_convert_status(ret);
+        }
+    } else {
+        /* we own these entries, so just move them over */
+        memcpy(&pinfo[n], jinfo, njinfo * sizeof(pmix_info_t));
+        free(jinfo);
+    }
+    n += njinfo;
+
     /* for each proc in this job, create an object that
      * includes the info describing the proc so the recipient has a complete
      * picture. This allows procs to connect to each other without
      * any further info exchange, assuming the underlying transports
      * support it. We also pass all the proc-specific data here so
-     * that each proc can lookup info about every other proc in the job */
-
-    for (n=0; n < map->nodes->size; n++) {
-        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(map->nodes, n))) {
+     * that each proc can lookup info about every other proc in the job.
+     * The entries are loaded directly into the array we pass down */
+    for (i=0; i < map->nodes->size; i++) {
+        if (NULL == (node = (prte_node_t*)prte_pointer_array_get_item(map->nodes, i))) {
             continue;
         }
+        local = (PRTE_PROC_MY_NAME->rank == node->daemon->name.rank);
         /* cycle across each proc on this node, passing all data that
          * varies by proc */
-        for (i=0; i < node->procs->size; i++) {
-            if (NULL == (pptr = (prte_proc_t*)prte_pointer_array_get_item(node->procs, i))) {
+        for (k=0; k < node->procs->size; k++) {
+            if (NULL == (pptr = (prte_proc_t*)prte_pointer_array_get_item(node->procs, k))) {
                 continue;
             }
             /* only consider procs from this job */
@@ -425,57 +726,47 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
                 continue;
             }
             /* setup the proc map object */
-            pmap = PRTE_NEW(prte_list_t);
+            PMIX_LOAD_KEY(pinfo[n].key, PMIX_PROC_DATA);
+            pinfo[n].value.type = PMIX_DATA_ARRAY;
+            PMIX_DATA_ARRAY_CREATE(pinfo[n].value.data.darray, PRTE_PROC_INFO_NKEYS, PMIX_INFO);
+            iptr = (pmix_info_t*)pinfo[n].value.data.darray->array;
+            m = 0;
 
             /* must start with rank */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_RANK, &pptr->name.rank, PMIX_PROC_RANK);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&iptr[m], PMIX_RANK, &pptr->name.rank, PMIX_PROC_RANK);
+            ++m;
 
             /* location, for local procs */
-            if (PRTE_PROC_MY_NAME->rank == node->daemon->name.rank) {
+            if (local) {
                 tmp = NULL;
                 if (prte_get_attribute(&pptr->attributes, PRTE_PROC_CPU_BITMAP, (void**)&tmp, PMIX_STRING) &&
                     NULL != tmp) {
 #if PMIX_NUMERIC_VERSION >= 0x00040000
                     /* provide the cpuset string for this proc */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_CPUSET, tmp, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
-                    /* let PMIx generate the locality string */
-                    PMIX_CPUSET_CONSTRUCT(&cpuset);
-                    cpuset.source = "hwloc";
-                    cpuset.bitmap = hwloc_bitmap_alloc();
-                    hwloc_bitmap_list_sscanf(cpuset.bitmap, tmp);
-                    free(tmp);
-                    ret = PMIx_server_generate_locality_string(&cpuset, &tmp);
+                    PMIX_INFO_LOAD(&iptr[m], PMIX_CPUSET, tmp, PMIX_STRING);
+                    ++m;
+#endif
+                    locality = get_locality_string(tmp, &ret);
                     if (PMIX_SUCCESS != ret) {
                         PMIX_ERROR_LOG(ret);
-                        PRTE_LIST_RELEASE(pmap);
-                        PRTE_LIST_DESTRUCT(&appinfo);
-                        PRTE_LIST_RELEASE(info);
+                        free(tmp);
+                        pinfo[n].value.data.darray->size = m;
+                        PMIX_INFO_FREE(pinfo, ninfo);
+                        PRTE_DESTRUCT(&clients);
                         return prte_pmix_convert_status(ret);
                     }
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, tmp, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
-                    free(tmp);
-#else
-                    /* generate the locality string ourselves */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, prte_hwloc_base_get_locality_string(prte_hwloc_topology, tmp), PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
+                    PMIX_INFO_LOAD(&iptr[m], PMIX_LOCALITY_STRING, locality, PMIX_STRING);
+                    ++m;
+#if PMIX_NUMERIC_VERSION < 0x00040000
                     /* and also provide the cpuset string for this proc */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_CPUSET, tmp, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
-                    free(tmp);
+                    PMIX_INFO_LOAD(&iptr[m], PMIX_CPUSET, tmp, PMIX_STRING);
+                    ++m;
 #endif
+                    free(tmp);
                 } else {
                     /* the proc is not bound */
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
-                    prte_list_append(pmap, &kv->super);
+                    PMIX_INFO_LOAD(&iptr[m], PMIX_LOCALITY_STRING, NULL, PMIX_STRING);
+                    ++m;
                 }
                 /* debugger daemons and tools don't get session directories */
                 if (!PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_DEBUGGER_DAEMON) &&
@@ -485,157 +776,107 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
                                            prte_process_info.jobfam_session_dir,
                                            PRTE_LOCAL_JOBID(jdata->nspace), pptr->name.rank)) {
                         PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                        pinfo[n].value.data.darray->size = m;
+                        PMIX_INFO_FREE(pinfo, ninfo);
+                        PRTE_DESTRUCT(&clients);
                         return PRTE_ERR_OUT_OF_RESOURCE;
                     }
                     if (PRTE_SUCCESS != (rc = prte_os_dirpath_create(tmp, S_IRWXU))) {
                         PRTE_ERROR_LOG(rc);
+                        free(tmp);
+                        pinfo[n].value.data.darray->size = m;
+                        PMIX_INFO_FREE(pinfo, ninfo);
+                        PRTE_DESTRUCT(&clients);
                         return rc;
                     }
-                    kv = PRTE_NEW(prte_info_item_t);
-                    PMIX_INFO_LOAD(&kv->info, PMIX_PROCDIR, tmp, PMIX_STRING);
+                    PMIX_INFO_LOAD(&iptr[m], PMIX_PROCDIR, tmp, PMIX_STRING);
+                    ++m;
                     free(tmp);
-                    prte_list_append(pmap, &kv->super);
                 }
             }
 
             /* global/univ rank */
-            kv = PRTE_NEW(prte_info_item_t);
             vpid = pptr->name.rank + jdata->offset;
-            PMIX_INFO_LOAD(&kv->info, PMIX_GLOBAL_RANK, &vpid, PMIX_PROC_RANK);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&iptr[m], PMIX_GLOBAL_RANK, &vpid, PMIX_PROC_RANK);
+            ++m;
 
             /* appnum */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_APPNUM, &pptr->app_idx, PMIX_UINT32);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&iptr[m], PMIX_APPNUM, &pptr->app_idx, PMIX_UINT32);
+            ++m;
 
             /* app rank */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_APP_RANK, &pptr->app_rank, PMIX_PROC_RANK);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&iptr[m], PMIX_APP_RANK, &pptr->app_rank, PMIX_PROC_RANK);
+            ++m;
 
             /* local rank */
             if (PRTE_LOCAL_RANK_INVALID != pptr->local_rank) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_LOCAL_RANK, &pptr->local_rank, PMIX_UINT16);
-                prte_list_append(pmap, &kv->super);
+                PMIX_INFO_LOAD(&iptr[m], PMIX_LOCAL_RANK, &pptr->local_rank, PMIX_UINT16);
+                ++m;
             }
 
             /* node rank */
             if (PRTE_NODE_RANK_INVALID != pptr->node_rank) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_NODE_RANK, &pptr->node_rank, PMIX_UINT16);
-                prte_list_append(pmap, &kv->super);
+                PMIX_INFO_LOAD(&iptr[m], PMIX_NODE_RANK, &pptr->node_rank, PMIX_UINT16);
+                ++m;
             }
 
             /* node ID */
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_NODEID, &pptr->node->index, PMIX_UINT32);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&iptr[m], PMIX_NODEID, &pptr->node->index, PMIX_UINT32);
+            ++m;
 
 #if PMIX_NUMERIC_VERSION >= 0x00040000
             /* reincarnation number */
             ui32 = 0;  // we are starting this proc for the first time
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_INFO_LOAD(&kv->info, PMIX_REINCARNATION, &ui32, PMIX_UINT32);
-            prte_list_append(pmap, &kv->super);
+            PMIX_INFO_LOAD(&iptr[m], PMIX_REINCARNATION, &ui32, PMIX_UINT32);
+            ++m;
 #endif
 
             if (map->num_nodes < prte_hostname_cutoff) {
-                kv = PRTE_NEW(prte_info_item_t);
-                PMIX_INFO_LOAD(&kv->info, PMIX_HOSTNAME, pptr->node->name, PMIX_STRING);
-                prte_list_append(pmap, &kv->super);
+                PMIX_INFO_LOAD(&iptr[m], PMIX_HOSTNAME, pptr->node->name, PMIX_STRING);
+                ++m;
             }
-            kv = PRTE_NEW(prte_info_item_t);
-            PMIX_LOAD_KEY(kv->info.key, PMIX_PROC_DATA);
-            kv->info.value.type = PMIX_DATA_ARRAY;
-            ninfo = prte_list_get_size(pmap);
-            if (0 < ninfo) {
-                PMIX_DATA_ARRAY_CREATE(kv->info.value.data.darray, ninfo, PMIX_INFO);
-                pinfo = (pmix_info_t*)kv->info.value.data.darray->array;
-                p = 0;
-                while (NULL != (kptr = (prte_info_item_t*)prte_list_remove_first(pmap))) {
-                    PMIX_INFO_XFER(&pinfo[p], &kptr->info);
-                    PRTE_RELEASE(kptr);
-                    ++p;
-                }
-            }
-            prte_list_append(info, &kv->super);
+            pinfo[n].value.data.darray->size = m;
+            ++n;
         }
     }
 
     /* mark the job as registered */
     prte_set_attribute(&jdata->attributes, PRTE_JOB_NSPACE_REGISTERED, PRTE_ATTR_LOCAL, NULL, PMIX_BOOL);
 
-    /* pass it down */
-    ninfo = prte_list_get_size(info) + prte_list_get_size(&nodeinfo) + prte_list_get_size(&appinfo);
-    /* if there are local procs, then we add that here */
-    if (0 < (nmsize = prte_list_get_size(&local_procs))) {
-        ++ninfo;
-    }
-    PMIX_INFO_CREATE(pinfo, ninfo);
-
-#if PMIX_NUMERIC_VERSION >= 0x00040000
-    /* first add the local procs, if they are defined */
-    if (0 < nmsize) {
-        pmix_proc_t *procs_tmp;
-        PMIX_LOAD_KEY(pinfo[0].key, PMIX_LOCAL_PROCS);
-        pinfo[0].value.type = PMIX_DATA_ARRAY;
-        PMIX_DATA_ARRAY_CREATE(pinfo[0].value.data.darray, nmsize, PMIX_PROC);
-        procs_tmp = (pmix_proc_t*)pinfo[0].value.data.darray->array;
-        n = 0;
-        PRTE_LIST_FOREACH(nm, &local_procs, prte_namelist_t) {
-            PMIX_LOAD_PROCID(&procs_tmp[n], nm->name.nspace, nm->name.rank);
-            ++n;
-        }
-    }
-#endif
-
-    PRTE_LIST_DESTRUCT(&local_procs);
-
-    /* now load the rest of the job info */
-    if (0 < nmsize) {
-        n = 1;
-    } else {
-        n = 0;
-    }
-    PRTE_LIST_FOREACH(kv, info, prte_info_item_t) {
-        PMIX_INFO_XFER(&pinfo[n], &kv->info);
-        ++n;
-    }
-    PRTE_LIST_RELEASE(info);
-
-    /* now load the node info */
-    PRTE_LIST_FOREACH(iarray, &nodeinfo, prte_info_array_item_t) {
-        nmsize = prte_list_get_size(&iarray->infolist);
-        PMIX_LOAD_KEY(pinfo[n].key, PMIX_NODE_INFO_ARRAY);
-        pinfo[n].value.type = PMIX_DATA_ARRAY;
-        PMIX_DATA_ARRAY_CREATE(pinfo[n].value.data.darray, nmsize, PMIX_INFO);
-        iptr = (pmix_info_t*)pinfo[n].value.data.darray->array;
-        k=0;
-        PRTE_LIST_FOREACH(kv, &iarray->infolist, prte_info_item_t) {
-            PMIX_INFO_XFER(&iptr[k], &kv->info);
-            ++k;
+    /* register all of our local clients for this job in one pass. We
+     * don't wait for each one individually - the PMIx library serializes
+     * the requests, so they can proceed while we register the nspace and
+     * we only need to wait once for the entire batch */
+    PRTE_PMIX_CONSTRUCT_LOCK(&regtrk.lock);
+    /* hold one reference ourselves so the tracker cannot
+     * complete while we are still issuing requests */
+    regtrk.nreg = 1;
+    k = 0;
+    for (i=0; i < clients.size; i++) {
+        if (NULL == (pptr = (prte_proc_t*)prte_pointer_array_get_item(&clients, i))) {
+            continue;
         }
-        ++n;
-    }
-    PRTE_LIST_DESTRUCT(&nodeinfo);
-
-    /* now load the app info */
-    PRTE_LIST_FOREACH(iarray, &appinfo, prte_info_array_item_t) {
-        nmsize = prte_list_get_size(&iarray->infolist);
-        PMIX_LOAD_KEY(pinfo[n].key, PMIX_APP_INFO_ARRAY);
-        pinfo[n].value.type = PMIX_DATA_ARRAY;
-        PMIX_DATA_ARRAY_CREATE(pinfo[n].value.data.darray, nmsize, PMIX_INFO);
-        iptr = (pmix_info_t*)pinfo[n].value.data.darray->array;
-        k=0;
-        PRTE_LIST_FOREACH(kv, &iarray->infolist, prte_info_item_t) {
-            PMIX_INFO_XFER(&iptr[k], &kv->info);
-            ++k;
+        ++k;
+        prte_mutex_lock(&regtrk.lock.mutex);
+        ++regtrk.nreg;
+        prte_mutex_unlock(&regtrk.lock.mutex);
+        ret = PMIx_server_register_client(&pptr->name, uid, gid, (void*)pptr, regcbfunc, &regtrk);
+        if (PMIX_SUCCESS != ret) {
+            /* we won't get a callback for this one */
+            if (PMIX_OPERATION_SUCCEEDED != ret) {
+                PMIX_ERROR_LOG(ret);
+            }
+            regcbfunc(ret, &regtrk);
         }
-        ++n;
     }
-    PRTE_LIST_DESTRUCT(&appinfo);
+    PRTE_DESTRUCT(&clients);
+    /* release our own reference */
+    regcbfunc(PMIX_SUCCESS, &regtrk);
+
+    prte_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s register nspace %s: %d local clients issued",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        PRTE_JOBID_PRINT(jdata->nspace), k);
 
     /* register it */
     PRTE_PMIX_CONSTRUCT_LOCK(&lock);
@@ -646,13 +887,22 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
         PMIX_ERROR_LOG(ret);
         rc = prte_pmix_convert_status(ret);
         PMIX_INFO_FREE(pinfo, ninfo);
-        PRTE_LIST_RELEASE(info);
         PRTE_PMIX_DESTRUCT_LOCK(&lock);
+        /* must still let the client registrations complete */
+        PRTE_PMIX_WAIT_THREAD(&regtrk.lock);
+        PRTE_PMIX_DESTRUCT_LOCK(&regtrk.lock);
         return rc;
     }
     PRTE_PMIX_WAIT_THREAD(&lock);
     rc = lock.status;
     PRTE_PMIX_DESTRUCT_LOCK(&lock);
+    /* the client registrations were queued ahead of the nspace, so
+     * this should not require another round trip */
+    PRTE_PMIX_WAIT_THREAD(&regtrk.lock);
+    if (PRTE_SUCCESS == rc) {
+        rc = regtrk.lock.status;
+    }
+    PRTE_PMIX_DESTRUCT_LOCK(&regtrk.lock);
     if (PRTE_SUCCESS != rc) {
         PMIX_INFO_FREE(pinfo, ninfo);
         return rc;
@@ -743,3 +993,21 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     lock->status = prte_pmix_convert_status(status);
     PRTE_PMIX_WAKEUP_THREAD(lock);
 }
+
+static void regcbfunc(pmix_status_t status, void *cbdata)
+{
+    prte_client_reg_tracker_t *trk = (prte_client_reg_tracker_t*)cbdata;
+
+    prte_mutex_lock(&trk->lock.mutex);
+    if (PMIX_SUCCESS != status && PMIX_OPERATION_SUCCEEDED != status &&
+        PRTE_SUCCESS == trk->lock.status) {
+        trk->lock.status = prte_pmix_convert_status(status);
+    }
+    --trk->nreg;
+    if (0 == trk->nreg) {
+        trk->lock.active = false;
+        PRTE_POST_OBJECT(&trk->lock);
+        pthread_cond_broadcast(&trk->lock.cond);
+    }
+    prte_mutex_unlock(&trk->lock.mutex);
+}
@@ -90,11 +90,80 @@
  */
 static char *get_prted_comm_cmd_str(int command);
 
-static void _notify_release(pmix_status_t status, void *cbdata)
+/* tracker for a tool notification sent while halting the DVM - the
+ * info must be kept until PMIx reports the notification complete */
+typedef struct {
+    prte_object_t super;
+    prte_event_t ev;
+    pmix_info_t *info;
+    size_t ninfo;
+} prted_notify_caddy_t;
+static void ncon(prted_notify_caddy_t *p)
 {
-    prte_pmix_lock_t *lk = (prte_pmix_lock_t*)cbdata;
+    p->info = NULL;
+    p->ninfo = 0;
+}
+static void ndes(prted_notify_caddy_t *p)
+{
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+static PRTE_CLASS_INSTANCE(prted_notify_caddy_t,
+                           prte_object_t,
+                           ncon, ndes);
+
+/* number of tool notifications still in flight while halting */
+static int num_halt_notifies = 0;
+
+static void halt_vm(void)
+{
+    int32_t i;
+    prte_proc_t *proct;
 
-    PRTE_PMIX_WAKEUP_THREAD(lk);
+    /* flag that prteds were ordered to terminate */
+    prte_prteds_term_ordered = true;
+    if (PRTE_PROC_IS_MASTER) {
+        /* if all my routes and local children are gone, then terminate ourselves */
+        if (0 == prte_routed.num_routes()) {
+            for (i=0; i < prte_local_children->size; i++) {
+                if (NULL != (proct = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i)) &&
+                    PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_ALIVE)) {
+                    /* at least one is still alive */
+                    return;
+                }
+            }
+            /* call our appropriate exit procedure */
+            if (prte_debug_daemons_flag) {
+                prte_output(0, "%s prted_cmd: all routes and children gone - exiting",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+            }
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_DAEMONS_TERMINATED);
+        }
+    } else {
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_DAEMONS_TERMINATED);
+    }
+}
+
+static void halt_notify_complete(int sd, short args, void *cbdata)
+{
+    prted_notify_caddy_t *cd = (prted_notify_caddy_t*)cbdata;
+
+    PRTE_ACQUIRE_OBJECT(cd);
+    PRTE_RELEASE(cd);
+    /* the tools must all be told before we go away */
+    --num_halt_notifies;
+    if (0 == num_halt_notifies) {
+        halt_vm();
+    }
+}
+
+static void halt_notify_release(pmix_status_t status, void *cbdata)
+{
+    prted_notify_caddy_t *cd = (prted_notify_caddy_t*)cbdata;
+
+    /* continue the halt in our own event base */
+    PRTE_THREADSHIFT(cd, prte_event_base, halt_notify_complete, PRTE_MSG_PRI);
 }
 
 static prte_pointer_array_t *procs_prev_ordered_to_terminate = NULL;
@@ -120,17 +189,15 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
     int32_t num_procs, num_new_procs = 0, p;
     prte_proc_t *cur_proc = NULL, *prev_proc = NULL;
     bool found = false;
-    bool compressed;
     prte_node_t *node;
     FILE *fp;
     char gscmd[256], path[1035], *pathptr;
     char string[256], *string_ptr = string;
     char *coprocessors;
     prte_job_map_t *map;
-    prte_pmix_lock_t lk;
     pmix_proc_t pname;
     pmix_byte_object_t pbo;
-    pmix_topology_t ptopo;
+    prte_topology_t *t;
     char *tmp;
 
     /* unpack the command */
@@ -412,6 +479,8 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
         }
         /* kill the local procs */
         prte_odls.kill_local_procs(NULL);
+        /* hold the halt until every notification has been posted */
+        num_halt_notifies = 1;
         /* cycle thru our known jobs to find any that are tools - these
          * may not have been killed if, for example, we didn't start
          * them */
@@ -422,52 +491,48 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
             }
             if (PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_TOOL) &&
                 0 < prte_list_get_size(&jdata->children)) {
-                pmix_info_t info[3];
+                prted_notify_caddy_t *cd;
                 bool flag;
                 prte_job_t *jd;
                 pmix_status_t xrc = PMIX_ERR_JOB_TERMINATED;
+                pmix_status_t prc;
                 /* we need to notify this job that its CHILD job terminated
                  * as that is the job it is looking for */
                 jd = (prte_job_t*)prte_list_get_first(&jdata->children);
                 /* must notify this tool of termination so it can
                  * cleanly exit - otherwise, it may hang waiting for
                  * some kind of notification */
+                cd = PRTE_NEW(prted_notify_caddy_t);
+                cd->ninfo = 3;
+                PMIX_INFO_CREATE(cd->info, cd->ninfo);
                 /* ensure this only goes to the job terminated event handler */
                 flag = true;
-                PMIX_INFO_LOAD(&info[0], PMIX_EVENT_NON_DEFAULT, &flag, PMIX_BOOL);
+                PMIX_INFO_LOAD(&cd->info[0], PMIX_EVENT_NON_DEFAULT, &flag, PMIX_BOOL);
                 /* provide the status */
-                PMIX_INFO_LOAD(&info[1], PMIX_JOB_TERM_STATUS, &xrc, PMIX_STATUS);
+                PMIX_INFO_LOAD(&cd->info[1], PMIX_JOB_TERM_STATUS, &xrc, PMIX_STATUS);
                 /* tell the requestor which job */
                 PMIX_LOAD_PROCID(&pname, jd->nspace, PMIX_RANK_WILDCARD);
-                PMIX_INFO_LOAD(&info[2], PMIX_EVENT_AFFECTED_PROC, &pname, PMIX_PROC);
-                PRTE_PMIX_CONSTRUCT_LOCK(&lk);
-                PMIx_Notify_event(PMIX_ERR_JOB_TERMINATED, &pname, PMIX_RANGE_SESSION,
-                                  info, 3, _notify_release, &lk);
-                PRTE_PMIX_WAIT_THREAD(&lk);
-                PRTE_PMIX_DESTRUCT_LOCK(&lk);
-            }
-        }
-        /* flag that prteds were ordered to terminate */
-        prte_prteds_term_ordered = true;
-        if (PRTE_PROC_IS_MASTER) {
-            /* if all my routes and local children are gone, then terminate ourselves */
-            if (0 == prte_routed.num_routes()) {
-                for (i=0; i < prte_local_children->size; i++) {
-                    if (NULL != (proct = (prte_proc_t*)prte_pointer_array_get_item(prte_local_children, i)) &&
-                        PRTE_FLAG_TEST(proct, PRTE_PROC_FLAG_ALIVE)) {
-                        /* at least one is still alive */
-                        return;
+                PMIX_INFO_LOAD(&cd->info[2], PMIX_EVENT_AFFECTED_PROC, &pname, PMIX_PROC);
+                /* don't block the event base waiting for the notification
+                 * to go out - the halt resumes once they all have */
+                ++num_halt_notifies;
+                prc = PMIx_Notify_event(PMIX_ERR_JOB_TERMINATED, &pname, PMIX_RANGE_SESSION,
+                                        cd->info, cd->ninfo, halt_notify_release, cd);
+                if (PMIX_SUCCESS != prc) {
+                    /* the callback will not be called */
+                    if (PMIX_OPERATION_SUCCEEDED != prc) {
+                        PMIX_ERROR_LOG(prc);
                     }
+                    --num_halt_notifies;
+                    PRTE_RELEASE(cd);
                 }
-                /* call our appropriate exit procedure */
-                if (prte_debug_daemons_flag) {
-                    prte_output(0, "%s prted_cmd: all routes and children gone - exiting",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                }
-                PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_DAEMONS_TERMINATED);
             }
-        } else {
-            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_DAEMONS_TERMINATED);
+        }
+        /* release our hold - if no notifications are pending, then
+         * we can complete the halt now */
+        --num_halt_notifies;
+        if (0 == num_halt_notifies) {
+            halt_vm();
         }
         return;
 
@@ -517,12 +582,11 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
                         node->slots_inuse--;
                         node->num_procs--;
                     }
-                    /* deregister this proc - will be ignored if already done */
-                    PRTE_PMIX_CONSTRUCT_LOCK(&lk);
-                    PMIx_server_deregister_client(&proct->name, _notify_release, &lk);
-                    PRTE_PMIX_WAIT_THREAD(&lk);
-                    PRTE_PMIX_DESTRUCT_LOCK(&lk);
+                    /* deregister this proc - will be ignored if already done. PMIx
+                     * copies the name, so we don't need to wait for it */
+                    PMIx_server_deregister_client(&proct->name, prte_pmix_nowait_cbfunc, NULL);
                     /* set the entry in the node array to NULL */
+                    prte_node_untrack_binding(proct);
                     prte_pointer_array_set_item(node->procs, i, NULL);
                     /* release the proc once for the map entry */
                     PRTE_RELEASE(proct);
@@ -537,10 +601,7 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
             PRTE_RELEASE(map);
             jdata->map = NULL;
         }
-        PRTE_PMIX_CONSTRUCT_LOCK(&lk);
-        PMIx_server_deregister_nspace(job, _notify_release, &lk);
-        PRTE_PMIX_WAIT_THREAD(&lk);
-        PRTE_PMIX_DESTRUCT_LOCK(&lk);
+        PMIx_server_deregister_nspace(job, prte_pmix_nowait_cbfunc, NULL);
 
         /* cleanup any pending server ops */
         PMIX_LOAD_PROCID(&pname, job, PMIX_RANK_WILDCARD);
@@ -559,27 +620,32 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
 
         /****     REPORT TOPOLOGY COMMAND    ****/
     case PRTE_DAEMON_REPORT_TOPOLOGY_CMD:
-        PMIX_DATA_BUFFER_CONSTRUCT(&data);
+        PMIX_DATA_BUFFER_CREATE(answer);
         /* pack the topology signature */
-        ret = PMIx_Data_pack(NULL, &data, &prte_topo_signature, 1, PMIX_STRING);
+        ret = PMIx_Data_pack(NULL, answer, &prte_topo_signature, 1, PMIX_STRING);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
-            PMIX_DATA_BUFFER_DESTRUCT(&data);
+            PMIX_DATA_BUFFER_RELEASE(answer);
             goto CLEANUP;
         }
-        /* pack the topology */
-        ptopo.source = "hwloc";
-        ptopo.topology = prte_hwloc_topology;
-        ret = PMIx_Data_pack(NULL, &data, &ptopo, 1,PMIX_TOPO);
-        if (PMIX_SUCCESS != ret) {
+        /* pack the topology - this carries its object counts and
+         * the compressed topology so the requestor can defer
+         * importing it until it is actually needed */
+        t = prte_get_topology_object(prte_topo_signature);
+        if (NULL == t) {
+            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+            PMIX_DATA_BUFFER_RELEASE(answer);
+            goto CLEANUP;
+        }
+        if (PRTE_SUCCESS != (ret = prte_topology_pack(answer, t))) {
             PRTE_ERROR_LOG(ret);
-            PMIX_DATA_BUFFER_DESTRUCT(&data);
+            PMIX_DATA_BUFFER_RELEASE(answer);
             goto CLEANUP;
         }
 
         /* detect and add any coprocessors */
         coprocessors = prte_hwloc_base_find_coprocessors(prte_hwloc_topology);
-        ret = PMIx_Data_pack(NULL, &data, &coprocessors, 1, PMIX_STRING);
+        ret = PMIx_Data_pack(NULL, answer, &coprocessors, 1, PMIX_STRING);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
         }
@@ -588,43 +654,13 @@ void prte_daemon_recv(int status, pmix_proc_t* sender,
         }
         /* see if I am on a coprocessor */
         coprocessors = prte_hwloc_base_check_on_coprocessor();
-        ret = PMIx_Data_pack(NULL, &data, &coprocessors, 1, PMIX_STRING);
+        ret = PMIx_Data_pack(NULL, answer, &coprocessors, 1, PMIX_STRING);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
         }
         if (NULL!= coprocessors) {
             free(coprocessors);
         }
-        PMIX_DATA_BUFFER_CREATE(answer);
-        if (PMIx_Data_compress((uint8_t*)data.base_ptr, data.bytes_used,
-                               (uint8_t**)&pbo.bytes, &pbo.size)) {
-            /* the data was compressed - mark that we compressed it */
-            compressed = true;
-        } else {
-            /* mark that it was not compressed */
-            compressed = false;
-            pbo.bytes = data.base_ptr;
-            pbo.size = data.bytes_used;
-            data.base_ptr = NULL;
-            data.bytes_used = 0;
-        }
-        PMIX_DATA_BUFFER_DESTRUCT(&data);
-        ret = PMIx_Data_pack(NULL, answer, &compressed, 1, PMIX_BOOL);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            PMIX_DATA_BUFFER_RELEASE(answer);
-            goto CLEANUP;
-        }
-        /* pack the payload */
-        ret = PMIx_Data_pack(NULL, answer, &pbo, 1, PMIX_BYTE_OBJECT);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            PMIX_DATA_BUFFER_RELEASE(answer);
-            goto CLEANUP;
-        }
-        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
         /* send the data */
         if (0 > (ret = prte_rml.send_buffer_nb(sender, answer, PRTE_RML_TAG_TOPOLOGY_REPORT,
                                                prte_rml_send_callback, NULL))) {
@@ -36,6 +36,7 @@
 #include "src/util/argv.h"
 #include "src/util/output.h"
 #include "src/class/prte_pointer_array.h"
+#include "src/class/prte_hash_table.h"
 #include "src/pmix/pmix-internal.h"
 
 #include "src/mca/errmgr/errmgr.h"
@@ -65,6 +66,9 @@ typedef struct {
     /* and the values themselves */
     pmix_info_t *info;
     size_t ninfo;
+    /* position of each value in the data array of its
+     * key - -1 if the value is not indexed */
+    int *slots;
     /* the value itself */
 } prte_data_object_t;
 
@@ -77,6 +81,7 @@ static void construct(prte_data_object_t *ptr)
     ptr->persistence = PMIX_PERSIST_SESSION;
     ptr->info = NULL;
     ptr->ninfo = 0;
+    ptr->slots = NULL;
 }
 
 static void destruct(prte_data_object_t *ptr)
@@ -84,6 +89,9 @@ static void destruct(prte_data_object_t *ptr)
     if (NULL != ptr->info) {
         PMIX_INFO_FREE(ptr->info, ptr->ninfo);
     }
+    if (NULL != ptr->slots) {
+        free(ptr->slots);
+    }
 }
 
 static PRTE_CLASS_INSTANCE(prte_data_object_t,
@@ -100,10 +108,13 @@ typedef struct {
     pmix_data_range_t range;
     char **keys;
     prte_list_t answers;
+    /* last publish that considered this request */
+    uint32_t epoch;
 } prte_data_req_t;
 static void rqcon(prte_data_req_t *p)
 {
     p->keys = NULL;
+    p->epoch = 0;
     PRTE_CONSTRUCT(&p->answers, prte_list_t);
 }
 static void rqdes(prte_data_req_t *p)
@@ -115,13 +126,294 @@ static PRTE_CLASS_INSTANCE(prte_data_req_t,
                           prte_list_item_t,
                           rqcon, rqdes);
 
+/* define an object to track everything associated with a key - the
+ * published data objects that contain it and the lookup requests
+ * waiting for it to be published. The store holds the references
+ * to the data objects, while each waiting request is retained
+ * once for each key it is waiting on */
+typedef struct {
+    prte_object_t super;
+    char key[PMIX_MAX_KEYLEN+1];
+    prte_pointer_array_t data;
+    int ndata;
+    prte_pointer_array_t waiters;
+    int nwaiters;
+} prte_data_key_t;
+static void dkcon(prte_data_key_t *p)
+{
+    memset(p->key, 0, PMIX_MAX_KEYLEN+1);
+    PRTE_CONSTRUCT(&p->data, prte_pointer_array_t);
+    prte_pointer_array_init(&p->data, 1, INT_MAX, 8);
+    p->ndata = 0;
+    PRTE_CONSTRUCT(&p->waiters, prte_pointer_array_t);
+    prte_pointer_array_init(&p->waiters, 1, INT_MAX, 8);
+    p->nwaiters = 0;
+}
+static void dkdes(prte_data_key_t *p)
+{
+    prte_data_req_t *req;
+    int n;
+
+    PRTE_DESTRUCT(&p->data);
+    for (n=0; n < p->waiters.size; n++) {
+        if (NULL != (req = (prte_data_req_t*)prte_pointer_array_get_item(&p->waiters, n))) {
+            PRTE_RELEASE(req);
+        }
+    }
+    PRTE_DESTRUCT(&p->waiters);
+}
+static PRTE_CLASS_INSTANCE(prte_data_key_t,
+                          prte_object_t,
+                          dkcon, dkdes);
+
 /* local globals */
 static prte_pointer_array_t prte_data_server_store;
-static prte_list_t pending;
+static prte_hash_table_t prte_data_server_keys;
+static uint32_t prte_data_server_epoch = 0;
 static bool initialized = false;
 static int prte_data_server_output = -1;
 static int prte_data_server_verbosity = -1;
 
+static prte_data_key_t* find_key(const char *key, bool create)
+{
+    prte_data_key_t *dk;
+    size_t len;
+
+    len = strnlen(key, PMIX_MAX_KEYLEN);
+    if (0 == len) {
+        return NULL;
+    }
+    if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(&prte_data_server_keys, key, len, (void**)&dk)) {
+        return dk;
+    }
+    if (!create) {
+        return NULL;
+    }
+    dk = PRTE_NEW(prte_data_key_t);
+    memcpy(dk->key, key, len);
+    prte_hash_table_set_value_ptr(&prte_data_server_keys, dk->key, len, dk);
+    return dk;
+}
+
+/* drop a key that no longer has data or waiters */
+static void cleanup_key(prte_data_key_t *dk)
+{
+    if (0 < dk->ndata || 0 < dk->nwaiters) {
+        return;
+    }
+    prte_hash_table_remove_value_ptr(&prte_data_server_keys, dk->key, strlen(dk->key));
+    PRTE_RELEASE(dk);
+}
+
+/* drop the data object from the index of the given key - each
+ * value records its slot, so we don't have to search the key's
+ * data array, which can hold every object published */
+static void unindex_data(prte_data_key_t *dk, prte_data_object_t *data)
+{
+    size_t n;
+
+    for (n=0; n < data->ninfo; n++) {
+        if (0 > data->slots[n] ||
+            0 != strncmp(data->info[n].key, dk->key, PMIX_MAX_KEYLEN)) {
+            continue;
+        }
+        prte_pointer_array_set_item(&dk->data, data->slots[n], NULL);
+        data->slots[n] = -1;
+        --dk->ndata;
+    }
+}
+
+static int index_data(prte_data_object_t *data)
+{
+    prte_data_key_t *dk;
+    size_t n;
+
+    data->slots = (int*)malloc(data->ninfo * sizeof(int));
+    if (NULL == data->slots) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (n=0; n < data->ninfo; n++) {
+        data->slots[n] = -1;
+        if (NULL != (dk = find_key(data->info[n].key, true))) {
+            data->slots[n] = prte_pointer_array_add(&dk->data, data);
+            if (0 > data->slots[n]) {
+                data->slots[n] = -1;
+                cleanup_key(dk);
+                return PRTE_ERR_OUT_OF_RESOURCE;
+            }
+            ++dk->ndata;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+/* remove a data object from the index and the store */
+static void remove_data(prte_data_object_t *data)
+{
+    prte_data_key_t *dk;
+    size_t n;
+
+    for (n=0; NULL != data->slots && n < data->ninfo; n++) {
+        if (0 <= data->slots[n] &&
+            NULL != (dk = find_key(data->info[n].key, false))) {
+            unindex_data(dk, data);
+            cleanup_key(dk);
+        }
+    }
+    prte_pointer_array_set_item(&prte_data_server_store, data->index, NULL);
+    PRTE_RELEASE(data);
+}
+
+static void queue_request(prte_data_req_t *req)
+{
+    prte_data_key_t *dk;
+    int i;
+
+    for (i=0; NULL != req->keys[i]; i++) {
+        if (NULL != (dk = find_key(req->keys[i], true))) {
+            PRTE_RETAIN(req);
+            prte_pointer_array_add(&dk->waiters, req);
+            ++dk->nwaiters;
+        }
+    }
+}
+
+static void dequeue_request(prte_data_req_t *req)
+{
+    prte_data_key_t *dk;
+    int i, k;
+
+    /* protect the request until we are done with its keys */
+    PRTE_RETAIN(req);
+    for (i=0; NULL != req->keys[i]; i++) {
+        if (NULL == (dk = find_key(req->keys[i], false))) {
+            continue;
+        }
+        for (k=0; k < dk->waiters.size; k++) {
+            if (req == prte_pointer_array_get_item(&dk->waiters, k)) {
+                prte_pointer_array_set_item(&dk->waiters, k, NULL);
+                --dk->nwaiters;
+                PRTE_RELEASE(req);
+            }
+        }
+        cleanup_key(dk);
+    }
+    PRTE_RELEASE(req);
+}
+
+/* send a waiting lookup request whatever the given
+ * data object provides for the keys it requested */
+static int notify_request(prte_data_req_t *req, prte_data_object_t *data)
+{
+    pmix_data_buffer_t *reply, pbkt;
+    pmix_byte_object_t pbo;
+    prte_ds_info_t *rinfo;
+    uint8_t command = PRTE_PMIX_LOOKUP_CMD;
+    pmix_status_t ret;
+    size_t n;
+    int i, rc;
+
+    for (i=0; NULL != req->keys[i]; i++) {
+        /* cycle thru the data keys for matches */
+        for (n=0; n < data->ninfo; n++) {
+            prte_output_verbose(10, prte_data_server_output,
+                                "%s\tCHECKING %s TO %s",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                data->info[n].key, req->keys[i]);
+            if (0 == strncmp(data->info[n].key, req->keys[i], PMIX_MAX_KEYLEN)) {
+                /* track this response */
+                prte_output_verbose(10, prte_data_server_output,
+                                    "%s data server: adding %s data %s from %s:%d to response",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), data->info[n].key,
+                                    PMIx_Data_type_string(data->info[n].value.type),
+                                    data->owner.nspace, data->owner.rank);
+                rinfo = PRTE_NEW(prte_ds_info_t);
+                memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
+                rinfo->info = &data->info[n];
+                prte_list_append(&req->answers, &rinfo->super);
+                break;  // a key can only occur once
+            }
+        }
+    }
+    if (0 == (n = prte_list_get_size(&req->answers))) {
+        return PRTE_SUCCESS;
+    }
+
+    /* send it back to the requestor */
+    prte_output_verbose(1, prte_data_server_output,
+                        "%s data server: returning data to %s:%d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        req->requestor.nspace, req->requestor.rank);
+
+    PMIX_DATA_BUFFER_CREATE(reply);
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+    /* start with their room number */
+    ret = PMIx_Data_pack(NULL, reply, &req->room_number, 1, PMIX_INT);
+    if (PMIX_SUCCESS != ret) {
+        goto error;
+    }
+    /* we are responding to a lookup cmd */
+    ret = PMIx_Data_pack(NULL, reply, &command, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != ret) {
+        goto error;
+    }
+    /* if we found all of the requested keys, then indicate so */
+    if (n == (size_t)prte_argv_count(req->keys)) {
+        rc = PRTE_SUCCESS;
+    } else {
+        rc = PRTE_ERR_PARTIAL_SUCCESS;
+    }
+    /* return the status */
+    ret = PMIx_Data_pack(NULL, reply, &rc, 1, PMIX_INT);
+    if (PMIX_SUCCESS != ret) {
+        goto error;
+    }
+    /* pack the number of returned info's */
+    ret = PMIx_Data_pack(NULL, &pbkt, &n, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != ret) {
+        goto error;
+    }
+    /* loop thru and pack the individual responses */
+    while (NULL != (rinfo = (prte_ds_info_t*)prte_list_remove_first(&req->answers))) {
+        /* pack the data owner */
+        ret = PMIx_Data_pack(NULL, &pbkt, &rinfo->source, 1, PMIX_PROC);
+        if (PMIX_SUCCESS == ret) {
+            /* pack the data */
+            ret = PMIx_Data_pack(NULL, &pbkt, rinfo->info, 1, PMIX_INFO);
+        }
+        PRTE_RELEASE(rinfo);
+        if (PMIX_SUCCESS != ret) {
+            goto error;
+        }
+    }
+
+    /* unload the pmix buffer */
+    ret = PMIx_Data_unload(&pbkt, &pbo);
+    if (PMIX_SUCCESS != ret) {
+        goto error;
+    }
+    /* pack it into our reply */
+    ret = PMIx_Data_pack(NULL, reply, &pbo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    if (PMIX_SUCCESS != ret) {
+        goto error;
+    }
+    if (0 > (rc = prte_rml.send_buffer_nb(&req->proxy, reply, PRTE_RML_TAG_DATA_CLIENT,
+                                          prte_rml_send_callback, NULL))) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+    }
+    return rc;
+
+  error:
+    PMIX_ERROR_LOG(ret);
+    PRTE_LIST_DESTRUCT(&req->answers);
+    PRTE_CONSTRUCT(&req->answers, prte_list_t);
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+    PMIX_DATA_BUFFER_RELEASE(reply);
+    return PRTE_ERR_PACK_FAILURE;
+}
+
 int prte_data_server_init(void)
 {
     int rc;
@@ -154,7 +446,9 @@ int prte_data_server_init(void)
         return rc;
     }
 
-    PRTE_CONSTRUCT(&pending, prte_list_t);
+    /* index the published data and the pending lookups by key */
+    PRTE_CONSTRUCT(&prte_data_server_keys, prte_hash_table_t);
+    prte_hash_table_init(&prte_data_server_keys, 256);
 
     prte_rml.recv_buffer_nb(PRTE_NAME_WILDCARD,
                             PRTE_RML_TAG_DATA_SERVER,
@@ -169,19 +463,26 @@ void prte_data_server_finalize(void)
 {
     int32_t i;
     prte_data_object_t *data;
+    prte_data_key_t *dk;
+    void *key;
 
     if (!initialized) {
         return;
     }
     initialized = false;
 
+    /* releasing the keys also releases any pending requests */
+    PRTE_HASH_TABLE_FOREACH_PTR(key, dk, &prte_data_server_keys, {
+        PRTE_RELEASE(dk);
+    });
+    PRTE_DESTRUCT(&prte_data_server_keys);
+
     for (i=0; i < prte_data_server_store.size; i++) {
         if (NULL != (data = (prte_data_object_t*)prte_pointer_array_get_item(&prte_data_server_store, i))) {
             PRTE_RELEASE(data);
         }
     }
     PRTE_DESTRUCT(&prte_data_server_store);
-    PRTE_LIST_DESTRUCT(&pending);
 }
 
 void prte_data_server(int status, pmix_proc_t* sender,
@@ -191,7 +492,7 @@ void prte_data_server(int status, pmix_proc_t* sender,
     uint8_t command;
     int32_t count;
     prte_data_object_t *data;
-    pmix_data_buffer_t *answer, *reply;
+    pmix_data_buffer_t *answer;
     int rc, k;
     uint32_t ninfo, i;
     char **keys = NULL, *str;
@@ -199,7 +500,9 @@ void prte_data_server(int status, pmix_proc_t* sender,
     int room_number;
     uint32_t uid = UINT32_MAX;
     pmix_data_range_t range;
-    prte_data_req_t *req, *rqnext;
+    prte_data_req_t *req;
+    prte_data_key_t *dk;
+    prte_pointer_array_t matched;
     pmix_data_buffer_t pbkt;
     pmix_byte_object_t pbo;
     pmix_status_t ret;
@@ -305,136 +608,59 @@ void prte_data_server(int status, pmix_proc_t* sender,
             }
         }
 
-        /* store this object */
+        /* store this object and index it by its keys */
         data->index = prte_pointer_array_add(&prte_data_server_store, data);
+        if (PRTE_SUCCESS != (rc = index_data(data))) {
+            PRTE_ERROR_LOG(rc);
+            remove_data(data);
+            goto SEND_ERROR;
+        }
 
         prte_output_verbose(1, prte_data_server_output,
                             "%s data server: checking for pending requests",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
-        /* check for pending requests that match this data */
-        reply = NULL;
-        PRTE_LIST_FOREACH_SAFE(req, rqnext, &pending, prte_data_req_t) {
-            if (req->uid != data->uid) {
+        /* collect the pending requests waiting on any of the
+         * published keys - a request waiting on several of
+         * them must only be considered once */
+        PRTE_CONSTRUCT(&matched, prte_pointer_array_t);
+        prte_pointer_array_init(&matched, 1, INT_MAX, 8);
+        ++prte_data_server_epoch;
+        for (n=0; n < data->ninfo; n++) {
+            if (NULL == (dk = find_key(data->info[n].key, false))) {
                 continue;
             }
-            /* if the published range is constrained to namespace, then only
-             * consider this data if the publisher is
-             * in the same namespace as the requestor */
-            if (PMIX_RANGE_NAMESPACE == data->range) {
-                if (0 != strncmp(req->requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
+            for (k=0; k < dk->waiters.size; k++) {
+                req = (prte_data_req_t*)prte_pointer_array_get_item(&dk->waiters, k);
+                if (NULL == req || prte_data_server_epoch == req->epoch) {
                     continue;
                 }
-            }
-            for (i=0; NULL != req->keys[i]; i++) {
-                /* cycle thru the data keys for matches */
-                for (n=0; n < data->ninfo; n++) {
-                    prte_output_verbose(10, prte_data_server_output,
-                                        "%s\tCHECKING %s TO %s",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        data->info[n].key, req->keys[i]);
-                    if (0 == strncmp(data->info[n].key, req->keys[i], PMIX_MAX_KEYLEN)) {
-                        prte_output_verbose(10, prte_data_server_output,
-                                            "%s data server: packaging return",
-                                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                        /* track this response */
-                        prte_output_verbose(10, prte_data_server_output,
-                                            "%s data server: adding %s data %s from %s:%d to response",
-                                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), data->info[n].key,
-                                            PMIx_Data_type_string(data->info[n].value.type),
-                                            data->owner.nspace, data->owner.rank);
-                        rinfo = PRTE_NEW(prte_ds_info_t);
-                        memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
-                        rinfo->info = &data->info[n];
-                        prte_list_append(&req->answers, &rinfo->super);
-                        break;  // a key can only occur once
-                    }
-                }
-            }
-            if (0 < (n = prte_list_get_size(&req->answers))) {
-                /* send it back to the requestor */
-                prte_output_verbose(1, prte_data_server_output,
-                                     "%s data server: returning data to %s:%d",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     req->requestor.nspace, req->requestor.rank);
-
-                PMIX_DATA_BUFFER_CREATE(reply);
-                /* start with their room number */
-                rc = PMIx_Data_pack(NULL, reply, &req->room_number, 1, PMIX_INT);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-                /* we are responding to a lookup cmd */
-                command = PRTE_PMIX_LOOKUP_CMD;
-                rc = PMIx_Data_pack(NULL, reply, &command, 1, PMIX_UINT8);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-                /* if we found all of the requested keys, then indicate so */
-                if (n == (size_t)prte_argv_count(req->keys)) {
-                    i = PRTE_SUCCESS;
-                } else {
-                    i = (uint32_t) PRTE_ERR_PARTIAL_SUCCESS;
-                }
-                /* return the status */
-                rc = PMIx_Data_pack(NULL, reply, &i, 1, PMIX_INT);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-
-                /* pack the rest into a pmix_data_buffer_t */
-                PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
-
-                /* pack the number of returned info's */
-                if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &n, 1, PMIX_SIZE))) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                    rc = PRTE_ERR_PACK_FAILURE;
-                    goto SEND_ERROR;
+                req->epoch = prte_data_server_epoch;
+                if (req->uid != data->uid) {
+                    continue;
                 }
-                /* loop thru and pack the individual responses - this is somewhat less
-                 * efficient than packing an info array, but avoids another malloc
-                 * operation just to assemble all the return values into a contiguous
-                 * array */
-                while (NULL != (rinfo = (prte_ds_info_t*)prte_list_remove_first(&req->answers))) {
-                    /* pack the data owner */
-                    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRTE_ERR_PACK_FAILURE;
-                        goto SEND_ERROR;
-                    }
-                    /* pack the data */
-                    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, rinfo->info, 1, PMIX_INFO))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRTE_ERR_PACK_FAILURE;
-                        goto SEND_ERROR;
+                /* if the published range is constrained to namespace, then only
+                 * consider this data if the publisher is
+                 * in the same namespace as the requestor */
+                if (PMIX_RANGE_NAMESPACE == data->range) {
+                    if (0 != strncmp(req->requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
+                        continue;
                     }
                 }
-                PRTE_LIST_DESTRUCT(&req->answers);
-                PRTE_CONSTRUCT(&req->answers, prte_list_t);
-
-                /* unload the pmix buffer */
-                rc = PMIx_Data_unload(&pbkt, &pbo);
-
-                /* pack it into our reply */
-                rc = PMIx_Data_pack(NULL, reply, &pbo, 1, PMIX_BYTE_OBJECT);
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-                if (0 > (rc = prte_rml.send_buffer_nb(&req->proxy, reply, PRTE_RML_TAG_DATA_CLIENT,
-                                                      prte_rml_send_callback, NULL))) {
-                    PRTE_ERROR_LOG(rc);
-                    PRTE_RELEASE(reply);
-                }
+                PRTE_RETAIN(req);
+                prte_pointer_array_add(&matched, req);
+            }
+        }
+        /* answer them - each request is answered only once */
+        for (k=0; k < matched.size; k++) {
+            if (NULL == (req = (prte_data_req_t*)prte_pointer_array_get_item(&matched, k))) {
+                continue;
             }
+            notify_request(req, data);
+            dequeue_request(req);
+            PRTE_RELEASE(req);
         }
+        PRTE_DESTRUCT(&matched);
 
         /* tell the user it was wonderful... */
         rc = PRTE_SUCCESS;
@@ -486,6 +712,7 @@ void prte_data_server(int status, pmix_proc_t* sender,
         }
 
         /* unpack the number of directives, if any */
+        range = PMIX_RANGE_SESSION;  // default
         count = 1;
         if (PMIX_SUCCESS != (ret = PMIx_Data_unpack(NULL, buffer, &ninfo, &count, PMIX_SIZE))) {
             PMIX_ERROR_LOG(ret);
@@ -524,9 +751,12 @@ void prte_data_server(int status, pmix_proc_t* sender,
             prte_output_verbose(10, prte_data_server_output,
                                 "%s data server: looking for %s",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), keys[i]);
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < prte_data_server_store.size; k++) {
-                data = (prte_data_object_t*)prte_pointer_array_get_item(&prte_data_server_store, k);
+            /* cycle across the stored data that contains this key */
+            if (NULL == (dk = find_key(keys[i], false))) {
+                continue;
+            }
+            for (k=0; k < dk->data.size; k++) {
+                data = (prte_data_object_t*)prte_pointer_array_get_item(&dk->data, k);
                 if (NULL == data) {
                     continue;
                 }
@@ -562,6 +792,10 @@ void prte_data_server(int status, pmix_proc_t* sender,
                         rinfo->info = &data->info[n];
                         rinfo->persistence = data->persistence;
                         prte_list_append(&answers, &rinfo->super);
+                        if (PMIX_PERSIST_FIRST_READ == data->persistence) {
+                            /* the key is removed once it is returned */
+                            unindex_data(dk, data);
+                        }
                         prte_output_verbose(1, prte_data_server_output,
                                             "%s data server: adding %s to data from %s:%d",
                                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), data->info[n].key,
@@ -569,6 +803,7 @@ void prte_data_server(int status, pmix_proc_t* sender,
                     }
                 }
             }  // loop over stored data
+            cleanup_key(dk);
         }  // loop over keys
 
         if (0 < (nanswers = prte_list_get_size(&answers))) {
@@ -633,7 +868,9 @@ void prte_data_server(int status, pmix_proc_t* sender,
                 req->uid = uid;
                 req->range = range;
                 req->keys = keys;
-                prte_list_append(&pending, &req->super);
+                queue_request(req);
+                /* the keys now hold the references */
+                PRTE_RELEASE(req);
                 /* drop the partial response we have - we'll build it when everything
                  * becomes available */
                 PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
@@ -747,9 +984,12 @@ void prte_data_server(int status, pmix_proc_t* sender,
 
         /* cycle across the provided keys */
         for (i=0; NULL != keys[i]; i++) {
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < prte_data_server_store.size; k++) {
-                data = (prte_data_object_t*)prte_pointer_array_get_item(&prte_data_server_store, k);
+            /* cycle across the stored data that contains this key */
+            if (NULL == (dk = find_key(keys[i], false))) {
+                continue;
+            }
+            for (k=0; k < dk->data.size; k++) {
+                data = (prte_data_object_t*)prte_pointer_array_get_item(&dk->data, k);
                 if (NULL == data) {
                     continue;
                 }
@@ -766,25 +1006,23 @@ void prte_data_server(int status, pmix_proc_t* sender,
                 if (range != data->range) {
                     continue;
                 }
-                /* see if we have this key */
+                /* delete the key from the data object */
+                unindex_data(dk, data);
                 nanswers = 0;
                 for (n=0; n < data->ninfo; n++) {
-                    if (0 == strlen(data->info[n].key)) {
-                        ++nanswers;
-                        continue;
-                    }
                     if (0 == strncmp(data->info[n].key, keys[i], PMIX_MAX_KEYLEN)) {
-                        /* found it -  delete the object from the data store */
                         memset(data->info[n].key, 0, PMIX_MAX_KEYLEN+1);
+                    }
+                    if (0 == strlen(data->info[n].key)) {
                         ++nanswers;
                     }
                 }
                 /* if all the data has been removed, then remove the object */
                 if (nanswers == data->ninfo) {
-                    prte_pointer_array_set_item(&prte_data_server_store, k, NULL);
-                    PRTE_RELEASE(data);
+                    remove_data(data);
                 }
             }
+            cleanup_key(dk);
         }
         prte_argv_free(keys);
 
@@ -831,8 +1069,7 @@ void prte_data_server(int status, pmix_proc_t* sender,
                 continue;
             }
             /* remove the object */
-            prte_pointer_array_set_item(&prte_data_server_store, k, NULL);
-            PRTE_RELEASE(data);
+            remove_data(data);
         }
         /* no response is required */
         PRTE_RELEASE(answer);
@@ -97,8 +97,14 @@ int prte_finalize(void)
         }
         PRTE_RELEASE(jdata);
     }
+    if (NULL != prte_job_data_index) {
+        PRTE_RELEASE(prte_job_data_index);
+    }
     PRTE_RELEASE(prte_job_data);
 
+    if (NULL != prte_node_topologies_index) {
+        PRTE_RELEASE(prte_node_topologies_index);
+    }
 {
     prte_pointer_array_t * array = prte_node_topologies;
     int i;
@@ -119,8 +119,10 @@ int prte_stack_trace_wait_timeout = 30;
 
 /* global arrays for data storage */
 prte_pointer_array_t *prte_job_data = NULL;
+prte_hash_table_t *prte_job_data_index = NULL;
 prte_pointer_array_t *prte_node_pool = NULL;
 prte_pointer_array_t *prte_node_topologies = NULL;
+prte_hash_table_t *prte_node_topologies_index = NULL;
 prte_pointer_array_t *prte_local_children = NULL;
 pmix_rank_t prte_total_procs = 0;
 char *prte_base_compute_node_sig = NULL;
@@ -214,6 +216,23 @@ prte_job_t* prte_get_job_data_object(const pmix_nspace_t job)
     if (NULL == prte_job_data) {
         return NULL;
     }
+    if (NULL != prte_job_data_index) {
+        jptr = NULL;
+        if (PRTE_SUCCESS != prte_hash_table_get_value_ptr(prte_job_data_index, job,
+                                                          strnlen(job, PMIX_MAX_NSLEN),
+                                                          (void**)&jptr)) {
+            return NULL;
+        }
+        /* the object may have been removed from the array by
+         * someone still holding a reference to it */
+        if (0 > jptr->index ||
+            jptr != (prte_job_t*)prte_pointer_array_get_item(prte_job_data, jptr->index)) {
+            return NULL;
+        }
+        return jptr;
+    }
+
+    /* no index available - search the array */
     for (i=0; i < prte_job_data->size; i++) {
         if (NULL == (jptr = (prte_job_t*)prte_pointer_array_get_item(prte_job_data, i))) {
             continue;
@@ -228,13 +247,35 @@ prte_job_t* prte_get_job_data_object(const pmix_nspace_t job)
 int prte_set_job_data_object(prte_job_t *jdata)
 {
     prte_job_t *jptr;
-    int i, save = -1;
+    int i, rc, save = -1;
 
     /* if the job data wasn't setup, we cannot set the data */
     if (NULL == prte_job_data) {
         return PRTE_ERROR;
     }
 
+    if (NULL != prte_job_data_index) {
+        /* verify that we don't already have this object */
+        if (NULL != prte_get_job_data_object(jdata->nspace)) {
+            return PRTE_EXISTS;
+        }
+        /* the array tracks its lowest free slot, so this
+         * reuses the first hole just as the search below does */
+        jdata->index = prte_pointer_array_add(prte_job_data, jdata);
+        if (0 > jdata->index) {
+            return PRTE_ERROR;
+        }
+        rc = prte_hash_table_set_value_ptr(prte_job_data_index, jdata->nspace,
+                                           strnlen(jdata->nspace, PMIX_MAX_NSLEN), jdata);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            prte_pointer_array_set_item(prte_job_data, jdata->index, NULL);
+            jdata->index = -1;
+            return rc;
+        }
+        return PRTE_SUCCESS;
+    }
+
     /* verify that we don't already have this object */
     for (i=0; i < prte_job_data->size; i++) {
         if (NULL == (jptr = (prte_job_t*)prte_pointer_array_get_item(prte_job_data, i))) {
@@ -260,6 +301,246 @@ int prte_set_job_data_object(prte_job_t *jdata)
     return PRTE_SUCCESS;
 }
 
+uint64_t prte_topology_sig_digest(const char *sig)
+{
+    const unsigned char *c;
+    uint64_t digest = 0xcbf29ce484222325ULL;
+
+    /* 64-bit FNV-1a */
+    for (c = (const unsigned char*)sig; '\0' != *c; c++) {
+        digest ^= (uint64_t)*c;
+        digest *= 0x100000001b3ULL;
+    }
+    return digest;
+}
+
+prte_topology_t* prte_get_topology_object(const char *sig)
+{
+    prte_topology_t *t;
+    int i;
+
+    if (NULL == prte_node_topologies || NULL == sig) {
+        return NULL;
+    }
+    if (NULL != prte_node_topologies_index) {
+        t = NULL;
+        if (PRTE_SUCCESS != prte_hash_table_get_value_uint64(prte_node_topologies_index,
+                                                             prte_topology_sig_digest(sig),
+                                                             (void**)&t)) {
+            return NULL;
+        }
+        if (0 == strcmp(sig, t->sig)) {
+            return t;
+        }
+        /* two signatures share this digest - only the first
+         * one is indexed, so search for the others */
+    }
+
+    for (i=0; i < prte_node_topologies->size; i++) {
+        if (NULL == (t = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, i))) {
+            continue;
+        }
+        if (NULL != t->sig && 0 == strcmp(sig, t->sig)) {
+            return t;
+        }
+    }
+    return NULL;
+}
+
+int prte_set_topology_object(prte_topology_t *t)
+{
+    void *ptr;
+    int rc;
+
+    if (NULL == prte_node_topologies || NULL == t->sig) {
+        return PRTE_ERR_BAD_PARAM;
+    }
+    t->digest = prte_topology_sig_digest(t->sig);
+    t->index = prte_pointer_array_add(prte_node_topologies, t);
+    if (0 > t->index) {
+        return PRTE_ERROR;
+    }
+    if (NULL == prte_node_topologies_index) {
+        return PRTE_SUCCESS;
+    }
+    /* leave any existing entry alone - it is either the same
+     * signature, which was registered first, or a collision */
+    if (PRTE_SUCCESS == prte_hash_table_get_value_uint64(prte_node_topologies_index,
+                                                         t->digest, &ptr)) {
+        return PRTE_SUCCESS;
+    }
+    rc = prte_hash_table_set_value_uint64(prte_node_topologies_index, t->digest, t);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        prte_pointer_array_set_item(prte_node_topologies, t->index, NULL);
+        t->index = -1;
+        return rc;
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_topology_import(prte_topology_t *t)
+{
+    pmix_byte_object_t bo;
+    pmix_data_buffer_t buf;
+    pmix_topology_t ptopo;
+    hwloc_topology_t topo;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    if (NULL != t->topo) {
+        return PRTE_SUCCESS;
+    }
+    if (NULL == t->packed.bytes) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+    if (t->compressed) {
+        if (!PMIx_Data_decompress((uint8_t**)&bo.bytes, &bo.size,
+                                  (uint8_t*)t->packed.bytes, t->packed.size)) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            return PRTE_ERROR;
+        }
+    } else {
+        bo.bytes = (char*)malloc(t->packed.size);
+        if (NULL == bo.bytes) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        memcpy(bo.bytes, t->packed.bytes, t->packed.size);
+        bo.size = t->packed.size;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = PMIx_Data_load(&buf, &bo);
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, &buf, &ptopo, &cnt, PMIX_TOPO);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    topo = ptopo.topology;
+    ptopo.topology = NULL;
+    PMIX_TOPOLOGY_DESTRUCT(&ptopo);
+    /* Apply any CPU filters (not preserved by the XML) - this
+     * also sets up the summary data needed to map/bind procs */
+    prte_hwloc_base_filter_cpus(topo);
+    t->topo = topo;
+    if (!t->have_counts) {
+        prte_hwloc_base_get_topo_counts(topo, t->counts);
+        t->have_counts = true;
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_topology_pack(pmix_data_buffer_t *buf, prte_topology_t *t)
+{
+    pmix_data_buffer_t data;
+    pmix_topology_t ptopo;
+    pmix_status_t rc;
+
+    if (!t->have_counts) {
+        if (NULL == t->topo) {
+            return PRTE_ERR_NOT_FOUND;
+        }
+        prte_hwloc_base_get_topo_counts(t->topo, t->counts);
+        t->have_counts = true;
+    }
+    if (NULL == t->packed.bytes) {
+        if (NULL == t->topo) {
+            return PRTE_ERR_NOT_FOUND;
+        }
+        PMIX_DATA_BUFFER_CONSTRUCT(&data);
+        ptopo.source = "hwloc";
+        ptopo.topology = t->topo;
+        rc = PMIx_Data_pack(NULL, &data, &ptopo, 1, PMIX_TOPO);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&data);
+            return prte_pmix_convert_status(rc);
+        }
+        if (PMIx_Data_compress((uint8_t*)data.base_ptr, data.bytes_used,
+                               (uint8_t**)&t->packed.bytes, &t->packed.size)) {
+            /* the data was compressed - mark that we compressed it */
+            t->compressed = true;
+        } else {
+            t->compressed = false;
+            t->packed.bytes = data.base_ptr;
+            t->packed.size = data.bytes_used;
+            data.base_ptr = NULL;
+            data.bytes_used = 0;
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&data);
+    }
+
+    rc = PMIx_Data_pack(NULL, buf, t->counts, PRTE_HWLOC_COUNT_MAX, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    rc = PMIx_Data_pack(NULL, buf, &t->compressed, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    rc = PMIx_Data_pack(NULL, buf, &t->packed, 1, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_topology_unpack(pmix_data_buffer_t *buf, prte_topology_t *t)
+{
+    int32_t cnt;
+    pmix_status_t rc;
+
+    cnt = PRTE_HWLOC_COUNT_MAX;
+    rc = PMIx_Data_unpack(NULL, buf, t->counts, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    t->have_counts = true;
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &t->compressed, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&t->packed);
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &t->packed, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+bool prte_topology_get_count(prte_topology_t *t, prte_hwloc_count_t kind,
+                             unsigned int *count)
+{
+    if (NULL == t || PRTE_HWLOC_COUNT_MAX <= kind) {
+        return false;
+    }
+    if (!t->have_counts) {
+        if (NULL == t->topo) {
+            return false;
+        }
+        prte_hwloc_base_get_topo_counts(t->topo, t->counts);
+        t->have_counts = true;
+    }
+    *count = t->counts[kind];
+    return true;
+}
+
 prte_proc_t* prte_get_proc_object(const pmix_proc_t *proc)
 {
     prte_job_t *jdata;
@@ -319,6 +600,68 @@ prte_node_rank_t prte_get_proc_node_rank(const pmix_proc_t *proc)
     return proct->node_rank;
 }
 
+static void release_usage(prte_node_t *node)
+{
+    uint64_t key;
+    prte_hwloc_obj_data_t *data;
+
+    if (NULL == node->usage) {
+        return;
+    }
+    PRTE_HASH_TABLE_FOREACH(key, uint64, data, node->usage) {
+        PRTE_RELEASE(data);
+    }
+    PRTE_RELEASE(node->usage);
+    node->usage = NULL;
+    node->usage_topo = NULL;
+}
+
+void prte_node_track_binding(prte_node_t *node, prte_proc_t *proc, hwloc_obj_t obj)
+{
+    prte_hwloc_obj_data_t *data;
+    uint64_t key;
+
+    prte_node_untrack_binding(proc);
+    if (NULL == node || NULL == obj) {
+        return;
+    }
+    if (NULL != node->usage && node->usage_topo != node->topology) {
+        /* the objects belong to a topology no longer in use */
+        release_usage(node);
+    }
+    if (NULL == node->usage) {
+        node->usage = PRTE_NEW(prte_hash_table_t);
+        prte_hash_table_init(node->usage, 32);
+        node->usage_topo = node->topology;
+    }
+    key = (uint64_t)(uintptr_t)obj;
+    if (PRTE_SUCCESS != prte_hash_table_get_value_uint64(node->usage, key, (void**)&data)) {
+        data = PRTE_NEW(prte_hwloc_obj_data_t);
+        prte_hash_table_set_value_uint64(node->usage, key, data);
+    }
+    data->num_bound++;
+    proc->usage_node = node;
+    proc->usage_obj = obj;
+}
+
+void prte_node_untrack_binding(prte_proc_t *proc)
+{
+    prte_node_t *node = proc->usage_node;
+    prte_hwloc_obj_data_t *data;
+
+    if (NULL == node) {
+        return;
+    }
+    if (NULL != node->usage &&
+        PRTE_SUCCESS == prte_hash_table_get_value_uint64(node->usage, (uint64_t)(uintptr_t)proc->usage_obj,
+                                                         (void**)&data) &&
+        0 < data->num_bound) {
+        data->num_bound--;
+    }
+    proc->usage_node = NULL;
+    proc->usage_obj = NULL;
+}
+
 bool prte_node_match(prte_node_t *n1, char *name)
 {
     char **n2names = NULL;
@@ -583,6 +926,18 @@ static void prte_job_destruct(prte_job_t* job)
     if (NULL != prte_job_data && 0 <= job->index) {
         /* remove the job from the global array */
         prte_pointer_array_set_item(prte_job_data, job->index, NULL);
+        /* and from the index, provided the entry is ours - a
+         * copy of the job may share our nspace */
+        if (NULL != prte_job_data_index) {
+            void *ptr = NULL;
+            if (PRTE_SUCCESS == prte_hash_table_get_value_ptr(prte_job_data_index, job->nspace,
+                                                              strnlen(job->nspace, PMIX_MAX_NSLEN),
+                                                              &ptr) &&
+                ptr == (void*)job) {
+                prte_hash_table_remove_value_ptr(prte_job_data_index, job->nspace,
+                                                 strnlen(job->nspace, PMIX_MAX_NSLEN));
+            }
+        }
     }
 }
 
@@ -612,6 +967,8 @@ static void prte_node_construct(prte_node_t* node)
     node->slots_inuse = 0;
     node->slots_max = 0;
     node->topology = NULL;
+    node->usage = NULL;
+    node->usage_topo = NULL;
 
     node->flags = 0;
     PRTE_CONSTRUCT(&node->attributes, prte_list_t);
@@ -636,10 +993,15 @@ static void prte_node_destruct(prte_node_t* node)
     for (i=0; i < node->procs->size; i++) {
         if (NULL != (proc = (prte_proc_t*)prte_pointer_array_get_item(node->procs, i))) {
             prte_pointer_array_set_item(node->procs, i, NULL);
+            if (node == proc->usage_node) {
+                proc->usage_node = NULL;
+                proc->usage_obj = NULL;
+            }
             PRTE_RELEASE(proc);
         }
     }
     PRTE_RELEASE(node->procs);
+    release_usage(node);
 
     /* do NOT destroy the topology */
 
@@ -670,7 +1032,10 @@ static void prte_proc_construct(prte_proc_t* proc)
     proc->state = PRTE_PROC_STATE_UNDEF;
     proc->app_idx = 0;
     proc->node = NULL;
+    proc->usage_node = NULL;
+    proc->usage_obj = NULL;
     proc->exit_code = 0;      /* Assume we won't fail unless otherwise notified */
+    proc->state_version = 0;
     proc->rml_uri = NULL;
     proc->flags = 0;
     PRTE_CONSTRUCT(&proc->attributes, prte_list_t);
@@ -678,6 +1043,8 @@ static void prte_proc_construct(prte_proc_t* proc)
 
 static void prte_proc_destruct(prte_proc_t* proc)
 {
+    prte_node_untrack_binding(proc);
+
     if (NULL != proc->node) {
         PRTE_RELEASE(proc->node);
         proc->node = NULL;
@@ -754,17 +1121,33 @@ PRTE_CLASS_INSTANCE(prte_attribute_t,
 
 static void tcon(prte_topology_t *t)
 {
+    t->index = -1;
     t->topo = NULL;
     t->sig = NULL;
+    t->digest = 0;
+    memset(t->counts, 0, sizeof(t->counts));
+    t->have_counts = false;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&t->packed);
+    t->compressed = false;
 }
 static void tdes(prte_topology_t *t)
 {
+    void *ptr = NULL;
+
+    /* remove it from the index, provided the entry is ours */
+    if (NULL != prte_node_topologies_index && 0 <= t->index &&
+        PRTE_SUCCESS == prte_hash_table_get_value_uint64(prte_node_topologies_index,
+                                                         t->digest, &ptr) &&
+        ptr == (void*)t) {
+        prte_hash_table_remove_value_uint64(prte_node_topologies_index, t->digest);
+    }
     if (NULL != t->topo) {
         prte_hwloc_base_free_topology(t->topo);
     }
     if (NULL != t->sig) {
         free(t->sig);
     }
+    PMIX_BYTE_OBJECT_DESTRUCT(&t->packed);
 }
 PRTE_CLASS_INSTANCE(prte_topology_t,
                    prte_object_t,
@@ -207,12 +207,24 @@ struct prte_job_map_t;
 /************/
 
 /* define an object for storing node topologies */
-typedef struct {
+struct prte_topology_t {
     prte_object_t super;
     int index;
     hwloc_topology_t topo;
     char *sig;
-} prte_topology_t;
+    /* fixed-size digest of the signature - used to index
+     * the topology in prte_node_topologies_index */
+    uint64_t digest;
+    /* object counts, indexed by prte_hwloc_count_t - available
+     * before the topology itself has been imported */
+    uint32_t counts[PRTE_HWLOC_COUNT_MAX];
+    bool have_counts;
+    /* the topology as packed (and possibly compressed) by the
+     * daemon that reported it - held until the topology is needed */
+    pmix_byte_object_t packed;
+    bool compressed;
+};
+typedef struct prte_topology_t prte_topology_t;
 PRTE_EXPORT PRTE_CLASS_DECLARATION(prte_topology_t);
 
 
@@ -298,6 +310,11 @@ typedef struct {
     int32_t slots_max;
     /* system topology for this node */
     prte_topology_t *topology;
+    /* number of procs bound to each object in the topology, keyed
+     * by the object - maintained as procs are bound and removed, and
+     * only valid for the topology it was built against */
+    prte_hash_table_t *usage;
+    prte_topology_t *usage_topo;
     /* flags */
     prte_node_flags_t flags;
     /* list of prte_attribute_t */
@@ -412,10 +429,17 @@ struct prte_proc_t {
     prte_proc_state_t state;
     /* exit code */
     prte_exit_code_t exit_code;
+    /* state machine version at the last change of state */
+    uint64_t state_version;
     /* the app_context that generated this proc */
     prte_app_idx_t app_idx;
     /* pointer to the node where this proc is executing */
     prte_node_t *node;
+    /* node and object where this proc is counted in the
+     * node's binding usage, if it is - the object is the
+     * same one recorded in its PRTE_PROC_HWLOC_BOUND attribute */
+    prte_node_t *usage_node;
+    hwloc_obj_t usage_obj;
     /* RML contact info */
     char *rml_uri;
     /* some boolean flags */
@@ -442,6 +466,48 @@ PRTE_EXPORT prte_job_t* prte_get_job_data_object(const pmix_nspace_t job);
  */
 PRTE_EXPORT int prte_set_job_data_object(prte_job_t *jdata);
 
+/**
+ * Compute the fixed-size digest of a topology signature
+ */
+PRTE_EXPORT uint64_t prte_topology_sig_digest(const char *sig);
+
+/**
+ * Get the known topology with the given signature, or NULL
+ * if we don't have it
+ */
+PRTE_EXPORT prte_topology_t* prte_get_topology_object(const char *sig);
+
+/**
+ * Add a topology to the array of known topologies - the object's
+ * signature must already be set. Sets the object's index.
+ */
+PRTE_EXPORT int prte_set_topology_object(prte_topology_t *t);
+
+/**
+ * Import a topology that is only held in packed form - a no-op if
+ * it has already been imported. Anything that needs topo must call
+ * this first, as remote topologies are imported on first use.
+ */
+PRTE_EXPORT int prte_topology_import(prte_topology_t *t);
+
+/**
+ * Pack a topology - its object counts followed by the packed hwloc
+ * topology, which is generated from topo if not already held
+ */
+PRTE_EXPORT int prte_topology_pack(pmix_data_buffer_t *buf, prte_topology_t *t);
+
+/**
+ * Unpack a topology packed by prte_topology_pack, without importing it
+ */
+PRTE_EXPORT int prte_topology_unpack(pmix_data_buffer_t *buf, prte_topology_t *t);
+
+/**
+ * Get the number of objects of the given kind in a topology, whether
+ * or not it has been imported. Returns false if it is not known.
+ */
+PRTE_EXPORT bool prte_topology_get_count(prte_topology_t *t, prte_hwloc_count_t kind,
+                                         unsigned int *count);
+
 /** Pack/unpack a job object */
 PRTE_EXPORT int prte_job_pack(pmix_data_buffer_t *bkt,
                               prte_job_t *job);
@@ -513,6 +579,13 @@ PRTE_EXPORT prte_node_rank_t prte_get_proc_node_rank(const pmix_proc_t *proc);
 /* check to see if two nodes match */
 PRTE_EXPORT bool prte_node_match(prte_node_t *n1, char *name);
 
+/* count a proc as bound to the given object on a node, replacing
+ * any prior record for that proc */
+PRTE_EXPORT void prte_node_track_binding(prte_node_t *node, prte_proc_t *proc, hwloc_obj_t obj);
+
+/* remove a proc from the binding usage of the node where it is counted */
+PRTE_EXPORT void prte_node_untrack_binding(prte_proc_t *proc);
+
 /* global variables used by RTE - instanced in prte_globals.c */
 PRTE_EXPORT extern bool prte_debug_daemons_flag;
 PRTE_EXPORT extern bool prte_debug_daemons_file_flag;
@@ -574,8 +647,14 @@ PRTE_EXPORT extern prte_timer_t *prte_mpiexec_timeout;
 
 /* global arrays for data storage */
 PRTE_EXPORT extern prte_pointer_array_t *prte_job_data;
+/* nspace -> prte_job_t index into prte_job_data, maintained by
+ * prte_set_job_data_object and the prte_job_t destructor */
+PRTE_EXPORT extern prte_hash_table_t *prte_job_data_index;
 PRTE_EXPORT extern prte_pointer_array_t *prte_node_pool;
 PRTE_EXPORT extern prte_pointer_array_t *prte_node_topologies;
+/* signature digest -> prte_topology_t index into prte_node_topologies,
+ * maintained by prte_set_topology_object */
+PRTE_EXPORT extern prte_hash_table_t *prte_node_topologies_index;
 PRTE_EXPORT extern prte_pointer_array_t *prte_local_children;
 PRTE_EXPORT extern pmix_rank_t prte_total_procs;
 PRTE_EXPORT extern char *prte_base_compute_node_sig;
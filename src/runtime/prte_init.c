@@ -291,6 +291,13 @@ int prte_init(int* pargc, char*** pargv, prte_proc_type_t flags)
         error = "setup job array";
         goto error;
     }
+    prte_job_data_index = PRTE_NEW(prte_hash_table_t);
+    if (PRTE_SUCCESS != (ret = prte_hash_table_init(prte_job_data_index,
+                                                    PRTE_GLOBAL_ARRAY_BLOCK_SIZE))) {
+        PRTE_ERROR_LOG(ret);
+        error = "setup job index";
+        goto error;
+    }
     prte_node_pool = PRTE_NEW(prte_pointer_array_t);
     if (PRTE_SUCCESS != (ret = prte_pointer_array_init(prte_node_pool,
                                PRTE_GLOBAL_ARRAY_BLOCK_SIZE,
@@ -309,6 +316,13 @@ int prte_init(int* pargc, char*** pargv, prte_proc_type_t flags)
         error = "setup node topologies array";
         goto error;
     }
+    prte_node_topologies_index = PRTE_NEW(prte_hash_table_t);
+    if (PRTE_SUCCESS != (ret = prte_hash_table_init(prte_node_topologies_index,
+                                                    PRTE_GLOBAL_ARRAY_BLOCK_SIZE))) {
+        PRTE_ERROR_LOG(ret);
+        error = "setup node topologies index";
+        goto error;
+    }
 
     /* open the SCHIZO framework as everyone needs it, and the
      * ess will use it to help select its component */
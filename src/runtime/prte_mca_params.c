@@ -64,6 +64,7 @@ char *prte_set_max_sys_limits = NULL;
 int prte_abort_delay = 0;
 bool prte_abort_print_stack = false;
 int prte_pmix_verbose_output = 0;
+bool prte_pmix_check_blocking_waits = false;
 
 int prte_max_thread_in_progress = 1;
 
@@ -642,6 +643,14 @@ int prte_register_params(void)
                           PRTE_MCA_BASE_VAR_SCOPE_READONLY,
                           &prte_pmix_verbose_output);
 
+    prte_pmix_check_blocking_waits = false;
+    prte_mca_base_var_register("prte", "prte", NULL, "pmix_check_blocking_waits",
+                          "Report any blocking wait on a PMIx operation that is executed from within the event base (debug aid)",
+                          PRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, PRTE_MCA_BASE_VAR_FLAG_NONE,
+                          PRTE_INFO_LVL_9,
+                          PRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                          &prte_pmix_check_blocking_waits);
+
 #if PRTE_ENABLE_FT
     prte_mca_base_var_register("prte", "prte", NULL, "enable_ft",
                         "Enable/disable fault tolerance",
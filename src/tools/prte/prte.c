@@ -1117,11 +1117,15 @@ int prte(int argc, char *argv[])
     PMIX_INFO_FREE(iptr, 1);
 #endif
 
+    /* from here on, this thread only progresses the event base */
+    prte_pmix_mark_event_thread();
+
     /* loop the event lib until an exit event is detected */
     while (prte_event_base_active) {
         prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
     }
     PRTE_ACQUIRE_OBJECT(prte_event_base_active);
+    prte_pmix_clear_event_thread();
 
 #if PMIX_NUMERIC_VERSION >= 0x00040000
     /* close the push of our stdin */
@@ -705,50 +705,22 @@ int main(int argc, char *argv[])
     /* if we are rank=1, then send our topology back - otherwise, prte
      * will request it if necessary */
     if (1 == PRTE_PROC_MY_NAME->rank) {
-        pmix_data_buffer_t data;
-        pmix_topology_t ptopo;
-        bool compressed;
+        prte_topology_t *t;
 
-        /* setup an intermediate buffer */
-        PMIX_DATA_BUFFER_CONSTRUCT(&data);
-
-        ptopo.source = "hwloc";
-        ptopo.topology = prte_hwloc_topology;
-        prc = PMIx_Data_pack(NULL, &data, &ptopo, 1, PMIX_TOPO);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
+        /* send it along with its object counts so prte can
+         * hold it without importing it */
+        t = prte_get_topology_object(prte_topo_signature);
+        if (NULL == t) {
+            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
             PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PMIX_DATA_BUFFER_DESTRUCT(&data);
+            ret = PRTE_ERR_NOT_FOUND;
             goto DONE;
         }
-        if (PMIx_Data_compress((uint8_t*)data.base_ptr, data.bytes_used,
-                                (uint8_t**)&pbo.bytes, &pbo.size)) {
-            /* the data was compressed - mark that we compressed it */
-            compressed = true;
-        } else {
-            compressed = false;
-            pbo.bytes = data.base_ptr;
-            pbo.size = data.bytes_used;
-            data.base_ptr = NULL;
-            data.bytes_used = 0;
-        }
-        PMIX_DATA_BUFFER_DESTRUCT(&data);
-        prc = PMIx_Data_pack(NULL, &buffer, &compressed, 1, PMIX_BOOL);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
-            PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            goto DONE;
-        }
-        /* pack the data */
-        prc = PMIx_Data_pack(NULL, &buffer, &pbo, 1, PMIX_BYTE_OBJECT);
-        if (PMIX_SUCCESS != prc) {
-            PMIX_ERROR_LOG(prc);
+        if (PRTE_SUCCESS != (ret = prte_topology_pack(&buffer, t))) {
+            PRTE_ERROR_LOG(ret);
             PMIX_DATA_BUFFER_DESTRUCT(&buffer);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
             goto DONE;
         }
-        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
     }
 
     /* collect our network inventory */
@@ -875,11 +847,15 @@ int main(int argc, char *argv[])
     }
     ret = PRTE_SUCCESS;
 
+    /* from here on, this thread only progresses the event base */
+    prte_pmix_mark_event_thread();
+
     /* loop the event lib until an exit event is detected */
     while (prte_event_base_active) {
         prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
     }
     PRTE_ACQUIRE_OBJECT(prte_event_base_active);
+    prte_pmix_clear_event_thread();
 
     /* ensure all local procs are dead */
     prte_odls.kill_local_procs(NULL);
@@ -63,6 +63,37 @@ bool prte_get_attribute(prte_list_t *attributes,
     return false;
 }
 
+uint32_t prte_get_attribute_flags(prte_list_t *attributes,
+                                  const prte_attribute_key_t *keys,
+                                  int nkeys)
+{
+    prte_attribute_t *kv;
+    uint32_t flags = 0, all;
+    int n;
+
+    if (0 >= nkeys || 32 < nkeys) {
+        return 0;
+    }
+    all = (32 == nkeys) ? UINT32_MAX : ((1u << nkeys) - 1);
+
+    PRTE_LIST_FOREACH(kv, attributes, prte_attribute_t) {
+        for (n=0; n < nkeys; n++) {
+            if (keys[n] != kv->key || (flags & (1u << n))) {
+                continue;
+            }
+            if (PMIX_BOOL != kv->data.type) {
+                PRTE_ERROR_LOG(PRTE_ERR_TYPE_MISMATCH);
+                continue;
+            }
+            flags |= (1u << n);
+        }
+        if (all == flags) {
+            break;
+        }
+    }
+    return flags;
+}
+
 int prte_set_attribute(prte_list_t *attributes,
                        prte_attribute_key_t key, bool local,
                        void *data, pmix_data_type_t type)
@@ -449,6 +480,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "JOB_NOINHERIT";
         case PRTE_JOB_FILE:
             return "JOB-FILE";
+        case PRTE_JOB_SHARED_INFO:
+            return "JOB-SHARED-INFO";
 
         case PRTE_PROC_NOBARRIER:
             return "PROC-NOBARRIER";
@@ -478,6 +511,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "PROC-CGROUP";
         case PRTE_PROC_NBEATS:
             return "PROC-NBEATS";
+        case PRTE_PROC_CPU_AFFINITY:
+            return "PROC-CPU-AFFINITY";
 
         case PRTE_RML_TRANSPORT_TYPE:
             return "RML-TRANSPORT-TYPE";
@@ -188,6 +188,7 @@ typedef uint16_t prte_job_flags_t;
 #define PRTE_JOB_PPR                    (PRTE_JOB_START_KEY + 81)    // char* - string specifying the procs-per-resource pattern
 #define PRTE_JOB_NOINHERIT              (PRTE_JOB_START_KEY + 82)    // bool do NOT inherit parent's mapping/ranking/binding policies
 #define PRTE_JOB_FILE                   (PRTE_JOB_START_KEY + 83)    // char* - file to use for sequential or rankfile mapping
+#define PRTE_JOB_SHARED_INFO            (PRTE_JOB_START_KEY + 84)    // pmix_byte_object_t - packed job-level info common to all daemons
 
 #define PRTE_JOB_MAX_KEY   300
 
@@ -227,6 +228,7 @@ typedef uint16_t prte_proc_flags_t;
 #define PRTE_PROC_NODENAME        (PRTE_PROC_START_KEY + 12)           // string - node where proc is located, used only by tools
 #define PRTE_PROC_CGROUP          (PRTE_PROC_START_KEY + 13)           // string - name of cgroup this proc shall be assigned to
 #define PRTE_PROC_NBEATS          (PRTE_PROC_START_KEY + 14)           // int32 - number of heartbeats in current window
+#define PRTE_PROC_CPU_AFFINITY    (PRTE_PROC_START_KEY + 15)           // byte object - precomputed cpu/memory binding masks to apply in the child
 
 #define PRTE_PROC_MAX_KEY   400
 
@@ -257,6 +259,13 @@ PRTE_EXPORT const char *prte_attr_key_to_str(prte_attribute_key_t key);
 PRTE_EXPORT bool prte_get_attribute(prte_list_t *attributes, prte_attribute_key_t key,
                                       void **data, pmix_data_type_t type);
 
+/* Check a set of boolean attributes in a single pass over the list,
+ * returning a mask with bit n set if keys[n] is present - at
+ * most 32 keys can be checked */
+PRTE_EXPORT uint32_t prte_get_attribute_flags(prte_list_t *attributes,
+                                              const prte_attribute_key_t *keys,
+                                              int nkeys);
+
 /* Set the named attribute in a list, overwriting any prior entry */
 PRTE_EXPORT int prte_set_attribute(prte_list_t *attributes, prte_attribute_key_t key,
                                      bool local, void *data, pmix_data_type_t type);
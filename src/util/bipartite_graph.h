@@ -21,6 +21,8 @@
 #ifndef PRTE_BP_GRAPH_H
 #define PRTE_BP_GRAPH_H
 
+#include "prte_config.h"
+
 struct prte_bp_graph_vertex_t;
 struct prte_bp_graph_edge_t;
 struct prte_bp_graph_t;
@@ -45,7 +47,7 @@ typedef void (*prte_bp_graph_cleanup_fn_t)(void *user_data);
  *
  * @returns PRTE_SUCCESS or an OMPI error code
  */
-int prte_bp_graph_create(prte_bp_graph_cleanup_fn_t v_data_cleanup_fn,
+PRTE_EXPORT int prte_bp_graph_create(prte_bp_graph_cleanup_fn_t v_data_cleanup_fn,
 			 prte_bp_graph_cleanup_fn_t e_data_cleanup_fn,
 			 prte_bp_graph_t **g_out);
 
@@ -57,7 +59,7 @@ int prte_bp_graph_create(prte_bp_graph_cleanup_fn_t v_data_cleanup_fn,
  *
  * @returns PRTE_SUCCESS or an OMPI error code
  */
-int prte_bp_graph_free(prte_bp_graph_t *g);
+PRTE_EXPORT int prte_bp_graph_free(prte_bp_graph_t *g);
 
 /**
  * clone (deep copy) the given graph
@@ -71,7 +73,7 @@ int prte_bp_graph_free(prte_bp_graph_t *g);
  * @param[in] g_clone_out     the resulting cloned graph
  * @returns PRTE_SUCCESS or an OMPI error code
  */
-int prte_bp_graph_clone(const prte_bp_graph_t *g,
+PRTE_EXPORT int prte_bp_graph_clone(const prte_bp_graph_t *g,
 			bool copy_user_data,
 			prte_bp_graph_t **g_clone_out);
 
@@ -82,7 +84,7 @@ int prte_bp_graph_clone(const prte_bp_graph_t *g,
  * @param[in] vertex  the vertex id to query
  * @returns the number of edges for which this vertex is a destination
  */
-int prte_bp_graph_indegree(const prte_bp_graph_t *g,
+PRTE_EXPORT int prte_bp_graph_indegree(const prte_bp_graph_t *g,
 			   int vertex);
 
 /**
@@ -92,7 +94,7 @@ int prte_bp_graph_indegree(const prte_bp_graph_t *g,
  * @param[in] vertex  the vertex id to query
  * @returns the number of edges for which this vertex is a source
  */
-int prte_bp_graph_outdegree(const prte_bp_graph_t *g,
+PRTE_EXPORT int prte_bp_graph_outdegree(const prte_bp_graph_t *g,
 			    int vertex);
 
 /**
@@ -107,7 +109,7 @@ int prte_bp_graph_outdegree(const prte_bp_graph_t *g,
  *
  * @returns PRTE_SUCCESS or an OMPI error code
  */
-int prte_bp_graph_add_edge(prte_bp_graph_t *g,
+PRTE_EXPORT int prte_bp_graph_add_edge(prte_bp_graph_t *g,
 			   int from,
 			   int to,
 			   int64_t cost,
@@ -123,7 +125,7 @@ int prte_bp_graph_add_edge(prte_bp_graph_t *g,
  *
  * @returns PRTE_SUCCESS or an OMPI error code
  */
-int prte_bp_graph_add_vertex(prte_bp_graph_t *g,
+PRTE_EXPORT int prte_bp_graph_add_vertex(prte_bp_graph_t *g,
 			     void *v_data,
 			     int *index_out);
 
@@ -132,7 +134,7 @@ int prte_bp_graph_add_vertex(prte_bp_graph_t *g,
  *
  * @param[in] g the graph to query
  */
-int prte_bp_graph_order(const prte_bp_graph_t *g);
+PRTE_EXPORT int prte_bp_graph_order(const prte_bp_graph_t *g);
 
 /**
  * This function solves the "assignment problem":
@@ -158,7 +160,7 @@ int prte_bp_graph_order(const prte_bp_graph_t *g);
  *
  * @returns PRTE_SUCCESS or an OMPI error code
  */
-int prte_bp_graph_solve_bipartite_assignment(const prte_bp_graph_t *g,
+PRTE_EXPORT int prte_bp_graph_solve_bipartite_assignment(const prte_bp_graph_t *g,
 					     int *num_match_edges_out,
 					     int **match_edges_out);
 
@@ -359,8 +359,7 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
     size_t sz, nslots;
     pmix_data_buffer_t bucket;
     prte_topology_t *t;
-    pmix_topology_t pt;
-    char **topos = NULL;
+    int *tpos = NULL;
 
     /* make room for the number of slots on each node */
     nslots = sizeof(uint16_t) * prte_node_pool->size;
@@ -368,6 +367,11 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
     /* and for the flags for each node - only need one bit/node */
     nbitmap = (prte_node_pool->size / 8) + 1;
     flags = (uint8_t*)calloc(1, nbitmap);
+    if (NULL == slots || NULL == flags) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
 
     /* indicate if we have hetero nodes */
     if (prte_hetero_nodes) {
@@ -384,34 +388,40 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
     /* we only need to send topologies if we have hetero nodes */
     if (prte_hetero_nodes) {
         PMIX_DATA_BUFFER_CONSTRUCT(&bucket);
-        pt.source = strdup("hwloc");
         ntopos = 0;
+        /* track the position of each topology in the buffer so we
+         * don't have to search for each node's signature */
+        tpos = (int*)malloc(prte_node_topologies->size * sizeof(int));
+        if (NULL == tpos) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            PMIX_DATA_BUFFER_DESTRUCT(&bucket);
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
         for (n=0; n < prte_node_topologies->size; n++) {
+            tpos[n] = -1;
             if (NULL == (t = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, n))) {
                 continue;
             }
+            tpos[n] = ntopos;
             /* pack the topology string */
             rc = PMIx_Data_pack(NULL, &bucket, &t->sig, 1, PMIX_STRING);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_DATA_BUFFER_DESTRUCT(&bucket);
-                free(pt.source);
                 goto cleanup;
             }
-            /* track it */
-            prte_argv_append_nosize(&topos, t->sig);
-            /* pack the topology itself */
-            pt.topology = t->topo;
-            rc = PMIx_Data_pack(NULL, &bucket, &pt, 1, PMIX_TOPO);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
+            /* pack the topology itself - this reuses the form in
+             * which the daemon reported it, so the topology need
+             * not have been imported here */
+            rc = prte_topology_pack(&bucket, t);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
                 PMIX_DATA_BUFFER_DESTRUCT(&bucket);
-                free(pt.source);
                 goto cleanup;
             }
             ++ntopos;
         }
-        free(pt.source);
         /* pack the number of topologies */
         rc = PMIx_Data_pack(NULL, buffer, &ntopos, 1, PMIX_INT32);
         if (PMIX_SUCCESS != rc) {
@@ -471,16 +481,21 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
                 PMIX_DATA_BUFFER_DESTRUCT(&bucket);
                 goto cleanup;
             }
-            /* find this signature in the topos */
-            for (m=0; NULL != topos[m]; m++) {
-                if (0 == strcmp(topos[m], nptr->topology->sig)) {
-                    rc = PMIx_Data_pack(NULL, &bucket, &m, 1, PMIX_INT);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_DATA_BUFFER_DESTRUCT(&bucket);
-                        goto cleanup;
-                    }
-                    break;
+            /* find the position of this node's topology */
+            t = nptr->topology;
+            if (0 <= t->index && t->index < prte_node_topologies->size &&
+                t == (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, t->index)) {
+                m = tpos[t->index];
+            } else {
+                t = prte_get_topology_object(t->sig);
+                m = (NULL == t) ? -1 : tpos[t->index];
+            }
+            if (0 <= m) {
+                rc = PMIx_Data_pack(NULL, &bucket, &m, 1, PMIX_INT);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_DATA_BUFFER_DESTRUCT(&bucket);
+                    goto cleanup;
                 }
             }
         }
@@ -641,8 +656,8 @@ int prte_util_pass_node_info(pmix_data_buffer_t *buffer)
     if (NULL != flags) {
         free(flags);
     }
-    if (NULL != topos) {
-        prte_argv_free(topos);
+    if (NULL != tpos) {
+        free(tpos);
     }
     return rc;
 }
@@ -652,7 +667,7 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
     int8_t i8;
     int16_t i16;
     int32_t ntopos;
-    bool compressed, found;
+    bool compressed;
     int rc = PRTE_SUCCESS, cnt, n, m;
     prte_node_t *nptr;
     size_t sz;
@@ -661,12 +676,8 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
     uint8_t *flags = NULL;
     uint8_t *bytes = NULL;
     prte_topology_t *t2, *t3;
-    pmix_topology_t ptopo;
-    hwloc_topology_t topo;
     char *sig;
     pmix_data_buffer_t bucket;
-    hwloc_obj_t root;
-    prte_hwloc_topo_data_t *sum;
     char **topos = NULL;
     pmix_rank_t drk;
 
@@ -737,42 +748,30 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
             /* cache it */
             prte_argv_append_nosize(&topos, sig);
             /* unpack the topology */
-            cnt = 1;
-            rc = PMIx_Data_unpack(NULL, &bucket, &ptopo, &cnt, PMIX_TOPO);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
+            t2 = PRTE_NEW(prte_topology_t);
+            rc = prte_topology_unpack(&bucket, t2);
+            if (PRTE_SUCCESS != rc) {
+                PRTE_ERROR_LOG(rc);
+                PRTE_RELEASE(t2);
+                free(sig);
                 goto cleanup;
             }
-            topo = ptopo.topology;
-            ptopo.topology = NULL;
-            PMIX_TOPOLOGY_DESTRUCT(&ptopo);
-            /* see if we already have it - there aren't many topologies
-             * in a cluster, so this won't take long */
-            found = false;
-            for (m=0; m < prte_node_topologies->size; m++) {
-                t3 = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, m);
-                if (NULL == t3) {
-                    continue;
-                }
-                if (0 == strcmp(sig, t3->sig)) {
-                    found = true;
-                    break;
-                }
-            }
-            if (found) {
-                hwloc_topology_destroy(topo);
+            /* see if we already have it */
+            if (NULL != prte_get_topology_object(sig)) {
+                PRTE_RELEASE(t2);
                 free(sig);
             } else {
+                /* import it - this also sets up the summary */
+                rc = prte_topology_import(t2);
+                if (PRTE_SUCCESS != rc) {
+                    PRTE_ERROR_LOG(rc);
+                    PRTE_RELEASE(t2);
+                    free(sig);
+                    goto cleanup;
+                }
                 /* record it */
-                t2 = PRTE_NEW(prte_topology_t);
                 t2->sig = sig;
-                t2->topo = topo;
-                /* need to ensure the summary is setup */
-                root = hwloc_get_root_obj(topo);
-                root->userdata = (void*)PRTE_NEW(prte_hwloc_topo_data_t);
-                sum = (prte_hwloc_topo_data_t*)root->userdata;
-                sum->available = prte_hwloc_base_setup_summary(topo);
-                t2->index = prte_pointer_array_add(prte_node_topologies, t2);
+                prte_set_topology_object(t2);
             }
         }
         PMIX_DATA_BUFFER_DESTRUCT(&bucket);
@@ -836,15 +835,8 @@ int prte_util_parse_node_info(pmix_data_buffer_t *buf)
             sig = topos[m];
             /* find that signature in our topologies - might be at a
              * different location */
-            for (m=0; m < prte_node_topologies->size; m++) {
-                t3 = (prte_topology_t*)prte_pointer_array_get_item(prte_node_topologies, m);
-                if (NULL == t3) {
-                    continue;
-                }
-                if (0 == strcmp(sig, t3->sig)) {
-                    nptr->topology = t3;
-                    break;
-                }
+            if (NULL != (t3 = prte_get_topology_object(sig))) {
+                nptr->topology = t3;
             }
             /* unpack the next daemon rank */
             cnt = 1;